@@ -0,0 +1,129 @@
+// This program measures round-trip times of messages between two CAF nodes.
+// Use it to evaluate the latency vs. CPU trade-off of the options in
+// `caf.middleman`, e.g., `spin-duration`, `cpu-affinity` and `socket.busy-poll`.
+//
+// Run server at port 4242:
+// - ./build/bin/ping_pong_latency -s -p 4242
+//
+// Run client at the same host with and without spinning:
+// - ./build/bin/ping_pong_latency -p 4242 -r 100000
+// - ./build/bin/ping_pong_latency -p 4242 -r 100000 --caf.middleman.spin-duration=50us
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+behavior pong() {
+  return {
+    [](int32_t x) { return x; },
+  };
+}
+
+class config : public actor_system_config {
+public:
+  uint16_t port = 0;
+  string host = "localhost";
+  size_t rounds = 10000;
+  bool server_mode = false;
+
+  config() {
+    // Load the middleman before parsing the CLI in order to accept its options.
+    load<io::middleman>();
+    opt_group{custom_options_, "global"}
+      .add(port, "port,p", "set port")
+      .add(host, "host,H", "set host (ignored in server mode)")
+      .add(rounds, "rounds,r", "set number of round trips (client mode)")
+      .add(server_mode, "server-mode,s", "enable server mode");
+  }
+};
+
+void run_server(actor_system& sys, const config& cfg) {
+  auto server = sys.spawn(pong);
+  auto res = sys.middleman().publish(server, cfg.port);
+  if (!res) {
+    cerr << "*** publish failed: " << to_string(res.error()) << endl;
+    anon_send_exit(server, exit_reason::user_shutdown);
+    return;
+  }
+  cout << "*** listening at port " << *res << endl
+       << "*** press [enter] to quit" << endl;
+  string dummy;
+  std::getline(std::cin, dummy);
+  cout << "... cya" << endl;
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+void run_client(actor_system& sys, const config& cfg) {
+  auto server = sys.middleman().remote_actor(cfg.host, cfg.port);
+  if (!server) {
+    cerr << "*** cannot connect to server: " << to_string(server.error())
+         << endl;
+    return;
+  }
+  scoped_actor self{sys};
+  std::vector<clock_type::duration> samples;
+  samples.reserve(cfg.rounds);
+  auto wall_start = clock_type::now();
+  auto cpu_start = std::clock();
+  for (size_t i = 0; i < cfg.rounds; ++i) {
+    auto t0 = clock_type::now();
+    self->request(*server, infinite, static_cast<int32_t>(i))
+      .receive([&](int32_t) { samples.emplace_back(clock_type::now() - t0); },
+               [&](const error& err) {
+                 cerr << "*** request failed: " << to_string(err) << endl;
+               });
+    if (samples.size() != i + 1)
+      return;
+  }
+  auto cpu_time = static_cast<double>(std::clock() - cpu_start)
+                  / CLOCKS_PER_SEC;
+  std::chrono::duration<double> wall_time = clock_type::now() - wall_start;
+  if (samples.empty())
+    return;
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&](double p) {
+    auto index = static_cast<size_t>(p * (samples.size() - 1));
+    return std::chrono::duration_cast<std::chrono::microseconds>(samples[index])
+      .count();
+  };
+  cout << "round trips:   " << samples.size() << endl
+       << "p50 (us):      " << percentile(0.5) << endl
+       << "p90 (us):      " << percentile(0.9) << endl
+       << "p99 (us):      " << percentile(0.99) << endl
+       << "max (us):      " << percentile(1.0) << endl
+       << "wall time (s): " << wall_time.count() << endl
+       << "CPU time (s):  " << cpu_time << endl;
+}
+
+} // namespace
+
+void caf_main(actor_system& sys, const config& cfg) {
+  if (cfg.server_mode)
+    run_server(sys, cfg);
+  else
+    run_client(sys, cfg);
+}
+
+int main(int argc, char** argv) {
+  core::init_global_meta_objects();
+  io::middleman::init_global_meta_objects();
+  return exec_main<>(caf_main, argc, argv);
+}
@@ -140,6 +140,7 @@ public:
   static constexpr int is_terminated_flag = 0x0800;    // local_actor
   static constexpr int is_cleaned_up_flag = 0x1000;    // monitorable_actor
   static constexpr int is_shutting_down_flag = 0x2000; // scheduled_actor
+  static constexpr int is_sampled_flag = 0x4000;       // scheduled_actor
 
   void setf(int flag) {
     auto x = flags();
@@ -89,6 +89,15 @@ public:
                                         mailbox_element& element)
     = 0;
 
+  /// Called whenever a message is about to enter the mailbox of `self`. Unlike
+  /// the other callbacks, the calling thread usually runs the sender, not
+  /// `self`. The default implementation does nothing.
+  /// @param self The receiver.
+  /// @param element The incoming mailbox element.
+  /// @thread-safe
+  virtual void before_enqueue(const local_actor& self,
+                              const mailbox_element& element);
+
   // TODO: the instrumentation currently only works for actor-to-actor messages,
   //       but not when using group communication.
 };
@@ -102,11 +111,14 @@ public:
     self->system().profiler_before_sending(*self, msg)
 #  define CAF_BEFORE_SENDING_SCHEDULED(self, timeout, msg)                     \
     self->system().profiler_before_sending_scheduled(*self, timeout, msg)
+#  define CAF_BEFORE_ENQUEUE(self, msg)                                        \
+    self->system().profiler_before_enqueue(*self, msg)
 #else
 #  define CAF_BEFORE_PROCESSING(self, msg) static_cast<void>(0)
 #  define CAF_AFTER_PROCESSING(self, result) static_cast<void>(0)
 #  define CAF_BEFORE_SENDING(self, msg) static_cast<void>(0)
 #  define CAF_BEFORE_SENDING_SCHEDULED(self, timeout, msg) static_cast<void>(0)
+#  define CAF_BEFORE_ENQUEUE(self, msg) static_cast<void>(0)
 #endif
 
 } // namespace caf
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 #include "caf/abstract_actor.hpp"
@@ -39,6 +40,18 @@ public:
   /// Invokes cleanup code.
   virtual void kill_proxy(execution_unit* ctx, error reason) = 0;
 
+  /// Returns the number of Bytes that currently wait in the send buffer of the
+  /// connection to the node of this actor. Returns 0 if the proxy has no
+  /// information about its connection.
+  virtual size_t pending_bytes() const noexcept;
+
+  /// Signals that a stream path starts reading `pending_bytes`. Proxies only
+  /// keep `pending_bytes` up to date while at least one path observes them.
+  virtual void add_pending_bytes_observer() noexcept;
+
+  /// Signals that a stream path stops reading `pending_bytes`.
+  virtual void remove_pending_bytes_observer() noexcept;
+
   void setup_metrics() {
     // nop
   }
@@ -179,10 +179,10 @@ public:
   struct base_metrics_t {
     /// Counts the number of messages that where rejected because the target
     /// mailbox was closed or did not exist.
-    telemetry::int_counter* rejected_messages;
+    telemetry::sharded_int_counter* rejected_messages;
 
     /// Counts the total number of processed messages.
-    telemetry::int_counter* processed_messages;
+    telemetry::sharded_int_counter* processed_messages;
 
     /// Tracks the current number of running actors in the system.
     telemetry::int_gauge* running_actors;
@@ -214,6 +214,16 @@ public:
       /// Tracks how many stream elements from upstream are currently buffered.
       telemetry::int_gauge_family* input_buffer_size = nullptr;
 
+      /// Samples how many elements each batch from upstream contains.
+      telemetry::int_histogram_family* batch_size = nullptr;
+
+      /// Samples how long batches travel from upstream before processing.
+      telemetry::dbl_histogram_family* batch_latency = nullptr;
+
+      /// Samples how long actors wait for the first batch after granting new
+      /// credit to upstream.
+      telemetry::dbl_histogram_family* credit_round_trip_time = nullptr;
+
       // -- outbound -----------------------------------------------------------
 
       /// Counts the total number of elements that have been pushed downstream.
@@ -222,10 +232,22 @@ public:
       /// Tracks how many stream elements are currently waiting in the output
       /// buffer due to insufficient credit.
       telemetry::int_gauge_family* output_buffer_size = nullptr;
+
+      /// Samples how long outbound paths wait for new credit after running out
+      /// of credit.
+      telemetry::dbl_histogram_family* credit_starvation_time = nullptr;
     }
 
     /// Wraps streaming-related actor metric families.
     stream;
+
+    /// Accumulates the CPU time that actors spend in `resume`. Only available
+    /// when enabling `caf.metrics-filters.actors.accounting`.
+    telemetry::dbl_counter_family* cpu_time = nullptr;
+
+    /// Accumulates the bytes that actors allocate while processing messages.
+    /// Only available when enabling `caf.metrics-filters.actors.accounting`.
+    telemetry::int_counter_family* allocated_bytes = nullptr;
   };
 
   /// @warning The system stores a reference to `cfg`, which means the
@@ -575,6 +597,12 @@ public:
     return metrics_actors_excludes_;
   }
 
+  /// Returns the mailbox sampler if `caf.mailbox-sampler.interval` is set,
+  /// `nullptr` otherwise.
+  detail::mailbox_sampler* mailbox_sampler() const noexcept {
+    return mailbox_sampler_.get();
+  }
+
   template <class C, spawn_options Os, class... Ts>
   infer_handle_from_class_t<C> spawn_impl(actor_config& cfg, Ts&&... xs) {
     static_assert(is_unbound(Os),
@@ -632,6 +660,12 @@ public:
       profiler_->before_sending_scheduled(self, timeout, element);
   }
 
+  void profiler_before_enqueue(const local_actor& self,
+                               const mailbox_element& element) {
+    if (profiler_)
+      profiler_->before_enqueue(self, element);
+  }
+
   base_metrics_t& base_metrics() noexcept {
     return base_metrics_;
   }
@@ -748,6 +782,13 @@ private:
 
   /// Caches families for optional actor metrics.
   actor_metric_families_t actor_metric_families_;
+
+  /// Records mailbox sizes of all scheduled actors (optional).
+  std::unique_ptr<detail::mailbox_sampler> mailbox_sampler_;
+
+  /// Periodically runs the mailbox sampler and answers introspection requests
+  /// for the actors with the deepest mailboxes.
+  strong_actor_ptr mailbox_sampler_serv_;
 };
 
 } // namespace caf
@@ -35,9 +35,13 @@
 #include "caf/after.hpp"
 #include "caf/attach_continuous_stream_source.hpp"
 #include "caf/attach_continuous_stream_stage.hpp"
+#include "caf/attach_mapped_file_source.hpp"
+#include "caf/attach_ordered_merge_sink.hpp"
+#include "caf/attach_partitioned_stream_source.hpp"
 #include "caf/attach_stream_sink.hpp"
 #include "caf/attach_stream_source.hpp"
 #include "caf/attach_stream_stage.hpp"
+#include "caf/attach_window_stage.hpp"
 #include "caf/attachable.hpp"
 #include "caf/behavior.hpp"
 #include "caf/behavior_policy.hpp"
@@ -63,14 +67,18 @@
 #include "caf/exit_reason.hpp"
 #include "caf/expected.hpp"
 #include "caf/extend.hpp"
+#include "caf/file_slice.hpp"
 #include "caf/function_view.hpp"
+#include "caf/fuse_stream_steps.hpp"
 #include "caf/fused_downstream_manager.hpp"
 #include "caf/group.hpp"
 #include "caf/hash/fnv.hpp"
+#include "caf/hot_actor.hpp"
 #include "caf/init_global_meta_objects.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/logger.hpp"
 #include "caf/make_config_option.hpp"
+#include "caf/mapped_file.hpp"
 #include "caf/may_have_timeout.hpp"
 #include "caf/memory_managed.hpp"
 #include "caf/message.hpp"
@@ -79,6 +87,7 @@
 #include "caf/message_id.hpp"
 #include "caf/message_priority.hpp"
 #include "caf/node_id.hpp"
+#include "caf/ordered_merge.hpp"
 #include "caf/others.hpp"
 #include "caf/proxy_registry.hpp"
 #include "caf/raise_error.hpp"
@@ -0,0 +1,114 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "caf/broadcast_downstream_manager.hpp"
+#include "caf/detail/mapped_file_source_driver.hpp"
+#include "caf/detail/stream_source_impl.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/expected.hpp"
+#include "caf/file_slice.hpp"
+#include "caf/fwd.hpp"
+#include "caf/is_actor_handle.hpp"
+#include "caf/make_source_result.hpp"
+#include "caf/mapped_file.hpp"
+#include "caf/policy/arg.hpp"
+#include "caf/sec.hpp"
+#include "caf/stream_source.hpp"
+
+namespace caf {
+
+/// Default number of bytes a mapped file source asks the operating system to
+/// read ahead of its current position.
+constexpr size_t default_mapped_file_read_ahead = size_t{4} * 1024 * 1024;
+
+namespace detail {
+
+/// Checks the arguments of `attach_mapped_file_source`.
+inline error check_mapped_file_source_args(const mapped_file_ptr& file,
+                                           size_t record_size) {
+  if (file == nullptr)
+    return make_error(sec::invalid_argument,
+                      "cannot stream from an invalid mapped_file");
+  if (record_size == 0)
+    return make_error(sec::invalid_argument, "record_size must be positive");
+  return none;
+}
+
+} // namespace detail
+
+/// Attaches a new stream source to `self` that emits the fixed-size records of
+/// `file` as `file_slice` elements without copying.
+/// @param self Points to the hosting actor.
+/// @param file The memory-mapped input, e.g., created with `mapped_file::open`.
+/// @param record_size The size of a single record in bytes.
+/// @param read_ahead Number of bytes to read ahead of the current position.
+/// @param token Policy token for selecting a downstream manager
+///              implementation.
+/// @returns The allocated `stream_manager` and the output slot or
+///          `sec::invalid_argument` if `file` is null or `record_size` is 0.
+template <class DownstreamManager = broadcast_downstream_manager<file_slice>>
+expected<make_source_result_t<DownstreamManager>>
+attach_mapped_file_source(scheduled_actor* self, mapped_file_ptr file,
+                          size_t record_size,
+                          size_t read_ahead = default_mapped_file_read_ahead,
+                          policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  if (auto err = detail::check_mapped_file_source_args(file, record_size))
+    return err;
+  using driver = detail::mapped_file_source_driver<DownstreamManager>;
+  auto mgr = detail::make_stream_source<driver>(self, std::move(file),
+                                                record_size, read_ahead);
+  auto slot = mgr->add_outbound_path();
+  return make_source_result_t<DownstreamManager>{slot, std::move(mgr)};
+}
+
+/// Attaches a new stream source to `self` that emits the fixed-size records of
+/// `file` as `file_slice` elements without copying and starts sending to
+/// `dest` immediately.
+/// @param self Points to the hosting actor.
+/// @param dest Handle to the next stage in the pipeline.
+/// @param file The memory-mapped input, e.g., created with `mapped_file::open`.
+/// @param record_size The size of a single record in bytes.
+/// @param read_ahead Number of bytes to read ahead of the current position.
+/// @param token Policy token for selecting a downstream manager
+///              implementation.
+/// @returns The allocated `stream_manager` and the output slot or
+///          `sec::invalid_argument` if `file` is null or `record_size` is 0.
+template <class ActorHandle,
+          class DownstreamManager = broadcast_downstream_manager<file_slice>>
+detail::enable_if_t<is_actor_handle<ActorHandle>::value,
+                    expected<make_source_result_t<DownstreamManager>>>
+attach_mapped_file_source(scheduled_actor* self, const ActorHandle& dest,
+                          mapped_file_ptr file, size_t record_size,
+                          size_t read_ahead = default_mapped_file_read_ahead,
+                          policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  if (auto err = detail::check_mapped_file_source_args(file, record_size))
+    return err;
+  using driver = detail::mapped_file_source_driver<DownstreamManager>;
+  auto mgr = detail::make_stream_source<driver>(self, std::move(file),
+                                                record_size, read_ahead);
+  auto slot = mgr->add_outbound_path(dest);
+  return make_source_result_t<DownstreamManager>{slot, std::move(mgr)};
+}
+
+} // namespace caf
@@ -0,0 +1,58 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <utility>
+
+#include "caf/attach_stream_sink.hpp"
+#include "caf/fwd.hpp"
+#include "caf/make_sink_result.hpp"
+#include "caf/ordered_merge.hpp"
+#include "caf/stream.hpp"
+#include "caf/unit.hpp"
+
+namespace caf {
+
+/// Attaches a new stream sink to `self` that passes all elements of `in`
+/// through `merge` and calls `fun` for each element in the original order.
+/// Merge actors call this function for the handshake of each worker with the
+/// same `merge`, usually a member of the actor state.
+/// @param self Points to the hosting actor.
+/// @param in Stream handshake from upstream path.
+/// @param merge Restores the order of elements from all workers. Must outlive
+///              the sink.
+/// @param seq Function object returning the sequence number of an element.
+/// @param fun Consumer for the elements in order.
+/// @returns The new `stream_manager` and the inbound slot.
+template <class In, class Seq, class Fun>
+make_sink_result<In>
+attach_ordered_merge_sink(scheduled_actor* self, stream<In> in,
+                          ordered_merge<In>& merge, Seq seq, Fun fun) {
+  return attach_stream_sink(
+    self, in,
+    [](unit_t&) {
+      // nop
+    },
+    [&merge, seq, fun](unit_t&, In x) {
+      auto n = seq(x);
+      merge.push(n, std::move(x), fun);
+    });
+}
+
+} // namespace caf
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "caf/detail/stream_source_driver_impl.hpp"
+#include "caf/detail/stream_source_impl.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/fwd.hpp"
+#include "caf/partition_downstream_manager.hpp"
+#include "caf/policy/arg.hpp"
+#include "caf/stream_source.hpp"
+#include "caf/stream_source_trait.hpp"
+
+namespace caf {
+
+/// Attaches a new stream source to `self` that partitions its output among
+/// `workers`. Each worker receives a regular stream handshake for its partition
+/// and forwards its results to `merge`, i.e., workers usually attach a stream
+/// stage and `merge` attaches a stream sink for each worker.
+/// @param self Points to the hosting actor.
+/// @param workers Handles to the actors processing one partition each.
+/// @param merge Handle to the actor collecting the results of all workers.
+/// @param init Function object for initializing the state of the source.
+/// @param pull Generator function object for producing downstream messages.
+/// @param done Predicate returning `true` when generator is done.
+/// @param fin Cleanup handler.
+/// @param token Policy token for selecting a downstream manager
+///              implementation, e.g., for hashing only the key of elements.
+/// @returns The allocated `stream_manager`.
+template <class Worker, class Merge, class Init, class Pull, class Done,
+          class Finalize = unit_t, class Trait = stream_source_trait_t<Pull>,
+          class DownstreamManager
+          = partition_downstream_manager<typename Trait::output>>
+stream_source_ptr<DownstreamManager> attach_partitioned_stream_source(
+  scheduled_actor* self, const std::vector<Worker>& workers,
+  const Merge& merge, Init init, Pull pull, Done done, Finalize fin = {},
+  policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  using state_type = typename Trait::state;
+  static_assert(std::is_same<
+                  void(state_type&),
+                  typename detail::get_callable_trait<Init>::fun_sig>::value,
+                "Expected signature `void (State&)` for init function");
+  static_assert(std::is_same<
+                  bool(const state_type&),
+                  typename detail::get_callable_trait<Done>::fun_sig>::value,
+                "Expected signature `bool (const State&)` "
+                "for done predicate function");
+  using driver = detail::stream_source_driver_impl<DownstreamManager, Pull,
+                                                   Done, Finalize>;
+  auto mgr = detail::make_stream_source<driver>(self, std::move(init),
+                                                std::move(pull),
+                                                std::move(done),
+                                                std::move(fin));
+  for (auto& worker : workers)
+    mgr->out().add_partition(worker, merge);
+  return mgr;
+}
+
+} // namespace caf
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include "caf/broadcast_downstream_manager.hpp"
+#include "caf/detail/session_window_driver.hpp"
+#include "caf/detail/sliding_window_driver.hpp"
+#include "caf/detail/stream_stage_impl.hpp"
+#include "caf/detail/tumbling_window_driver.hpp"
+#include "caf/fwd.hpp"
+#include "caf/make_stage_result.hpp"
+#include "caf/policy/arg.hpp"
+#include "caf/scheduled_actor.hpp"
+#include "caf/stream.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf {
+
+// The window stages aggregate elements with a user-defined `Monoid` that
+// provides the following interface:
+//
+// - `input_type`: type of the input elements.
+// - `value_type`: type of the aggregates and output elements.
+// - `value_type identity() const`: returns the neutral element.
+// - `void add(value_type& acc, const input_type& x) const`: adds `x` to `acc`.
+// - `value_type combine(const value_type& x, const value_type& y) const`:
+//   combines two aggregates. Must be associative, but not necessarily
+//   commutative (`x` always aggregates older elements than `y`).
+//
+// All window stages measure time with the clock of the hosting actor and
+// close windows on the periodic ticks of the stream manager. Hence, windows
+// may close up to `caf.stream.max-batch-delay` late. Once all inputs close,
+// the stages emit the aggregates of all open windows.
+
+/// Attaches a new stream stage to `self` that emits one aggregate per
+/// non-empty, non-overlapping window of length `size`.
+/// @param self Points to the hosting actor.
+/// @param in Stream handshake from upstream path.
+/// @param size Length of each window.
+/// @param monoid Aggregates the elements of a window.
+/// @param token Policy token for selecting a downstream manager
+///              implementation.
+/// @returns The new `stream_manager`, an inbound slot, and an outbound slot.
+template <class Monoid, class DownstreamManager = broadcast_downstream_manager<
+                          typename Monoid::value_type>>
+make_stage_result_t<typename Monoid::input_type, DownstreamManager>
+attach_tumbling_window_stage(scheduled_actor* self,
+                             const stream<typename Monoid::input_type>& in,
+                             timespan size, Monoid monoid = {},
+                             policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  using driver = detail::tumbling_window_driver<Monoid, DownstreamManager>;
+  auto mgr = detail::make_stream_stage<driver>(self, self->clock(), size,
+                                               std::move(monoid));
+  auto islot = mgr->add_inbound_path(in);
+  auto oslot = mgr->add_outbound_path();
+  return {islot, oslot, std::move(mgr)};
+}
+
+/// Attaches a new stream stage to `self` that emits the aggregate of the
+/// last `size` time units every `slide` time units, unless the window
+/// contains no elements.
+/// @param self Points to the hosting actor.
+/// @param in Stream handshake from upstream path.
+/// @param size Length of each window. The stage rounds up to a multiple of
+///             `slide`.
+/// @param slide Distance between the start of two consecutive windows.
+/// @param monoid Aggregates the elements of a window.
+/// @param token Policy token for selecting a downstream manager
+///              implementation.
+/// @returns The new `stream_manager`, an inbound slot, and an outbound slot.
+template <class Monoid, class DownstreamManager = broadcast_downstream_manager<
+                          typename Monoid::value_type>>
+make_stage_result_t<typename Monoid::input_type, DownstreamManager>
+attach_sliding_window_stage(scheduled_actor* self,
+                            const stream<typename Monoid::input_type>& in,
+                            timespan size, timespan slide, Monoid monoid = {},
+                            policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  using driver = detail::sliding_window_driver<Monoid, DownstreamManager>;
+  auto mgr = detail::make_stream_stage<driver>(self, self->clock(), size,
+                                               slide, std::move(monoid));
+  auto islot = mgr->add_inbound_path(in);
+  auto oslot = mgr->add_outbound_path();
+  return {islot, oslot, std::move(mgr)};
+}
+
+/// Attaches a new stream stage to `self` that emits one aggregate per burst
+/// of elements, whereas a burst ends when no element arrives for `gap`.
+/// @param self Points to the hosting actor.
+/// @param in Stream handshake from upstream path.
+/// @param gap Minimum distance between two bursts.
+/// @param monoid Aggregates the elements of a burst.
+/// @param token Policy token for selecting a downstream manager
+///              implementation.
+/// @returns The new `stream_manager`, an inbound slot, and an outbound slot.
+template <class Monoid, class DownstreamManager = broadcast_downstream_manager<
+                          typename Monoid::value_type>>
+make_stage_result_t<typename Monoid::input_type, DownstreamManager>
+attach_session_window_stage(scheduled_actor* self,
+                            const stream<typename Monoid::input_type>& in,
+                            timespan gap, Monoid monoid = {},
+                            policy::arg<DownstreamManager> token = {}) {
+  CAF_IGNORE_UNUSED(token);
+  using driver = detail::session_window_driver<Monoid, DownstreamManager>;
+  auto mgr = detail::make_stream_stage<driver>(self, self->clock(), gap,
+                                               std::move(monoid));
+  auto islot = mgr->add_inbound_path(in);
+  auto oslot = mgr->add_outbound_path();
+  return {islot, oslot, std::move(mgr)};
+}
+
+} // namespace caf
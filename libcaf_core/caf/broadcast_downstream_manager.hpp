@@ -19,6 +19,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 
 #include "caf/buffered_downstream_manager.hpp"
 #include "caf/detail/algorithms.hpp"
@@ -231,10 +233,65 @@ protected:
   }
 
 private:
+  /// Ships batches from the central buffer by creating each batch only once
+  /// and sending the same (ref-counted, immutable) message to all paths.
+  /// Requires that no path has cached elements and that all open paths agree
+  /// on the batch size. Returns `false` without side effects otherwise.
+  bool emit_shared_batches(bool force_underfull) {
+    int32_t batch_size = 0;
+    int32_t credit = std::numeric_limits<int32_t>::max();
+    for (auto& kvp : this->paths_) {
+      auto& path = *kvp.second;
+      if (path.closing)
+        continue;
+      if (path.pending()
+          || (batch_size != 0 && batch_size != path.desired_batch_size))
+        return false;
+      batch_size = path.desired_batch_size;
+      credit = std::min(credit, path.open_credit);
+    }
+    if (batch_size == 0)
+      return false;
+    for (auto& kvp : state_map_)
+      if (!kvp.second.buf.empty())
+        return false;
+    auto old_size = buffered();
+    auto n = std::min(static_cast<size_t>(credit), this->buf_.size());
+    auto desired = static_cast<size_t>(batch_size);
+    while (n >= desired || (force_underfull && n > 0)) {
+      auto chunk_size = std::min(n, desired);
+      auto xs_size = static_cast<int32_t>(chunk_size);
+      auto xs = make_message(this->get_chunk(chunk_size));
+      for (auto& kvp : this->paths_)
+        if (!kvp.second->closing)
+          kvp.second->emit_batch(this->self(), xs_size, xs);
+      n -= chunk_size;
+    }
+    // Closing paths never receive new data, but may still need to flush.
+    auto g = [&](typename map_type::value_type& x,
+                 typename state_map_type::value_type& y) {
+      if (x.second->closing)
+        x.second->emit_batches(this->self(), y.second.buf, true);
+    };
+    detail::zip_foreach(g, this->paths_.container(), state_map_.container());
+    auto new_size = buffered();
+    CAF_ASSERT(old_size >= new_size);
+    auto shipped = old_size - new_size;
+    this->shipped_messages(shipped);
+    if (shipped > 0)
+      this->last_send_ = this->self()->now();
+    return true;
+  }
+
   void emit_batches_impl(bool force_underfull) {
     CAF_ASSERT(this->paths_.size() <= state_map_.size());
     if (this->paths_.empty())
       return;
+    // Without filtering, all paths receive the same elements. Hence, we can
+    // share batches instead of copying all elements into each path buffer.
+    if constexpr (std::is_same<select_type, detail::select_all>::value)
+      if (emit_shared_batches(force_underfull))
+        return;
     auto old_size = buffered();
     // Calculate the chunk size, i.e., how many more items we can put to our
     // caches at the most.
@@ -18,11 +18,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
-#include <deque>
 #include <iterator>
 #include <vector>
 
+#include "caf/detail/ring_queue.hpp"
 #include "caf/downstream_manager_base.hpp"
 #include "caf/logger.hpp"
 
@@ -39,7 +40,7 @@ public:
 
   using output_type = T;
 
-  using buffer_type = std::deque<output_type>;
+  using buffer_type = detail::ring_queue<output_type>;
 
   using chunk_type = std::vector<output_type>;
 
@@ -66,20 +67,8 @@ public:
 
   /// @pre `n <= buf_.size()`
   static chunk_type get_chunk(buffer_type& buf, size_t n) {
-    CAF_LOG_TRACE(CAF_ARG(buf) << CAF_ARG(n));
     chunk_type xs;
-    if (!buf.empty() && n > 0) {
-      xs.reserve(std::min(n, buf.size()));
-      if (n < buf.size()) {
-        auto first = buf.begin();
-        auto last = first + static_cast<ptrdiff_t>(n);
-        std::move(first, last, std::back_inserter(xs));
-        buf.erase(first, last);
-      } else {
-        std::move(buf.begin(), buf.end(), std::back_inserter(xs));
-        buf.clear();
-      }
-    }
+    move_chunk(buf, n, xs);
     return xs;
   }
 
@@ -116,6 +105,11 @@ public:
   }
 
 protected:
+  static void move_chunk(buffer_type& buf, size_t n, chunk_type& xs) {
+    CAF_LOG_TRACE(CAF_ARG2("buffered", buf.size()) << CAF_ARG(n));
+    buf.take_front(std::min(n, buf.size()), xs);
+  }
+
   buffer_type buf_;
 };
 
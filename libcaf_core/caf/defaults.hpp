@@ -43,8 +43,17 @@ constexpr auto max_batch_delay = timespan{1'000'000};
 /// The `token-based` controller associates each stream element with one token.
 /// Input buffer and batch sizes are then statically defined in terms of tokens.
 /// This strategy makes no dynamic adjustment or sampling.
+///
+/// The `latency-based` controller measures how long batches wait before the
+/// receiver processes them and adjusts the input buffer for keeping this
+/// queueing delay close to a target value.
 constexpr auto credit_policy = string_view{"size-based"};
 
+/// Maximum number of Bytes in the send buffer of a connection to another node
+/// before stream managers stop granting credit to sinks on that node. Setting
+/// this parameter to 0 disables the limit.
+constexpr auto max_pending_bytes = size_t{1024 * 1024}; // 1 MB
+
 [[deprecated("this parameter no longer has any effect")]] //
 constexpr auto credit_round_interval
   = max_batch_delay;
@@ -87,6 +96,23 @@ constexpr auto buffer_size = int32_t{4096}; // // 32 KB for elements of size 8.
 
 } // namespace caf::defaults::stream::token_policy
 
+namespace caf::defaults::stream::latency_policy {
+
+/// Maximum queueing delay of batches, i.e., the time between emitting a batch
+/// at the source and processing it at the receiver.
+constexpr auto target_delay = timespan{5'000'000}; // 5ms
+
+/// Lower bound for the number of elements in the input buffer.
+constexpr auto min_buffer_size = int32_t{16};
+
+/// Upper bound for the number of elements in the input buffer.
+constexpr auto max_buffer_size = int32_t{8192};
+
+/// Number of batches between two adjustments of the buffer size.
+constexpr auto calibration_interval = int32_t{10};
+
+} // namespace caf::defaults::stream::latency_policy
+
 namespace caf::defaults::scheduler {
 
 constexpr auto policy = string_view{"stealing"};
@@ -108,6 +134,13 @@ constexpr auto relaxed_sleep_duration = timespan{10'000'000};
 
 } // namespace caf::defaults::work_stealing
 
+namespace caf::defaults::mailbox_sampler {
+
+/// Number of actors with the deepest mailboxes that the sampler reports.
+constexpr auto top_k = size_t{10};
+
+} // namespace caf::defaults::mailbox_sampler
+
 namespace caf::defaults::logger::file {
 
 constexpr auto format = string_view{"%r %c %p %a %t %C %M %F:%L %m%n"};
@@ -131,4 +164,14 @@ constexpr auto heartbeat_interval = size_t{0};
 constexpr auto cached_udp_buffers = size_t{10};
 constexpr auto max_pending_msgs = size_t{10};
 
+/// Configures how long the multiplexer keeps polling for events without
+/// blocking before it falls back to a blocking wait. Spinning lowers wakeup
+/// latency at the expense of burning CPU cycles on the multiplexer thread.
+/// A zero duration (default) disables the spin phase.
+constexpr auto spin_duration = timespan{0};
+
+/// Selects a CPU for pinning the multiplexer thread to. Negative values
+/// (default) leave scheduling of the thread to the operating system.
+constexpr auto cpu_affinity = int32_t{-1};
+
 } // namespace caf::defaults::middleman
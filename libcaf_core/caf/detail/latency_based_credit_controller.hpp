@@ -0,0 +1,116 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+
+#include "caf/credit_controller.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/downstream_msg.hpp"
+#include "caf/stream.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// A credit controller that measures the queueing delay of incoming batches,
+/// i.e., the time between emitting a batch at the source and processing it at
+/// the sink, and sizes the input buffer for keeping the delay below a target.
+///
+/// Similar to CoDel, the controller looks at the minimum delay per calibration
+/// interval, since only a standing queue raises the minimum. It halves the
+/// buffer whenever the minimum exceeds the target and grows the buffer while
+/// the minimum stays below half of the target. The controller doubles the
+/// buffer until it observes a delay above the target for the first time and
+/// grows it by one batch per interval afterwards.
+///
+/// @note Measuring the delay requires synchronized clocks when source and sink
+///       run on different nodes. The controller treats negative delays as 0.
+class CAF_CORE_EXPORT latency_based_credit_controller
+  : public credit_controller {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Configures how many batches fit into the input buffer.
+  static constexpr int32_t batches_per_buffer = 8;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit latency_based_credit_controller(local_actor* self);
+
+  ~latency_based_credit_controller() override;
+
+  // -- interface functions ----------------------------------------------------
+
+  void before_processing(downstream_msg::batch& batch) override;
+
+  calibration init() override;
+
+  calibration calibrate() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the current upper bound for the input buffer.
+  int32_t buffer_size() const noexcept {
+    return buffer_size_;
+  }
+
+  /// Returns the current number of elements per batch.
+  int32_t batch_size() const noexcept {
+    return std::max(buffer_size_ / batches_per_buffer, int32_t{1});
+  }
+
+  /// Returns whether the controller still doubles the buffer size.
+  bool slow_start() const noexcept {
+    return slow_start_;
+  }
+
+  // -- factory functions ------------------------------------------------------
+
+  template <class T>
+  static auto make(local_actor* self, stream<T>) {
+    return std::make_unique<latency_based_credit_controller>(self);
+  }
+
+private:
+  // -- member variables -------------------------------------------------------
+
+  /// Stores the current upper bound for the input buffer.
+  int32_t buffer_size_;
+
+  /// Stores the minimum delay since the last calibration.
+  timespan min_delay_;
+
+  /// Stores how many batches arrived since the last calibration.
+  int32_t samples_ = 0;
+
+  /// Stores whether the controller never observed a delay above the target.
+  bool slow_start_ = true;
+
+  // --  see caf::defaults::stream::latency_policy -----------------------------
+
+  timespan target_delay_;
+
+  int32_t min_buffer_size_;
+
+  int32_t max_buffer_size_;
+
+  int32_t calibration_interval_;
+};
+
+} // namespace caf::detail
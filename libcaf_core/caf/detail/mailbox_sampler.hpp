@@ -0,0 +1,93 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/hot_actor.hpp"
+
+namespace caf::detail {
+
+/// Records the mailbox sizes of all scheduled actors in the system.
+///
+/// Actors add themselves to the sampler when launching and remove themselves
+/// when cleaning up. The sampler never touches the lock-free mailboxes.
+/// Instead, it reads a counter that each actor updates with relaxed atomic
+/// operations while the sampler is enabled (see
+/// `scheduled_actor::sampled_mailbox_size`).
+class CAF_CORE_EXPORT mailbox_sampler {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  mailbox_sampler(telemetry::metric_registry& reg, size_t top_k);
+
+  mailbox_sampler(const mailbox_sampler&) = delete;
+
+  mailbox_sampler& operator=(const mailbox_sampler&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the maximum number of actors that `sample` returns.
+  size_t top_k() const noexcept {
+    return top_k_;
+  }
+
+  // -- actor management -------------------------------------------------------
+
+  /// Starts sampling the mailbox of `self`.
+  void add(scheduled_actor* self);
+
+  /// Stops sampling the mailbox of `self`.
+  void remove(scheduled_actor* self);
+
+  // -- sampling ---------------------------------------------------------------
+
+  /// Records the current mailbox size of all actors and returns up to `top_k`
+  /// actors with non-empty mailboxes, ordered by mailbox size (descending).
+  std::vector<hot_actor> sample();
+
+private:
+  /// Protects `actors_`.
+  std::mutex mtx_;
+
+  /// Stores all actors that have added themselves to the sampler.
+  std::unordered_set<scheduled_actor*> actors_;
+
+  /// Configures how many actors `sample` returns at most.
+  size_t top_k_;
+
+  /// Samples the mailbox size of all actors.
+  telemetry::int_histogram* mailbox_sizes_;
+
+  /// Tracks the largest mailbox size per actor type among the hot actors.
+  telemetry::int_gauge_family* hot_actors_;
+
+  /// Stores all gauges that `sample` has set to a non-zero value in its last
+  /// run in order to reset them when the actor type is no longer "hot".
+  std::unordered_map<std::string, telemetry::int_gauge*> hot_gauges_;
+};
+
+} // namespace caf::detail
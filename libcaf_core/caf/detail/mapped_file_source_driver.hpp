@@ -0,0 +1,95 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "caf/downstream.hpp"
+#include "caf/file_slice.hpp"
+#include "caf/mapped_file.hpp"
+#include "caf/stream_source_driver.hpp"
+
+namespace caf::detail {
+
+/// A stream source driver that emits fixed-size records of a memory-mapped
+/// file as `file_slice` elements. Each element points into the mapping instead
+/// of copying its bytes. The driver ignores a trailing partial record.
+template <class DownstreamManager>
+class mapped_file_source_driver final
+  : public stream_source_driver<DownstreamManager> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = stream_source_driver<DownstreamManager>;
+
+  using typename super::output_type;
+
+  static_assert(std::is_same<output_type, file_slice>::value,
+                "mapped_file_source_driver requires file_slice as output type");
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// @param file The memory-mapped input.
+  /// @param record_size The size of a single record in bytes.
+  /// @param read_ahead Number of bytes the driver asks the operating system to
+  ///                   read ahead of the current position.
+  mapped_file_source_driver(mapped_file_ptr file, size_t record_size,
+                            size_t read_ahead)
+    : file_(std::move(file)),
+      record_size_(record_size),
+      read_ahead_(read_ahead),
+      offset_(0),
+      advised_(0) {
+    CAF_ASSERT(file_ != nullptr);
+    CAF_ASSERT(record_size_ > 0);
+  }
+
+  // -- implementation of virtual functions ------------------------------------
+
+  void pull(downstream<output_type>& out, size_t num) override {
+    auto size = file_->size();
+    for (size_t i = 0; i < num && size - offset_ >= record_size_; ++i) {
+      out.push(file_, offset_, record_size_);
+      offset_ += record_size_;
+    }
+    // Keep the operating system busy with loading the next pages while
+    // downstream actors process the current batches.
+    if (read_ahead_ > 0 && advised_ < size
+        && offset_ + read_ahead_ / 2 >= advised_) {
+      auto first = std::max(advised_, offset_);
+      file_->will_need(first, read_ahead_);
+      advised_ = first + read_ahead_;
+    }
+  }
+
+  bool done() const noexcept override {
+    return file_->size() - offset_ < record_size_;
+  }
+
+private:
+  mapped_file_ptr file_;
+  size_t record_size_;
+  size_t read_ahead_;
+  size_t offset_;
+  size_t advised_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,138 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// An insert-only hash index that maps precomputed hash values to pointers.
+/// Lookups never block and may run concurrently to an insertion, while
+/// insertions require external synchronization. The index never takes
+/// ownership of the stored objects.
+template <class T>
+class read_mostly_index {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of slots in the first table.
+  static constexpr size_t min_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  read_mostly_index() : table_(nullptr), size_(0) {
+    // nop
+  }
+
+  read_mostly_index(const read_mostly_index&) = delete;
+
+  read_mostly_index& operator=(const read_mostly_index&) = delete;
+
+  // -- lookup -----------------------------------------------------------------
+
+  /// Returns the first object with hash value `hash` that satisfies `pred` or
+  /// `nullptr` if no such object exists.
+  template <class Predicate>
+  T* find(size_t hash, Predicate&& pred) const {
+    auto tbl = table_.load(std::memory_order_acquire);
+    if (tbl == nullptr)
+      return nullptr;
+    auto mask = tbl->capacity - 1;
+    for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+      auto& slot = tbl->slots[pos];
+      auto ptr = slot.value.load(std::memory_order_acquire);
+      if (ptr == nullptr)
+        return nullptr;
+      if (slot.hash == hash && pred(*ptr))
+        return ptr;
+    }
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `ptr` to the index.
+  /// @pre No other thread calls `insert` concurrently.
+  /// @pre `ptr != nullptr`
+  void insert(size_t hash, T* ptr) {
+    CAF_ASSERT(ptr != nullptr);
+    auto tbl = table_.load(std::memory_order_relaxed);
+    // Keep the load factor at or below 1/2 for short probe sequences.
+    if (tbl == nullptr || (size_ + 1) * 2 > tbl->capacity) {
+      auto new_capacity = tbl == nullptr ? min_capacity : tbl->capacity * 2;
+      auto new_tbl = std::make_unique<table>(new_capacity);
+      if (tbl != nullptr)
+        for (size_t i = 0; i < tbl->capacity; ++i)
+          if (auto x = tbl->slots[i].value.load(std::memory_order_relaxed))
+            store(*new_tbl, tbl->slots[i].hash, x);
+      tbl = new_tbl.get();
+      // Readers may still access previous tables, so we keep them alive as
+      // long as the index exists. The capacity doubles with each table, i.e.,
+      // the old tables take up less memory than the current table.
+      tables_.emplace_back(std::move(new_tbl));
+      table_.store(tbl, std::memory_order_release);
+    }
+    store(*tbl, hash, ptr);
+    ++size_;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of stored objects.
+  /// @pre No other thread calls `insert` concurrently.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+private:
+  struct slot_type {
+    size_t hash = 0;
+    std::atomic<T*> value{nullptr};
+  };
+
+  struct table {
+    explicit table(size_t n) : capacity(n), slots(new slot_type[n]) {
+      // nop
+    }
+
+    size_t capacity;
+    std::unique_ptr<slot_type[]> slots;
+  };
+
+  static void store(table& tbl, size_t hash, T* ptr) {
+    auto mask = tbl.capacity - 1;
+    auto pos = hash & mask;
+    while (tbl.slots[pos].value.load(std::memory_order_relaxed) != nullptr)
+      pos = (pos + 1) & mask;
+    // Publishing the pointer with release semantics makes the hash visible to
+    // readers that observe the pointer.
+    tbl.slots[pos].hash = hash;
+    tbl.slots[pos].value.store(ptr, std::memory_order_release);
+  }
+
+  std::atomic<table*> table_;
+  size_t size_;
+  std::vector<std::unique_ptr<table>> tables_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,465 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// A FIFO queue that stores its elements in a single, contiguous block of
+/// memory with a power-of-two capacity. Unlike `std::deque`, the queue never
+/// allocates memory while its size stays below its capacity and only grows by
+/// doubling the capacity. Offers a `std::deque`-like interface. Appending at
+/// the back and erasing at the front run in constant time, whereas inserting or
+/// erasing elements at other positions moves all elements behind `pos`.
+template <class T>
+class ring_queue {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using size_type = size_t;
+
+  using difference_type = ptrdiff_t;
+
+  using reference = value_type&;
+
+  using const_reference = const value_type&;
+
+  using pointer = value_type*;
+
+  using const_pointer = const value_type*;
+
+  template <bool IsConst>
+  class iterator_impl {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = T;
+
+    using difference_type = ptrdiff_t;
+
+    using pointer = std::conditional_t<IsConst, const T*, T*>;
+
+    using reference = std::conditional_t<IsConst, const T&, T&>;
+
+    using queue_pointer
+      = std::conditional_t<IsConst, const ring_queue*, ring_queue*>;
+
+    iterator_impl() noexcept : q_(nullptr), pos_(0) {
+      // nop
+    }
+
+    iterator_impl(queue_pointer q, size_t pos) noexcept : q_(q), pos_(pos) {
+      // nop
+    }
+
+    template <bool C = IsConst, class = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false>& other) noexcept
+      : q_(other.queue()), pos_(other.position()) {
+      // nop
+    }
+
+    reference operator*() const noexcept {
+      return (*q_)[pos_];
+    }
+
+    pointer operator->() const noexcept {
+      return std::addressof((*q_)[pos_]);
+    }
+
+    reference operator[](difference_type n) const noexcept {
+      return (*q_)[static_cast<size_t>(static_cast<difference_type>(pos_) + n)];
+    }
+
+    iterator_impl& operator++() noexcept {
+      ++pos_;
+      return *this;
+    }
+
+    iterator_impl operator++(int) noexcept {
+      auto result = *this;
+      ++pos_;
+      return result;
+    }
+
+    iterator_impl& operator--() noexcept {
+      --pos_;
+      return *this;
+    }
+
+    iterator_impl operator--(int) noexcept {
+      auto result = *this;
+      --pos_;
+      return result;
+    }
+
+    iterator_impl& operator+=(difference_type n) noexcept {
+      pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + n);
+      return *this;
+    }
+
+    iterator_impl& operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    friend iterator_impl operator+(iterator_impl x, difference_type n) {
+      return x += n;
+    }
+
+    friend iterator_impl operator+(difference_type n, iterator_impl x) {
+      return x += n;
+    }
+
+    friend iterator_impl operator-(iterator_impl x, difference_type n) {
+      return x -= n;
+    }
+
+    friend difference_type operator-(const iterator_impl& x,
+                                     const iterator_impl& y) noexcept {
+      return static_cast<difference_type>(x.pos_)
+             - static_cast<difference_type>(y.pos_);
+    }
+
+    friend bool operator==(const iterator_impl& x,
+                           const iterator_impl& y) noexcept {
+      return x.pos_ == y.pos_;
+    }
+
+    friend bool operator!=(const iterator_impl& x,
+                           const iterator_impl& y) noexcept {
+      return x.pos_ != y.pos_;
+    }
+
+    friend bool operator<(const iterator_impl& x,
+                          const iterator_impl& y) noexcept {
+      return x.pos_ < y.pos_;
+    }
+
+    friend bool operator<=(const iterator_impl& x,
+                           const iterator_impl& y) noexcept {
+      return x.pos_ <= y.pos_;
+    }
+
+    friend bool operator>(const iterator_impl& x,
+                          const iterator_impl& y) noexcept {
+      return x.pos_ > y.pos_;
+    }
+
+    friend bool operator>=(const iterator_impl& x,
+                           const iterator_impl& y) noexcept {
+      return x.pos_ >= y.pos_;
+    }
+
+    queue_pointer queue() const noexcept {
+      return q_;
+    }
+
+    size_t position() const noexcept {
+      return pos_;
+    }
+
+  private:
+    queue_pointer q_;
+    size_t pos_;
+  };
+
+  using iterator = iterator_impl<false>;
+
+  using const_iterator = iterator_impl<true>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Capacity after the first allocation.
+  static constexpr size_t min_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ring_queue() noexcept : data_(nullptr), capacity_(0), head_(0), size_(0) {
+    // nop
+  }
+
+  ring_queue(ring_queue&& other) noexcept
+    : data_(other.data_),
+      capacity_(other.capacity_),
+      head_(other.head_),
+      size_(other.size_) {
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
+    other.size_ = 0;
+  }
+
+  ring_queue(const ring_queue& other) : ring_queue() {
+    insert(end(), other.begin(), other.end());
+  }
+
+  ring_queue& operator=(ring_queue&& other) noexcept {
+    ring_queue tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+
+  ring_queue& operator=(const ring_queue& other) {
+    ring_queue tmp{other};
+    swap(tmp);
+    return *this;
+  }
+
+  ~ring_queue() {
+    clear();
+    if (data_ != nullptr)
+      std::allocator<T>{}.deallocate(data_, capacity_);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // -- element access ---------------------------------------------------------
+
+  reference operator[](size_t pos) noexcept {
+    CAF_ASSERT(pos < size_);
+    return data_[index(pos)];
+  }
+
+  const_reference operator[](size_t pos) const noexcept {
+    CAF_ASSERT(pos < size_);
+    return data_[index(pos)];
+  }
+
+  reference front() noexcept {
+    return (*this)[0];
+  }
+
+  const_reference front() const noexcept {
+    return (*this)[0];
+  }
+
+  reference back() noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  const_reference back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  // -- iterator access --------------------------------------------------------
+
+  iterator begin() noexcept {
+    return {this, 0};
+  }
+
+  const_iterator begin() const noexcept {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  iterator end() noexcept {
+    return {this, size_};
+  }
+
+  const_iterator end() const noexcept {
+    return {this, size_};
+  }
+
+  const_iterator cend() const noexcept {
+    return end();
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  template <class... Ts>
+  reference emplace_back(Ts&&... xs) {
+    if (size_ == capacity_) {
+      // Construct the new element first, since `xs` may refer to an element
+      // in this queue.
+      T tmp(std::forward<Ts>(xs)...);
+      grow(size_ + 1);
+      return emplace_back_impl(std::move(tmp));
+    }
+    return emplace_back_impl(std::forward<Ts>(xs)...);
+  }
+
+  void push_back(const T& x) {
+    emplace_back(x);
+  }
+
+  void push_back(T&& x) {
+    emplace_back(std::move(x));
+  }
+
+  /// Inserts all elements in `[first, last)` before `pos`.
+  template <class Iterator, class Sentinel>
+  iterator insert(const_iterator pos, Iterator first, Sentinel last) {
+    auto offset = pos.position();
+    CAF_ASSERT(offset <= size_);
+    auto old_size = size_;
+    using category = typename std::iterator_traits<Iterator>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value
+                  && std::is_same<Iterator, Sentinel>::value) {
+      auto n = static_cast<size_t>(std::distance(first, last));
+      if (size_ + n > capacity_)
+        grow(size_ + n);
+    }
+    for (; first != last; ++first)
+      emplace_back(*first);
+    // Move the new elements into place unless appending at the back.
+    if (offset != old_size)
+      std::rotate(begin() + static_cast<difference_type>(offset),
+                  begin() + static_cast<difference_type>(old_size), end());
+    return {this, offset};
+  }
+
+  /// Removes the first element.
+  void pop_front() noexcept {
+    drop_front(1);
+  }
+
+  /// Removes all elements in `[first, last)`.
+  iterator erase(const_iterator first, const_iterator last) {
+    auto offset = first.position();
+    CAF_ASSERT(offset <= last.position() && last.position() <= size_);
+    auto n = last.position() - offset;
+    if (offset == 0) {
+      drop_front(n);
+    } else {
+      // Close the gap by moving all elements behind `last` to the front.
+      std::move(begin() + static_cast<difference_type>(last.position()), end(),
+                begin() + static_cast<difference_type>(offset));
+      drop_back(n);
+    }
+    return {this, offset};
+  }
+
+  /// Removes the element at `pos`.
+  iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  /// Removes all elements without releasing memory.
+  void clear() noexcept {
+    drop_front(size_);
+    head_ = 0;
+  }
+
+  /// Moves the first `n` elements to the end of `out` and removes them from
+  /// the queue.
+  /// @pre `n <= size()`
+  void take_front(size_t n, std::vector<T>& out) {
+    CAF_ASSERT(n <= size_);
+    out.reserve(out.size() + n);
+    // Move at most two contiguous segments.
+    auto first_len = std::min(n, capacity_ - head_);
+    auto first = data_ + head_;
+    out.insert(out.end(), std::make_move_iterator(first),
+               std::make_move_iterator(first + first_len));
+    if (first_len < n)
+      out.insert(out.end(), std::make_move_iterator(data_),
+                 std::make_move_iterator(data_ + (n - first_len)));
+    drop_front(n);
+  }
+
+  void swap(ring_queue& other) noexcept {
+    using std::swap;
+    swap(data_, other.data_);
+    swap(capacity_, other.capacity_);
+    swap(head_, other.head_);
+    swap(size_, other.size_);
+  }
+
+private:
+  template <class... Ts>
+  reference emplace_back_impl(Ts&&... xs) {
+    auto ptr = data_ + index(size_);
+    new (ptr) T(std::forward<Ts>(xs)...);
+    ++size_;
+    return *ptr;
+  }
+
+  size_t index(size_t pos) const noexcept {
+    return (head_ + pos) & (capacity_ - 1);
+  }
+
+  void drop_front(size_t n) noexcept {
+    CAF_ASSERT(n <= size_);
+    if constexpr (!std::is_trivially_destructible<T>::value)
+      for (size_t i = 0; i < n; ++i)
+        data_[index(i)].~T();
+    if (n > 0) {
+      head_ = index(n);
+      size_ -= n;
+    }
+  }
+
+  void drop_back(size_t n) noexcept {
+    CAF_ASSERT(n <= size_);
+    if constexpr (!std::is_trivially_destructible<T>::value)
+      for (size_t i = size_ - n; i < size_; ++i)
+        data_[index(i)].~T();
+    size_ -= n;
+  }
+
+  void grow(size_t min_size) {
+    auto new_capacity = std::max(capacity_ * 2, min_capacity);
+    while (new_capacity < min_size)
+      new_capacity *= 2;
+    std::allocator<T> alloc;
+    auto new_data = alloc.allocate(new_capacity);
+    for (size_t i = 0; i < size_; ++i) {
+      auto& x = data_[index(i)];
+      new (new_data + i) T(std::move(x));
+      x.~T();
+    }
+    if (data_ != nullptr)
+      alloc.deallocate(data_, capacity_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  T* data_;
+  size_t capacity_;
+  size_t head_;
+  size_t size_;
+};
+
+} // namespace caf::detail
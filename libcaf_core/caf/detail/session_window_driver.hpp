@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "caf/actor_clock.hpp"
+#include "caf/downstream.hpp"
+#include "caf/stream_stage_driver.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Aggregates bursts of elements and emits one aggregate per burst. A burst
+/// ends when no element arrives for a configurable gap.
+template <class Monoid, class DownstreamManager>
+class session_window_driver final
+  : public stream_stage_driver<typename Monoid::input_type,
+                               DownstreamManager> {
+public:
+  using super
+    = stream_stage_driver<typename Monoid::input_type, DownstreamManager>;
+
+  using typename super::input_type;
+
+  using typename super::output_type;
+
+  using time_point = actor_clock::time_point;
+
+  session_window_driver(DownstreamManager& out, actor_clock& clock,
+                        timespan gap, Monoid monoid)
+    : super(out),
+      clock_(&clock),
+      gap_(gap),
+      monoid_(std::move(monoid)),
+      acc_(monoid_.identity()),
+      count_(0) {
+    // nop
+  }
+
+  void process(downstream<output_type>& out,
+               std::vector<input_type>& xs) override {
+    if (xs.empty())
+      return;
+    auto now = clock_->now();
+    tick(out, now);
+    for (auto& x : xs)
+      monoid_.add(acc_, x);
+    count_ += xs.size();
+    last_ = now;
+  }
+
+  void tick(downstream<output_type>& out, time_point now) override {
+    if (count_ > 0 && now - last_ >= gap_)
+      emit(out);
+  }
+
+  bool awaits_tick() const noexcept override {
+    return count_ > 0;
+  }
+
+  void inputs_closed(downstream<output_type>& out) override {
+    if (count_ > 0)
+      emit(out);
+  }
+
+private:
+  void emit(downstream<output_type>& out) {
+    out.push(std::move(acc_));
+    acc_ = monoid_.identity();
+    count_ = 0;
+  }
+
+  actor_clock* clock_;
+  timespan gap_;
+  Monoid monoid_;
+  output_type acc_;
+  size_t count_;
+  time_point last_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "caf/actor_clock.hpp"
+#include "caf/detail/ring_queue.hpp"
+#include "caf/detail/two_stacks_aggregator.hpp"
+#include "caf/detail/window_boundary.hpp"
+#include "caf/downstream.hpp"
+#include "caf/stream_stage_driver.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Aggregates all elements that arrive within overlapping windows. Each window
+/// consists of `size / slide` panes (rounded up) of length `slide`. The driver
+/// aggregates each pane incrementally and combines the panes of a window with
+/// a `two_stacks_aggregator`, i.e., without re-scanning any element. After
+/// each pane, the driver emits the aggregate of the window ending with this
+/// pane unless the window has no elements.
+template <class Monoid, class DownstreamManager>
+class sliding_window_driver final
+  : public stream_stage_driver<typename Monoid::input_type,
+                               DownstreamManager> {
+public:
+  using super
+    = stream_stage_driver<typename Monoid::input_type, DownstreamManager>;
+
+  using typename super::input_type;
+
+  using typename super::output_type;
+
+  using time_point = actor_clock::time_point;
+
+  sliding_window_driver(DownstreamManager& out, actor_clock& clock,
+                        timespan size, timespan slide, Monoid monoid)
+    : super(out),
+      clock_(&clock),
+      slide_(slide),
+      num_panes_(static_cast<size_t>((size + slide - timespan{1}) / slide)),
+      monoid_(std::move(monoid)),
+      window_(monoid_),
+      pane_(monoid_.identity()),
+      pane_count_(0),
+      window_count_(0) {
+    CAF_ASSERT(slide.count() > 0);
+    if (num_panes_ == 0)
+      num_panes_ = 1;
+  }
+
+  void process(downstream<output_type>& out,
+               std::vector<input_type>& xs) override {
+    auto now = clock_->now();
+    advance(out, now);
+    if (pane_count_ == 0 && window_count_ == 0)
+      pane_end_ = next_window_boundary(now, slide_);
+    for (auto& x : xs)
+      monoid_.add(pane_, x);
+    pane_count_ += xs.size();
+  }
+
+  void tick(downstream<output_type>& out, time_point now) override {
+    advance(out, now);
+  }
+
+  bool awaits_tick() const noexcept override {
+    return pane_count_ > 0 || window_count_ > 0;
+  }
+
+  void inputs_closed(downstream<output_type>& out) override {
+    advance(out, time_point::max());
+  }
+
+private:
+  // Closes all panes that end before `now`.
+  void advance(downstream<output_type>& out, time_point now) {
+    while ((pane_count_ > 0 || window_count_ > 0) && now >= pane_end_) {
+      window_.push(std::move(pane_));
+      counts_.push_back(pane_count_);
+      window_count_ += pane_count_;
+      pane_ = monoid_.identity();
+      pane_count_ = 0;
+      if (window_.size() > num_panes_) {
+        window_.pop();
+        window_count_ -= counts_.front();
+        counts_.pop_front();
+      }
+      if (window_count_ > 0)
+        out.push(window_.query());
+      pane_end_ += slide_;
+    }
+    // Drop empty panes once the last element left the window.
+    if (pane_count_ == 0 && window_count_ == 0 && !window_.empty()) {
+      window_.clear();
+      counts_.clear();
+    }
+  }
+
+  actor_clock* clock_;
+  timespan slide_;
+  size_t num_panes_;
+  Monoid monoid_;
+  two_stacks_aggregator<Monoid> window_;
+  ring_queue<size_t> counts_;
+  output_type pane_;
+  size_t pane_count_;
+  size_t window_count_;
+  time_point pane_end_;
+};
+
+} // namespace caf::detail
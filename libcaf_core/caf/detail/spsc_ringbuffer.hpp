@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// A lock-free ringbuffer for a single producer and a single consumer that can
+/// hold a maximum of `Size` elements. Neither side ever blocks: `try_push`
+/// fails if the buffer is full and `try_pop` fails if it is empty.
+template <class T, size_t Size>
+class spsc_ringbuffer {
+public:
+  static_assert(Size > 0 && (Size & (Size - 1)) == 0,
+                "Size must be a power of two");
+
+  spsc_ringbuffer() : wr_pos_(0), rd_pos_(0) {
+    // nop
+  }
+
+  spsc_ringbuffer(const spsc_ringbuffer&) = delete;
+
+  spsc_ringbuffer& operator=(const spsc_ringbuffer&) = delete;
+
+  /// Moves `x` into the buffer unless the buffer is full.
+  /// @returns `true` if the buffer took ownership of `x`, `false` otherwise.
+  /// @note Only the producer may call this function.
+  bool try_push(T& x) {
+    auto wp = wr_pos_.load(std::memory_order_relaxed);
+    if (wp - rd_pos_.load(std::memory_order_acquire) == Size)
+      return false;
+    buf_[wp & (Size - 1)] = std::move(x);
+    wr_pos_.store(wp + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves the oldest element into `x` unless the buffer is empty.
+  /// @returns `true` if `x` received an element, `false` otherwise.
+  /// @note Only the consumer may call this function.
+  bool try_pop(T& x) {
+    auto rp = rd_pos_.load(std::memory_order_relaxed);
+    if (rp == wr_pos_.load(std::memory_order_acquire))
+      return false;
+    x = std::move(buf_[rp & (Size - 1)]);
+    rd_pos_.store(rp + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves all elements into `out` by calling `out.emplace_back`.
+  /// @returns The number of moved elements.
+  /// @note Only the consumer may call this function.
+  template <class Container>
+  size_t drain(Container& out) {
+    auto rp = rd_pos_.load(std::memory_order_relaxed);
+    auto wp = wr_pos_.load(std::memory_order_acquire);
+    for (auto i = rp; i != wp; ++i)
+      out.emplace_back(std::move(buf_[i & (Size - 1)]));
+    rd_pos_.store(wp, std::memory_order_release);
+    return wp - rp;
+  }
+
+  bool empty() const noexcept {
+    return rd_pos_.load() == wr_pos_.load();
+  }
+
+private:
+  // Stores the number of elements the producer has written so far. Lives on
+  // its own cache line to avoid false sharing with the consumer.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> wr_pos_;
+
+  // Stores the number of elements the consumer has read so far.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> rd_pos_;
+
+  // Stores the elements.
+  alignas(CAF_CACHE_LINE_SIZE) std::array<T, Size> buf_;
+};
+
+} // namespace caf::detail
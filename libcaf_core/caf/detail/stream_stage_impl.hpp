@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "caf/downstream.hpp"
+#include "caf/inbound_path.hpp"
 #include "caf/logger.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/outbound_path.hpp"
@@ -63,25 +66,49 @@ public:
     CAF_LOG_TRACE(CAF_ARG(x));
     using vec_type = std::vector<input_type>;
     if (auto view = make_typed_message_view<vec_type>(x.xs)) {
-      auto old_size = this->out_.buf().size();
-      downstream<output_type> ds{this->out_.buf()};
-      driver_.process(ds, get<0>(view));
-      auto new_size = this->out_.buf().size();
-      this->out_.generated_messages(new_size - old_size);
+      with_downstream([&](auto& ds) { driver_.process(ds, get<0>(view)); });
       return;
     }
     CAF_LOG_ERROR("received unexpected batch type (dropped)");
   }
 
+  void handle(inbound_path* from, downstream_msg::close& x) override {
+    CAF_LOG_TRACE(CAF_ARG(x));
+    super::handle(from, x);
+    auto closed = [](inbound_path* path) { return path->hdl == nullptr; };
+    if (std::all_of(this->inbound_paths_.begin(), this->inbound_paths_.end(),
+                    closed))
+      with_downstream([this](auto& ds) { driver_.inputs_closed(ds); });
+  }
+
   int32_t acquire_credit(inbound_path* path, int32_t desired) override {
     return driver_.acquire_credit(path, desired);
   }
 
+  bool idle() const noexcept override {
+    return super::idle() && !driver_.awaits_tick();
+  }
+
 protected:
   void finalize(const error& reason) override {
     driver_.finalize(reason);
   }
 
+  void advance_time(actor_clock::time_point now) override {
+    with_downstream([this, now](auto& ds) { driver_.tick(ds, now); });
+  }
+
+  // Calls `f` with a downstream on our output buffer and accounts for all
+  // elements `f` generates.
+  template <class F>
+  void with_downstream(F f) {
+    auto old_size = this->out_.buf().size();
+    downstream<output_type> ds{this->out_.buf()};
+    f(ds);
+    auto new_size = this->out_.buf().size();
+    this->out_.generated_messages(new_size - old_size);
+  }
+
   driver_type driver_;
 };
 
@@ -0,0 +1,109 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// Aggregates the values in a FIFO queue with amortized O(1) cost per
+/// operation by splitting the queue into two stacks. The front stack stores
+/// partial aggregates (for removing old values) and the back stack stores
+/// plain values plus their running aggregate (for adding new values).
+/// @tparam Monoid Provides `identity()` and an associative `combine(x, y)`
+///                for values of type `Monoid::value_type`.
+template <class Monoid>
+class two_stacks_aggregator {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = typename Monoid::value_type;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit two_stacks_aggregator(Monoid monoid = {})
+    : monoid_(std::move(monoid)), back_agg_(monoid_.identity()) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t size() const noexcept {
+    return front_.size() + back_.size();
+  }
+
+  bool empty() const noexcept {
+    return front_.empty() && back_.empty();
+  }
+
+  /// Returns the aggregate of all values in the queue, from oldest to newest.
+  value_type query() const {
+    if (front_.empty())
+      return back_agg_;
+    return monoid_.combine(front_.back(), back_agg_);
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Appends `x` to the queue.
+  void push(value_type x) {
+    back_agg_ = monoid_.combine(back_agg_, x);
+    back_.emplace_back(std::move(x));
+  }
+
+  /// Removes the oldest value from the queue.
+  /// @pre `!empty()`
+  void pop() {
+    CAF_ASSERT(!empty());
+    if (front_.empty())
+      flip();
+    front_.pop_back();
+  }
+
+  /// Removes all values from the queue.
+  void clear() {
+    front_.clear();
+    back_.clear();
+    back_agg_ = monoid_.identity();
+  }
+
+private:
+  // Moves all values from the back stack to the front stack. The top of the
+  // front stack is the oldest value and stores the aggregate of all values.
+  void flip() {
+    auto agg = monoid_.identity();
+    for (auto i = back_.rbegin(); i != back_.rend(); ++i) {
+      agg = monoid_.combine(*i, agg);
+      front_.emplace_back(agg);
+    }
+    back_.clear();
+    back_agg_ = monoid_.identity();
+  }
+
+  Monoid monoid_;
+  std::vector<value_type> front_;
+  std::vector<value_type> back_;
+  value_type back_agg_;
+};
+
+} // namespace caf::detail
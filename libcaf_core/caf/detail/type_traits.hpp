@@ -628,6 +628,8 @@ CAF_HAS_ALIAS_TRAIT(key_type);
 
 CAF_HAS_ALIAS_TRAIT(mapped_type);
 
+CAF_HAS_ALIAS_TRAIT(snapshot_type);
+
 // -- constexpr functions for use in enable_if & friends -----------------------
 
 template <class List1, class List2>
@@ -0,0 +1,37 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "caf/actor_clock.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::detail {
+
+/// Returns the end of the window of length `size` that contains `t`. Windows
+/// start at multiples of `size` relative to the epoch of the actor clock.
+inline actor_clock::time_point next_window_boundary(actor_clock::time_point t,
+                                                    timespan size) {
+  using duration_type = actor_clock::duration_type;
+  auto d = std::chrono::duration_cast<duration_type>(size);
+  return t - t.time_since_epoch() % d + d;
+}
+
+} // namespace caf::detail
@@ -18,9 +18,9 @@
 
 #pragma once
 
-#include <deque>
 #include <vector>
 
+#include "caf/detail/ring_queue.hpp"
 #include "caf/message.hpp"
 
 namespace caf {
@@ -32,7 +32,7 @@ public:
   // -- member types -----------------------------------------------------------
 
   /// A queue of items for temporary storage before moving them into chunks.
-  using queue_type = std::deque<T>;
+  using queue_type = detail::ring_queue<T>;
 
   // -- constructors, destructors, and assignment operators --------------------
 
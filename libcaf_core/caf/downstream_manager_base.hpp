@@ -27,6 +27,7 @@
 #include "caf/outbound_path.hpp"
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/histogram.hpp"
 
 namespace caf {
 
@@ -50,6 +51,10 @@ public:
     /// Tracks how many stream elements are currently waiting in the output
     /// buffer due to insufficient credit.
     telemetry::int_gauge* output_buffer_size = nullptr;
+
+    /// Samples how long paths wait for new credit after running out of
+    /// credit.
+    telemetry::dbl_histogram* credit_starvation_time = nullptr;
   };
 
   // -- constructors, destructors, and assignment operators --------------------
@@ -31,6 +31,7 @@
 #include "caf/stream_priority.hpp"
 #include "caf/stream_slot.hpp"
 #include "caf/tag/boxing_type.hpp"
+#include "caf/timestamp.hpp"
 #include "caf/variant.hpp"
 
 namespace caf {
@@ -48,6 +49,9 @@ struct downstream_msg_batch {
 
   /// ID of this batch (ascending numbering).
   int64_t id;
+
+  /// Time of emitting this batch at the source.
+  timestamp created = timestamp{};
 };
 
 /// Orderly shuts down a stream after receiving an ACK for the last batch.
@@ -138,7 +142,9 @@ template <class Inspector>
 bool inspect(Inspector& f, downstream_msg::batch& x) {
   return f.object(x).pretty_name("batch").fields(f.field("size", x.xs_size),
                                                  f.field("xs", x.xs),
-                                                 f.field("id", x.id));
+                                                 f.field("id", x.id),
+                                                 f.field("created",
+                                                         x.created));
 }
 
 /// @relates downstream_msg::close
@@ -0,0 +1,117 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "caf/byte.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/mapped_file.hpp"
+
+namespace caf {
+
+/// A read-only view into a `mapped_file` that keeps the region alive. Copying
+/// a slice only increments a reference count, which allows stream sources to
+/// emit the content of memory-mapped files without copying any bytes.
+/// @note Serializing a slice copies its bytes, since receivers on other nodes
+///       have no access to the mapping. Deserialized slices own their content.
+class file_slice {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  file_slice() noexcept : offset_(0), size_(0) {
+    // nop
+  }
+
+  /// @pre `offset + size <= file->size()`
+  file_slice(mapped_file_ptr file, size_t offset, size_t size) noexcept
+    : file_(std::move(file)), offset_(offset), size_(size) {
+    // nop
+  }
+
+  /// Creates a slice that owns `buf`.
+  explicit file_slice(byte_buffer buf)
+    : file_(make_counted<mapped_file>(std::move(buf))), offset_(0) {
+    size_ = file_->size();
+  }
+
+  file_slice(file_slice&&) noexcept = default;
+
+  file_slice(const file_slice&) noexcept = default;
+
+  file_slice& operator=(file_slice&&) noexcept = default;
+
+  file_slice& operator=(const file_slice&) noexcept = default;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns a pointer to the first byte of the slice.
+  const byte* data() const noexcept {
+    return file_ ? file_->data() + offset_ : nullptr;
+  }
+
+  /// Returns the size of the slice in bytes.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns whether the slice contains no bytes.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the content of this slice.
+  const_byte_span bytes() const noexcept {
+    return {data(), size_};
+  }
+
+  /// Returns the region that contains this slice.
+  const mapped_file_ptr& file() const noexcept {
+    return file_;
+  }
+
+  /// Returns the position of the first byte in the region.
+  size_t offset() const noexcept {
+    return offset_;
+  }
+
+private:
+  mapped_file_ptr file_;
+  size_t offset_;
+  size_t size_;
+};
+
+/// @relates file_slice
+template <class Inspector>
+bool inspect(Inspector& f, file_slice& x) {
+  auto get = [&x] {
+    auto bytes = x.bytes();
+    return byte_buffer{bytes.begin(), bytes.end()};
+  };
+  auto set = [&x](byte_buffer buf) {
+    x = file_slice{std::move(buf)};
+    return true;
+  };
+  return f.object(x).fields(f.field("bytes", get, set));
+}
+
+} // namespace caf
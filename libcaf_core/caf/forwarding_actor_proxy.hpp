@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
 #include "caf/actor.hpp"
 #include "caf/actor_proxy.hpp"
 #include "caf/detail/core_export.hpp"
@@ -30,7 +34,20 @@ class CAF_CORE_EXPORT forwarding_actor_proxy : public actor_proxy {
 public:
   using forwarding_stack = std::vector<strong_actor_ptr>;
 
-  forwarding_actor_proxy(actor_config& cfg, actor dest);
+  /// Shares the state of the send buffer of a connection with its broker.
+  struct send_buffer_state {
+    /// Counts the Bytes in the send buffer. The broker only updates this
+    /// counter while `observers > 0`.
+    std::atomic<size_t> pending_bytes{0};
+
+    /// Counts the stream paths that read `pending_bytes`.
+    std::atomic<size_t> observers{0};
+  };
+
+  using send_buffer_ptr = std::shared_ptr<send_buffer_state>;
+
+  forwarding_actor_proxy(actor_config& cfg, actor dest,
+                         send_buffer_ptr send_buffer = nullptr);
 
   ~forwarding_actor_proxy() override;
 
@@ -42,12 +59,19 @@ public:
 
   void kill_proxy(execution_unit* ctx, error rsn) override;
 
+  size_t pending_bytes() const noexcept override;
+
+  void add_pending_bytes_observer() noexcept override;
+
+  void remove_pending_bytes_observer() noexcept override;
+
 private:
   void forward_msg(strong_actor_ptr sender, message_id mid, message msg,
-                   const forwarding_stack* fwd = nullptr);
+                   forwarding_stack* fwd = nullptr);
 
   mutable detail::shared_spinlock broker_mtx_;
   actor broker_;
+  send_buffer_ptr send_buffer_;
 };
 
 } // namespace caf
@@ -0,0 +1,157 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "caf/detail/type_list.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/downstream.hpp"
+#include "caf/fwd.hpp"
+#include "caf/unit.hpp"
+
+namespace caf {
+
+// -- trait for deducing input and output of a single step ---------------------
+
+template <class F>
+struct stream_step_trait {
+  static constexpr bool valid = false;
+};
+
+/// Deduces the input and output type of a stateless stream step from its
+/// signature `void(downstream<Out>&, In)`.
+template <class In, class Out>
+struct stream_step_trait<void(downstream<Out>&, In)> {
+  static constexpr bool valid = true;
+  using input = std::decay_t<In>;
+  using output = Out;
+};
+
+/// Convenience alias for extracting the function signature from `F` and
+/// passing it to `stream_step_trait`.
+template <class F>
+using stream_step_trait_t
+  = stream_step_trait<typename detail::get_callable_trait<F>::fun_sig>;
+
+namespace detail {
+
+/// Chains stream steps into a single processing function for a stream stage.
+/// Each step processes the entire batch before passing its output to the next
+/// step. Intermediate results stay in buffers that retain their capacity
+/// between batches.
+template <class... Fs>
+class fused_stream_steps {
+public:
+  // -- member types -----------------------------------------------------------
+
+  static_assert(sizeof...(Fs) > 0, "cannot fuse an empty list of steps");
+
+  static_assert((stream_step_trait_t<Fs>::valid && ...),
+                "Expected signature `void (downstream<Out>&, In)` "
+                "for all stream steps");
+
+  using inputs = type_list<typename stream_step_trait_t<Fs>::input...>;
+
+  using outputs = type_list<typename stream_step_trait_t<Fs>::output...>;
+
+  static constexpr size_t num_steps = sizeof...(Fs);
+
+  /// Element type of the input stream.
+  using input_type = tl_head_t<inputs>;
+
+  /// Element type of the output stream.
+  using output_type = tl_back_t<outputs>;
+
+  static_assert(std::is_same<tl_tail_t<inputs>, tl_pop_back_t<outputs>>::value,
+                "each step must consume the output type of its predecessor");
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit fused_stream_steps(Fs... fs) : fs_(std::move(fs)...) {
+    // nop
+  }
+
+  // -- stage interface --------------------------------------------------------
+
+  void operator()(unit_t&, downstream<output_type>& out,
+                  std::vector<input_type>& xs) {
+    run<0>(xs, out);
+  }
+
+private:
+  template <size_t I>
+  using buffer_type =
+    typename downstream<tl_at_t<outputs, I>>::queue_type;
+
+  template <size_t... Is>
+  static auto make_buffers(std::index_sequence<Is...>)
+    -> std::tuple<buffer_type<Is>...>;
+
+  using buffers_type
+    = decltype(make_buffers(std::make_index_sequence<num_steps - 1>{}));
+
+  template <size_t I, class Inputs>
+  void run(Inputs& xs, downstream<output_type>& out) {
+    auto& f = std::get<I>(fs_);
+    if constexpr (I + 1 == num_steps) {
+      for (auto& x : xs)
+        f(out, std::move(x));
+    } else {
+      auto& buf = std::get<I>(bufs_);
+      downstream<tl_at_t<outputs, I>> next{buf};
+      for (auto& x : xs)
+        f(next, std::move(x));
+      if (!buf.empty()) {
+        run<I + 1>(buf, out);
+        buf.clear();
+      }
+    }
+  }
+
+  std::tuple<Fs...> fs_;
+
+  buffers_type bufs_;
+};
+
+} // namespace detail
+
+/// Fuses a chain of stateless stream steps into a single processing function
+/// for `attach_stream_stage`. Each step has the signature
+/// `void (downstream<Out>&, In)` and consumes the output of its predecessor.
+/// Running several steps in one stage avoids sending each batch through the
+/// mailbox of one actor per step and requires only one credit loop.
+///
+/// ~~~
+/// attach_stream_stage(
+///   self, in, [](unit_t&) {},
+///   fuse_stream_steps(
+///     [](downstream<int>& out, int x) { if (x % 2 == 0) out.push(x); },
+///     [](downstream<std::string>& out, int x) { out.push(to_string(x)); }));
+/// ~~~
+template <class... Fs>
+detail::fused_stream_steps<Fs...> fuse_stream_steps(Fs... fs) {
+  return detail::fused_stream_steps<Fs...>{std::move(fs)...};
+}
+
+} // namespace caf
@@ -111,6 +111,7 @@ class downstream_manager;
 class downstream_manager_base;
 class event_based_actor;
 class execution_unit;
+class file_slice;
 class forwarding_actor_proxy;
 class group;
 class group_module;
@@ -124,6 +125,7 @@ class ipv6_endpoint;
 class ipv6_subnet;
 class local_actor;
 class mailbox_element;
+class mapped_file;
 class message;
 class message_builder;
 class message_handler;
@@ -163,6 +165,7 @@ struct downstream_msg_close;
 struct downstream_msg_forced_close;
 struct exit_msg;
 struct group_down_msg;
+struct hot_actor;
 struct illegal_message_element;
 struct invalid_actor_addr_t;
 struct invalid_actor_t;
@@ -270,10 +273,20 @@ class metric_family_impl;
 template <class Type>
 class metric_impl;
 
+template <class ValueType>
+class sharded_counter;
+
+template <class ValueType>
+class sharded_gauge;
+
 using dbl_counter = counter<double>;
 using dbl_histogram = histogram<double>;
 using int_counter = counter<int64_t>;
 using int_histogram = histogram<int64_t>;
+using sharded_dbl_counter = sharded_counter<double>;
+using sharded_dbl_gauge = sharded_gauge<double>;
+using sharded_int_counter = sharded_counter<int64_t>;
+using sharded_int_gauge = sharded_gauge<int64_t>;
 
 using dbl_counter_family = metric_family_impl<dbl_counter>;
 using dbl_histogram_family = metric_family_impl<dbl_histogram>;
@@ -281,6 +294,10 @@ using dbl_gauge_family = metric_family_impl<dbl_gauge>;
 using int_counter_family = metric_family_impl<int_counter>;
 using int_histogram_family = metric_family_impl<int_histogram>;
 using int_gauge_family = metric_family_impl<int_gauge>;
+using sharded_dbl_counter_family = metric_family_impl<sharded_dbl_counter>;
+using sharded_dbl_gauge_family = metric_family_impl<sharded_dbl_gauge>;
+using sharded_int_counter_family = metric_family_impl<sharded_int_counter>;
+using sharded_int_gauge_family = metric_family_impl<sharded_int_gauge>;
 
 } // namespace telemetry
 
@@ -362,6 +379,7 @@ class abstract_worker_hub;
 class disposer;
 class dynamic_message_data;
 class group_manager;
+class mailbox_sampler;
 class message_data;
 class private_thread;
 
@@ -0,0 +1,58 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// Describes one of the actors with the deepest mailboxes in the system, as
+/// observed by the mailbox sampler.
+struct hot_actor {
+  /// The ID of the actor.
+  actor_id id;
+
+  /// The user-defined name of the actor type.
+  std::string name;
+
+  /// Number of messages in the mailbox at the time of sampling.
+  size_t mailbox_size;
+};
+
+/// @relates hot_actor
+inline bool operator==(const hot_actor& x, const hot_actor& y) noexcept {
+  return x.id == y.id && x.name == y.name && x.mailbox_size == y.mailbox_size;
+}
+
+/// @relates hot_actor
+inline bool operator!=(const hot_actor& x, const hot_actor& y) noexcept {
+  return !(x == y);
+}
+
+/// @relates hot_actor
+template <class Inspector>
+bool inspect(Inspector& f, hot_actor& x) {
+  return f.object(x).fields(f.field("id", x.id), f.field("name", x.name),
+                            f.field("mailbox-size", x.mailbox_size));
+}
+
+} // namespace caf
@@ -25,6 +25,7 @@
 #include "caf/actor_control_block.hpp"
 #include "caf/credit_controller.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/latency_based_credit_controller.hpp"
 #include "caf/detail/size_based_credit_controller.hpp"
 #include "caf/detail/token_based_credit_controller.hpp"
 #include "caf/downstream_msg.hpp"
@@ -36,6 +37,7 @@
 #include "caf/stream_slot.hpp"
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/histogram.hpp"
 #include "caf/timestamp.hpp"
 #include "caf/upstream_msg.hpp"
 
@@ -56,6 +58,9 @@ public:
   struct metrics_t {
     telemetry::int_counter* processed_elements;
     telemetry::int_gauge* input_buffer_size;
+    telemetry::int_histogram* batch_size;
+    telemetry::dbl_histogram* batch_latency;
+    telemetry::dbl_histogram* credit_round_trip_time;
   };
 
   /// Discrete point in time, as reported by the actor clock.
@@ -76,6 +81,8 @@ public:
     if (auto str = get_if<std::string>(&cfg, "caf.stream.credit-policy")) {
       if (*str == "token-based")
         controller_ = detail::token_based_credit_controller::make(self(), in);
+      else if (*str == "latency-based")
+        controller_ = detail::latency_based_credit_controller::make(self(), in);
       else if (*str == "size-based")
         set_default();
       else {
@@ -136,6 +143,11 @@ public:
   /// Stores when the last ACK was emitted.
   time_point last_ack_time;
 
+  /// Stores when this path granted new credit while receiving no batch since,
+  /// or the default-constructed timestamp otherwise. Only set when collecting
+  /// actor metrics.
+  timestamp credit_granted;
+
   // -- properties -------------------------------------------------------------
 
   /// Returns whether the path received no input since last emitting
@@ -167,6 +179,12 @@ public:
   /// of time.
   void tick(time_point now, duration_type max_batch_delay);
 
+  // -- metrics ----------------------------------------------------------------
+
+  /// Samples size and latency of `x` as well as the credit round trip time.
+  /// @pre `metrics.batch_size != nullptr`
+  void sample(const downstream_msg::batch& x);
+
   // -- messaging --------------------------------------------------------------
 
   /// Emits an `upstream_msg::ack_batch`.
@@ -75,6 +75,12 @@ public:
 
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge* mailbox_size = nullptr;
+
+    /// Accumulates the CPU time of the actor (opt-in).
+    telemetry::dbl_counter* cpu_time = nullptr;
+
+    /// Accumulates the bytes allocated by the actor (opt-in).
+    telemetry::int_counter* allocated_bytes = nullptr;
   };
 
   /// Optional metrics for inbound stream traffic collected by individual actors
@@ -85,6 +91,16 @@ public:
 
     /// Tracks how many stream elements from upstream are currently buffered.
     telemetry::int_gauge* input_buffer_size = nullptr;
+
+    /// Samples how many elements each batch from upstream contains.
+    telemetry::int_histogram* batch_size = nullptr;
+
+    /// Samples how long batches travel from upstream before processing.
+    telemetry::dbl_histogram* batch_latency = nullptr;
+
+    /// Samples how long the actor waits for the first batch after granting
+    /// new credit to upstream.
+    telemetry::dbl_histogram* credit_round_trip_time = nullptr;
   };
 
   /// Optional metrics for outbound stream traffic collected by individual
@@ -96,6 +112,10 @@ public:
     /// Tracks how many stream elements are currently waiting in the output
     /// buffer due to insufficient credit.
     telemetry::int_gauge* output_buffer_size = nullptr;
+
+    /// Samples how long outbound paths wait for new credit after running out
+    /// of credit.
+    telemetry::dbl_histogram* credit_starvation_time = nullptr;
   };
 
   // -- constructors, destructors, and assignment operators --------------------
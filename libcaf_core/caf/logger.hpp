@@ -18,14 +18,22 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
+#include <tuple>
 #include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 #include "caf/abstract_actor.hpp"
 #include "caf/config.hpp"
@@ -34,7 +42,6 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/log_level.hpp"
 #include "caf/detail/pretty_type_name.hpp"
-#include "caf/detail/ringbuffer.hpp"
 #include "caf/detail/scope_guard.hpp"
 #include "caf/detail/shared_spinlock.hpp"
 #include "caf/fwd.hpp"
@@ -72,12 +79,14 @@ public:
 
   // -- constants --------------------------------------------------------------
 
-  /// Configures the size of the circular event queue.
-  static constexpr size_t queue_size = 128;
+  /// Configures the size of the circular event queue of each thread.
+  static constexpr size_t queue_size = 256;
 
   // -- member types -----------------------------------------------------------
 
   /// Combines various logging-related flags and parameters into a bitfield.
+  /// The verbosity fields store the configuration at startup. The logger keeps
+  /// its current verbosity separately, since users may change it at runtime.
   struct config {
     /// Stores `max(file_verbosity, console_verbosity)`.
     unsigned verbosity : 4;
@@ -96,6 +105,11 @@ public:
     /// Configures whether the logger generates colored output.
     bool console_coloring : 1;
 
+    /// Configures whether the logger writes each call site only once to the
+    /// log file and refers to it by ID afterwards instead of rendering each
+    /// event with the file format.
+    bool intern_sites : 1;
+
     config();
   };
 
@@ -207,6 +221,50 @@ public:
     std::string str_;
   };
 
+  /// Caches whether any logger accepts events from a single call site. The
+  /// logging macros create one static instance per call site. Disabled call
+  /// sites cost a single relaxed load and never build their log event.
+  /// Loggers update all call sites whenever their verbosity or their excluded
+  /// components change.
+  /// @warning Instances must have static storage duration.
+  class CAF_CORE_EXPORT call_site {
+  public:
+    friend class logger;
+
+    constexpr call_site(unsigned level, string_view component) noexcept
+      : level_(level), component_(component), state_(unknown), next_(nullptr) {
+      // nop
+    }
+
+    call_site(const call_site&) = delete;
+
+    call_site& operator=(const call_site&) = delete;
+
+    /// Returns whether at least one logger accepts events from this site.
+    bool enabled() noexcept {
+      auto st = state_.load(std::memory_order_relaxed);
+      return st == unknown ? init() : st == on;
+    }
+
+  private:
+    static constexpr uint8_t unknown = 0;
+
+    static constexpr uint8_t on = 1;
+
+    static constexpr uint8_t off = 2;
+
+    /// Registers this site on first use and computes its initial state.
+    bool init();
+
+    /// Recomputes the state of this site from all live loggers.
+    void update();
+
+    unsigned level_;
+    string_view component_;
+    std::atomic<uint8_t> state_;
+    call_site* next_;
+  };
+
   // -- constructors, destructors, and assignment operators --------------------
 
   ~logger() override;
@@ -240,17 +298,38 @@ public:
   }
 
   unsigned verbosity() const noexcept {
-    return cfg_.verbosity;
+    return verbosity_.load(std::memory_order_relaxed);
   }
 
   unsigned file_verbosity() const noexcept {
-    return cfg_.file_verbosity;
+    return file_verbosity_.load(std::memory_order_relaxed);
   }
 
   unsigned console_verbosity() const noexcept {
-    return cfg_.console_verbosity;
+    return console_verbosity_.load(std::memory_order_relaxed);
   }
 
+  // -- runtime configuration --------------------------------------------------
+
+  /// Changes the verbosity for file output at runtime, e.g., to temporarily
+  /// enable debug output in production. Has no effect if file output was
+  /// disabled at startup.
+  /// @thread-safe
+  void file_verbosity(unsigned level);
+
+  /// Changes the verbosity for console output at runtime. Has no effect if
+  /// console output was disabled at startup.
+  /// @thread-safe
+  void console_verbosity(unsigned level);
+
+  /// Replaces the excluded components for file output at runtime.
+  /// @thread-safe
+  void file_excluded_components(std::vector<std::string> names);
+
+  /// Replaces the excluded components for console output at runtime.
+  /// @thread-safe
+  void console_excluded_components(std::vector<std::string> names);
+
   // -- static utility functions -----------------------------------------------
 
   /// Renders the prefix (namespace and class) of a fully qualified function.
@@ -269,6 +348,13 @@ public:
   /// Skips path in `filename`.
   static string_view skip_path(string_view filename);
 
+  /// Renders a log file that the logger wrote with
+  /// `caf.logger.file.intern-sites` enabled. Since the file does not include
+  /// the original thread IDs, the thread field renders a hash of the ID.
+  /// @returns `true` if `in` contained a valid log, `false` otherwise.
+  static bool render_interned_log(std::istream& in, std::ostream& out,
+                                  const line_format& lf);
+
   // -- utility functions ------------------------------------------------------
 
   /// Renders `x` using the line format `lf` to `out`.
@@ -315,8 +401,42 @@ private:
 
   bool open_file();
 
+  /// Recomputes `verbosity_` and `global_filter_`. Requires a unique lock on
+  /// `filter_mtx_`.
+  void update_global_filter();
+
+  /// Adds this logger to the list of loggers that call sites consult.
+  void register_at_call_sites();
+
+  /// Removes this logger from the list of loggers that call sites consult.
+  void unregister_at_call_sites();
+
+  /// Recomputes the state of all call sites.
+  static void update_call_sites();
+
   // -- event handling ---------------------------------------------------------
 
+  /// Buffers events of a single thread until the logger thread picks them up.
+  struct thread_queue;
+
+  using thread_queue_ptr = std::shared_ptr<thread_queue>;
+
+  /// Returns the queue of the calling thread. Creates the queue on first use.
+  thread_queue& local_queue();
+
+  /// Moves the events of all queues into `buf` and removes queues of
+  /// terminated threads.
+  /// @returns the number of events that threads dropped since the last call.
+  size_t drain(std::vector<event>& buf);
+
+  /// Checks whether any queue contains events.
+  bool has_pending();
+
+  /// Wakes up the logger thread.
+  void wakeup();
+
+  void write_interned(const event& x);
+
   void handle_event(const event& x);
 
   void handle_file_event(const event& x);
@@ -340,6 +460,18 @@ private:
   // Configures verbosity and output generation.
   config cfg_;
 
+  // Stores `max(file_verbosity_, console_verbosity_)`.
+  std::atomic<unsigned> verbosity_;
+
+  // Stores the current verbosity for file output.
+  std::atomic<unsigned> file_verbosity_;
+
+  // Stores the current verbosity for console output.
+  std::atomic<unsigned> console_verbosity_;
+
+  // Guards global_filter_, file_filter_ and console_filter_.
+  mutable detail::shared_spinlock filter_mtx_;
+
   // Filters events by component name before enqueuing a log event. Intersection
   // of file_filter_ and console_filter_ if both outputs are enabled.
   std::vector<std::string> global_filter_;
@@ -368,8 +500,30 @@ private:
   // Stream for file output.
   std::fstream file_;
 
-  // Filled with log events by other threads.
-  detail::ringbuffer<event, queue_size> queue_;
+  // Identifies this logger in the thread-local queue caches.
+  uint64_t id_;
+
+  // Guards `queues_`.
+  std::mutex queues_mx_;
+
+  // Filled with log events by other threads. Each thread has its own queue.
+  std::vector<thread_queue_ptr> queues_;
+
+  // Signals the logger thread to drain all queues one last time and then stop.
+  std::atomic<bool> stopping_;
+
+  // Signals whether the logger thread waits on `wakeup_cv_`.
+  std::atomic<bool> sleeping_;
+
+  // Guards `wakeup_cv_`.
+  std::mutex wakeup_mx_;
+
+  // Wakes up the logger thread.
+  std::condition_variable wakeup_cv_;
+
+  // Maps call sites to their ID in the log file.
+  std::map<std::tuple<const char*, const char*, unsigned, unsigned>, uint32_t>
+    interned_sites_;
 
   // Stores the assembled name of the log file.
   std::string file_name_;
@@ -434,12 +588,16 @@ CAF_CORE_EXPORT bool operator==(const logger::field& x, const logger::field& y);
 
 #define CAF_LOG_IMPL(component, loglvl, message)                               \
   do {                                                                         \
-    auto CAF_UNIFYN(caf_logger) = caf::logger::current_logger();               \
-    if (CAF_UNIFYN(caf_logger) != nullptr                                      \
-        && CAF_UNIFYN(caf_logger)->accepts(loglvl, component))                 \
-      CAF_UNIFYN(caf_logger)                                                   \
-        ->log(CAF_LOG_MAKE_EVENT(caf::logger::thread_local_aid(), component,   \
-                                 loglvl, message));                            \
+    static ::caf::logger::call_site CAF_UNIFYN(caf_log_site){loglvl,           \
+                                                             component};       \
+    if (CAF_UNIFYN(caf_log_site).enabled()) {                                  \
+      auto CAF_UNIFYN(caf_logger) = caf::logger::current_logger();             \
+      if (CAF_UNIFYN(caf_logger) != nullptr                                    \
+          && CAF_UNIFYN(caf_logger)->accepts(loglvl, component))               \
+        CAF_UNIFYN(caf_logger)                                                 \
+          ->log(CAF_LOG_MAKE_EVENT(caf::logger::thread_local_aid(), component, \
+                                   loglvl, message));                          \
+    }                                                                          \
   } while (false)
 
 #define CAF_PUSH_AID(aarg)                                                     \
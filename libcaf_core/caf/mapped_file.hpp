@@ -0,0 +1,104 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "caf/byte.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/expected.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/ref_counted.hpp"
+
+namespace caf {
+
+/// A read-only, reference-counted region of memory that either maps a file or
+/// owns a buffer. Mapped files stay mapped as long as any reference exists,
+/// which allows stream elements to point into the mapping without copying.
+class CAF_CORE_EXPORT mapped_file : public ref_counted {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a region that owns `buf`.
+  explicit mapped_file(byte_buffer buf) noexcept;
+
+  mapped_file(const mapped_file&) = delete;
+
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns a pointer to the first byte of the region.
+  const byte* data() const noexcept {
+    return data_;
+  }
+
+  /// Returns the size of the region in bytes.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the entire region.
+  const_byte_span bytes() const noexcept {
+    return {data_, size_};
+  }
+
+  /// Returns whether this region maps a file.
+  bool mapped() const noexcept {
+    return mapping_ != nullptr;
+  }
+
+  // -- hints ------------------------------------------------------------------
+
+  /// Advises the operating system to read `[offset, offset + len)` ahead of
+  /// time. Does nothing if this region owns a buffer or the platform has no
+  /// support for such hints.
+  void will_need(size_t offset, size_t len) const noexcept;
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Maps the file at `path` read-only into memory and advises the operating
+  /// system to expect sequential access.
+  static expected<intrusive_ptr<mapped_file>> open(const std::string& path);
+
+private:
+  mapped_file() noexcept;
+
+  /// Points to the first byte of the region.
+  const byte* data_;
+
+  /// Stores the size of the region.
+  size_t size_;
+
+  /// Points to the start of the mapping or is `nullptr` for buffers.
+  void* mapping_;
+
+  /// Stores the content for regions that do not map a file.
+  byte_buffer buf_;
+};
+
+/// @relates mapped_file
+using mapped_file_ptr = intrusive_ptr<mapped_file>;
+
+} // namespace caf
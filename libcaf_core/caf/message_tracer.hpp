@@ -0,0 +1,176 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "caf/actor_profiler.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/type_id_list.hpp"
+
+namespace caf {
+
+/// An @ref actor_profiler that records message flows as a flight recorder.
+/// Each thread writes send, enqueue, dequeue and processing-end events into
+/// its own ring buffer that keeps only the most recent events. Users can write
+/// the recorded events at any time in the Chrome Trace Event format, which the
+/// Chrome tracing UI (`chrome://tracing`) as well as the Perfetto UI display
+/// with flow arrows between sender and receiver.
+///
+/// The tracer identifies messages by the address of their mailbox element.
+/// Hence, flow arrows only connect actors on the same node.
+/// @note Actor systems only call profilers when building CAF with
+///       `CAF_ENABLE_ACTOR_PROFILER`.
+/// @experimental
+class CAF_CORE_EXPORT message_tracer : public actor_profiler {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Configures how many events each thread keeps per default.
+  static constexpr size_t default_buffer_size = 4096;
+
+  // -- member types -----------------------------------------------------------
+
+  /// Identifies the step of a message flow.
+  enum class event_type : uint8_t {
+    /// An actor sends a message.
+    send,
+    /// A message arrives in the mailbox of the receiver.
+    enqueue,
+    /// The receiver takes a message from its mailbox and starts processing it.
+    dequeue,
+    /// The receiver finished processing a message.
+    processing_end,
+  };
+
+  /// A single entry in the ring buffer of a thread.
+  struct event {
+    /// Identifies the step of the message flow.
+    event_type type;
+
+    /// Identifies the thread that recorded this event. The tracer assigns
+    /// consecutive numbers to threads, starting at 1.
+    uint32_t thread;
+
+    /// Stores the time of this event in nanoseconds since the construction of
+    /// the tracer.
+    int64_t timestamp;
+
+    /// Identifies the message. Events of the same message have the same ID.
+    /// Processing-end events have no ID.
+    uint64_t flow;
+
+    /// Stores the ID of the sender (send), the receiver (enqueue and dequeue)
+    /// or the current actor (processing-end).
+    actor_id aid;
+
+    /// Stores the name of the actor. Points to the string returned by
+    /// `local_actor::name`.
+    const char* name;
+
+    /// Stores the types of the message content.
+    type_id_list types = make_type_id_list();
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit message_tracer(size_t buffer_size = default_buffer_size);
+
+  ~message_tracer() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns how many events each thread keeps at most.
+  size_t buffer_size() const noexcept {
+    return buffer_size_;
+  }
+
+  /// Returns a copy of the events from all threads, ordered by time.
+  /// @thread-safe
+  std::vector<event> events();
+
+  // -- export -----------------------------------------------------------------
+
+  /// Writes all recorded events in the Chrome Trace Event (JSON) format.
+  /// @thread-safe
+  void write_chrome_trace(std::ostream& out);
+
+  /// Discards all recorded events.
+  /// @thread-safe
+  void clear();
+
+  // -- overrides --------------------------------------------------------------
+
+  void add_actor(const local_actor& self, const local_actor* parent) override;
+
+  void remove_actor(const local_actor& self) override;
+
+  void before_processing(const local_actor& self,
+                         const mailbox_element& element) override;
+
+  void after_processing(const local_actor& self,
+                        invoke_message_result result) override;
+
+  void before_sending(const local_actor& self,
+                      mailbox_element& element) override;
+
+  void before_sending_scheduled(const local_actor& self,
+                                actor_clock::time_point timeout,
+                                mailbox_element& element) override;
+
+  void before_enqueue(const local_actor& self,
+                      const mailbox_element& element) override;
+
+private:
+  /// Stores the most recent events of a single thread.
+  struct thread_buffer;
+
+  using thread_buffer_ptr = std::shared_ptr<thread_buffer>;
+
+  /// Returns the buffer of the calling thread. Creates the buffer on first use.
+  thread_buffer& local_buffer();
+
+  /// Adds an event to the buffer of the calling thread.
+  void record(event_type type, const local_actor& self,
+              const mailbox_element* element);
+
+  // Configures how many events each thread keeps at most.
+  size_t buffer_size_;
+
+  // Identifies this tracer in the thread-local buffer caches.
+  uint64_t id_;
+
+  // Stores the time of construction as reference point for all timestamps.
+  std::chrono::steady_clock::time_point t0_;
+
+  // Guards `buffers_`.
+  std::mutex buffers_mx_;
+
+  // Stores the buffers of all threads that recorded at least one event.
+  std::vector<thread_buffer_ptr> buffers_;
+};
+
+} // namespace caf
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "caf/logger.hpp"
+
+namespace caf {
+
+/// Restores the original order of elements that arrive out of order, e.g., at
+/// a sink that merges the output of several partitions. Each element carries a
+/// sequence number assigned by the source. The merge passes elements to a
+/// consumer in ascending order without gaps and buffers all elements that
+/// arrive ahead of their predecessors.
+/// @note Each sequence number must arrive exactly once. Hence, workers between
+///       source and merge must produce exactly one output per input. The merge
+///       drops duplicates, e.g., replays after rebinding a worker.
+template <class T>
+class ordered_merge {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using sequence_number = uint64_t;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit ordered_merge(sequence_number first = 0) : next_(first) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the sequence number of the next element for the consumer.
+  sequence_number next() const noexcept {
+    return next_;
+  }
+
+  /// Returns the number of elements that wait for their predecessors.
+  size_t pending() const noexcept {
+    return pending_.size();
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `x` with sequence number `seq` and calls `f` for all elements that
+  /// are now in order.
+  /// @returns `false` if the merge dropped `x`, because it already received an
+  ///          element with sequence number `seq`, `true` otherwise.
+  template <class F>
+  bool push(sequence_number seq, T x, F&& f) {
+    if (seq < next_) {
+      CAF_LOG_DEBUG("drop stale element:" << CAF_ARG(seq) << CAF_ARG(next_));
+      return false;
+    }
+    if (seq != next_) {
+      if (!pending_.emplace(seq, std::move(x)).second) {
+        CAF_LOG_DEBUG("drop duplicate element:" << CAF_ARG(seq));
+        return false;
+      }
+      return true;
+    }
+    f(std::move(x));
+    ++next_;
+    auto i = pending_.begin();
+    while (i != pending_.end() && i->first == next_) {
+      f(std::move(i->second));
+      ++next_;
+      i = pending_.erase(i);
+    }
+    return true;
+  }
+
+private:
+  sequence_number next_;
+
+  std::map<sequence_number, T> pending_;
+};
+
+} // namespace caf
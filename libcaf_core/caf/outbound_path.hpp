@@ -33,6 +33,8 @@
 #include "caf/stream_aborter.hpp"
 #include "caf/stream_slot.hpp"
 #include "caf/system_messages.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/timestamp.hpp"
 
 namespace caf {
 
@@ -62,6 +64,10 @@ public:
 
   ~outbound_path();
 
+  outbound_path(const outbound_path&) = delete;
+
+  outbound_path& operator=(const outbound_path&) = delete;
+
   // -- downstream communication -----------------------------------------------
 
   /// Sends a `downstream_msg::batch` on this path. Decrements `open_credit` by
@@ -144,6 +150,25 @@ public:
 
   void set_desired_batch_size(int32_t value) noexcept;
 
+  /// Sets a new handle for the sink, e.g., after receiving an `ack_open` from
+  /// a different actor than the original receiver.
+  void rebind(strong_actor_ptr receiver_hdl);
+
+  /// Returns whether the sink is a remote actor and the connection to its node
+  /// has more than `max_pending_bytes` in its send buffer. Always returns
+  /// `false` if `max_pending_bytes` is 0.
+  bool congested(size_t max_pending_bytes) const noexcept;
+
+  /// Adds `amount` to `open_credit` unless the path is congested, in which
+  /// case the path withholds the credit until calling `release_credit`. Starts
+  /// observing the connection of a remote sink if `max_pending_bytes > 0`.
+  void grant_credit(int32_t amount, size_t max_pending_bytes);
+
+  /// Moves withheld credit to `open_credit` unless the path is still
+  /// congested.
+  /// @returns `true` if `open_credit` increased, `false` otherwise.
+  bool release_credit(size_t max_pending_bytes);
+
   // -- member variables -------------------------------------------------------
 
   /// Slot IDs for sender (self) and receiver (hdl).
@@ -158,6 +183,18 @@ public:
   /// Currently available credit on this path.
   int32_t open_credit;
 
+  /// Credit from the sink that this path withholds while the connection to a
+  /// remote sink is congested.
+  int32_t withheld_credit;
+
+  /// Points to `hdl` if the sink runs on another node or is `nullptr` for
+  /// local sinks.
+  actor_proxy* remote_hdl;
+
+  /// Stores whether this path registered itself as observer at `remote_hdl`
+  /// for reading the number of pending Bytes on the connection.
+  bool observes_remote_hdl;
+
   /// Ideal batch size. Configured by the sink.
   int32_t desired_batch_size;
 
@@ -171,6 +208,15 @@ public:
   /// the path when receiving an `upstream_msg::ack_batch` and no pending
   /// batches for this path exist.
   bool closing;
+
+  /// Samples how long the path waits for new credit after running out of
+  /// credit. Optional, i.e., may be `nullptr`.
+  telemetry::dbl_histogram* credit_starvation_time;
+
+  /// Stores when the path ran out of credit if `credit_starvation_time` is
+  /// set and the path did not receive new credit since, or the
+  /// default-constructed timestamp otherwise.
+  timestamp credit_exhausted;
 };
 
 /// @relates outbound_path
@@ -0,0 +1,226 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "caf/actor_cast.hpp"
+#include "caf/actor_control_block.hpp"
+#include "caf/buffered_downstream_manager.hpp"
+#include "caf/detail/algorithms.hpp"
+#include "caf/detail/unordered_flat_map.hpp"
+#include "caf/logger.hpp"
+#include "caf/make_message.hpp"
+#include "caf/message_id.hpp"
+#include "caf/outbound_path.hpp"
+#include "caf/response_promise.hpp"
+#include "caf/stream.hpp"
+
+namespace caf {
+
+/// Distributes elements to exactly one of its paths by hashing them with
+/// `Hash`. Elements with equal hash values always go to the same path as long
+/// as the set of open paths stays the same. Hence, `Hash` usually hashes only
+/// the key of an element.
+///
+/// Paths receive their partition index in the order of their creation. Closing
+/// a path re-distributes its partition among the remaining paths.
+template <class T, class Hash = std::hash<T>>
+class partition_downstream_manager : public buffered_downstream_manager<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Base type.
+  using super = buffered_downstream_manager<T>;
+
+  /// Type of `paths_`.
+  using typename super::map_type;
+
+  /// Unique pointer to an outbound path.
+  using typename super::unique_path_ptr;
+
+  /// Function object for computing the partition of an element.
+  using hash_type = Hash;
+
+  /// Buffer for elements that wait for credit on a path.
+  using path_buffer = std::vector<T>;
+
+  /// Maps slot IDs to caches.
+  using state_map_type = detail::unordered_flat_map<stream_slot, path_buffer>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  partition_downstream_manager(stream_manager* parent)
+    : super(parent, type_id_v<T>) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t buffered() const noexcept override {
+    // Elements in the central buffer may end up at any path. Hence, we add the
+    // largest path buffer to reflect the current worst case.
+    size_t max_path_buf = 0;
+    for (auto& kvp : state_map_)
+      max_path_buf = std::max(max_path_buf, kvp.second.size());
+    return this->buf_.size() + max_path_buf;
+  }
+
+  size_t buffered(stream_slot slot) const noexcept override {
+    auto i = state_map_.find(slot);
+    return i != state_map_.end() ? i->second.size() : 0u;
+  }
+
+  /// Returns the path buffers for all paths.
+  state_map_type& states() {
+    return state_map_;
+  }
+
+  /// Returns the path buffers for all paths.
+  const state_map_type& states() const {
+    return state_map_;
+  }
+
+  /// Returns the function object for computing partitions.
+  hash_type& hasher() {
+    return hash_;
+  }
+
+  /// Returns the function object for computing partitions.
+  const hash_type& hasher() const {
+    return hash_;
+  }
+
+  // -- path management --------------------------------------------------------
+
+  /// Adds a new partition to the stream by routing the handshake through
+  /// `worker` to `merge`. The worker usually attaches a stream stage for
+  /// processing its partition and the merge actor collects the results of all
+  /// workers.
+  /// @returns The slot of the new outbound path.
+  template <class Worker, class Merge>
+  stream_slot add_partition(const Worker& worker, const Merge& merge) {
+    auto self = this->self();
+    // The forwarding stack stores the next stage at the back.
+    response_promise::forwarding_stack stages{
+      actor_cast<strong_actor_ptr>(merge),
+      actor_cast<strong_actor_ptr>(worker)};
+    response_promise rp{self->ctrl(), self->ctrl(), std::move(stages),
+                        make_message_id()};
+    return this->parent()->add_unchecked_outbound_path_impl(
+      rp, make_message(stream<T>{}));
+  }
+
+  // -- overridden functions ---------------------------------------------------
+
+  bool insert_path(unique_path_ptr ptr) override {
+    CAF_LOG_TRACE(CAF_ARG(ptr));
+    // Make sure state_map_ and paths_ are always equally sorted, otherwise
+    // we'll run into UB when calling `zip_foreach`.
+    CAF_ASSERT(state_map_.size() == this->paths_.size());
+    auto slot = ptr->slots.sender;
+    if (!super::insert_path(std::move(ptr))) {
+      CAF_LOG_DEBUG("unable to insert path at slot" << slot);
+      return false;
+    }
+    if (!state_map_.emplace(slot, path_buffer{}).second) {
+      CAF_LOG_DEBUG("unable to add state for slot" << slot);
+      super::remove_path(slot, none, true);
+      return false;
+    }
+    return true;
+  }
+
+  void emit_batches() override {
+    CAF_LOG_TRACE(CAF_ARG2("buffered", this->buffered())
+                  << CAF_ARG2("paths", this->paths_.size()));
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    CAF_LOG_TRACE(CAF_ARG2("buffered", this->buffered())
+                  << CAF_ARG2("paths", this->paths_.size()));
+    emit_batches_impl(true);
+  }
+
+protected:
+  void about_to_erase(outbound_path* ptr, bool silent, error* reason) override {
+    CAF_ASSERT(ptr != nullptr);
+    CAF_LOG_TRACE(CAF_ARG2("slot", ptr->slots.sender)
+                  << CAF_ARG(silent) << CAF_ARG(reason));
+    state_map_.erase(ptr->slots.sender);
+    super::about_to_erase(ptr, silent, reason);
+  }
+
+private:
+  void emit_batches_impl(bool force_underfull) {
+    CAF_ASSERT(this->paths_.size() == state_map_.size());
+    if (this->paths_.empty())
+      return;
+    // Collect the buffers of all open paths and calculate how many more
+    // elements we can distribute at the most. Since we cannot know in advance
+    // which path receives an element, we use the minimum over all paths.
+    targets_.clear();
+    auto chunk_size = std::numeric_limits<size_t>::max();
+    auto f = [&](typename map_type::value_type& x,
+                 typename state_map_type::value_type& y) {
+      if (x.second->closing)
+        return;
+      targets_.emplace_back(&y.second);
+      auto credit = static_cast<size_t>(x.second->open_credit);
+      auto cache_size = y.second.size();
+      chunk_size = std::min(chunk_size,
+                            credit > cache_size ? credit - cache_size : 0u);
+    };
+    detail::zip_foreach(f, this->paths_.container(), state_map_.container());
+    if (!targets_.empty() && chunk_size > 0) {
+      auto chunk = this->get_chunk(chunk_size);
+      auto n = targets_.size();
+      for (auto& x : chunk)
+        targets_[hash_(x) % n]->emplace_back(std::move(x));
+    }
+    size_t shipped = 0;
+    auto g = [&](typename map_type::value_type& x,
+                 typename state_map_type::value_type& y) {
+      auto cache_size = y.second.size();
+      // Always force batches on closing paths.
+      x.second->emit_batches(this->self(), y.second,
+                             force_underfull || x.second->closing);
+      shipped += cache_size - y.second.size();
+    };
+    detail::zip_foreach(g, this->paths_.container(), state_map_.container());
+    if (shipped > 0) {
+      this->shipped_messages(shipped);
+      this->last_send_ = this->self()->now();
+    }
+  }
+
+  state_map_type state_map_;
+
+  hash_type hash_;
+
+  /// Caches pointers to the buffers of all open paths.
+  std::vector<path_buffer*> targets_;
+};
+
+} // namespace caf
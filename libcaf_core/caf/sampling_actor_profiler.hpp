@@ -0,0 +1,102 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+
+#include "caf/actor_profiler.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// An @ref actor_profiler that measures one out of `sample_rate` messages on
+/// each thread and aggregates the results per actor type (label `name`) and
+/// message type (label `message`) in the metric registry of the actor system:
+///
+/// - `caf.actor.profiler.processing-time`: time an actor needs to process a
+///   sampled message.
+/// - `caf.actor.profiler.mailbox-time`: time a sampled message waited in the
+///   mailbox before processing.
+/// - `caf.actor.profiler.fan-out`: number of messages an actor sends while
+///   processing a sampled message.
+///
+/// The profiler creates its metric families when sampling the first message.
+/// Hence, each instance may only serve a single actor system. For measuring the
+/// mailbox time, the profiler stamps all outgoing messages with the current
+/// time.
+/// @note Actor systems only call profilers when building CAF with
+///       `CAF_ENABLE_ACTOR_PROFILER`.
+/// @experimental
+class CAF_CORE_EXPORT sampling_actor_profiler : public actor_profiler {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Measures one out of this many messages per default.
+  static constexpr size_t default_sample_rate = 64;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit sampling_actor_profiler(size_t sample_rate = default_sample_rate);
+
+  ~sampling_actor_profiler() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns how many messages a thread processes per sampled message.
+  size_t sample_rate() const noexcept {
+    return sample_rate_;
+  }
+
+  // -- overrides --------------------------------------------------------------
+
+  void add_actor(const local_actor& self, const local_actor* parent) override;
+
+  void remove_actor(const local_actor& self) override;
+
+  void before_processing(const local_actor& self,
+                         const mailbox_element& element) override;
+
+  void after_processing(const local_actor& self,
+                        invoke_message_result result) override;
+
+  void before_sending(const local_actor& self,
+                      mailbox_element& element) override;
+
+  void before_sending_scheduled(const local_actor& self,
+                                actor_clock::time_point timeout,
+                                mailbox_element& element) override;
+
+private:
+  /// Creates the metric families in the registry of the system of `self` once.
+  void init_families(const local_actor& self);
+
+  size_t sample_rate_;
+
+  std::once_flag families_initialized_;
+
+  telemetry::dbl_histogram_family* processing_time_ = nullptr;
+
+  telemetry::dbl_histogram_family* mailbox_time_ = nullptr;
+
+  telemetry::int_histogram_family* fan_out_ = nullptr;
+};
+
+} // namespace caf
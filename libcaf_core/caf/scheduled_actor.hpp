@@ -24,6 +24,7 @@
 #  include <exception>
 #endif // CAF_ENABLE_EXCEPTIONS
 
+#include <atomic>
 #include <forward_list>
 #include <map>
 #include <type_traits>
@@ -58,6 +59,7 @@
 #include "caf/response_handle.hpp"
 #include "caf/sec.hpp"
 #include "caf/stream_manager.hpp"
+#include "caf/telemetry/allocation_counter.hpp"
 #include "caf/telemetry/timer.hpp"
 
 namespace caf {
@@ -290,6 +292,14 @@ public:
     return pending_stream_managers_;
   }
 
+  /// Returns the number of messages in the mailbox as counted for the mailbox
+  /// sampler. Unlike `mailbox().size()`, other threads may safely call this
+  /// function. Always returns 0 if the mailbox sampler is disabled.
+  size_t sampled_mailbox_size() const noexcept {
+    auto result = sampled_mailbox_size_.load(std::memory_order_relaxed);
+    return result > 0 ? static_cast<size_t>(result) : 0;
+  }
+
   // -- actor metrics ----------------------------------------------------------
 
   inbound_stream_metrics_t inbound_stream_metrics(type_id_t type);
@@ -409,7 +419,9 @@ public:
   /// Returns whether `timeout_id` is currently active.
   bool is_active_receive_timeout(uint64_t tid) const;
 
-  /// Requests a new timeout and returns its ID.
+  /// Requests a new timeout and returns its ID. Returns 0 without requesting
+  /// a timeout if all streams are idle or if the actor already awaits a
+  /// stream timeout at or before `x`.
   uint64_t set_stream_timeout(actor_clock::time_point x);
 
   // -- message processing -----------------------------------------------------
@@ -622,7 +634,8 @@ public:
   invoke_message_result handle_open_stream_msg(mailbox_element& x);
 
   /// Advances credit and batch timeouts and returns the timestamp when to call
-  /// this function again.
+  /// this function again. The timestamp is a multiple of the batch delay in
+  /// order to coalesce stream timeouts of all actors into few clock events.
   actor_clock::time_point advance_streams(actor_clock::time_point now);
 
   // -- properties -------------------------------------------------------------
@@ -658,6 +671,10 @@ protected:
   /// Identifies the timeout messages we are currently waiting for.
   uint64_t timeout_id_;
 
+  /// Stores when the pending stream timeout triggers or `time_point::max()`
+  /// if the actor awaits no stream timeout.
+  actor_clock::time_point stream_timeout_;
+
   /// Stores callbacks for awaited responses.
   std::forward_list<pending_response> awaited_responses_;
 
@@ -702,6 +719,9 @@ protected:
   /// Caches metric objects for outbound stream traffic.
   outbound_stream_metrics_map outbound_stream_metrics_;
 
+  /// Counts the messages in the mailbox while the mailbox sampler is enabled.
+  std::atomic<int64_t> sampled_mailbox_size_{0};
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
@@ -710,15 +730,31 @@ protected:
 private:
   template <class F>
   intrusive::task_result run_with_metrics(mailbox_element& x, F body) {
+    if (getf(is_sampled_flag)) {
+      auto res = run_with_actor_metrics(x, std::move(body));
+      if (res != intrusive::task_result::skip)
+        sampled_mailbox_size_.fetch_sub(1, std::memory_order_relaxed);
+      return res;
+    }
+    return run_with_actor_metrics(x, std::move(body));
+  }
+
+  template <class F>
+  intrusive::task_result run_with_actor_metrics(mailbox_element& x, F body) {
     if (metrics_.mailbox_time) {
       auto t0 = std::chrono::steady_clock::now();
       auto mbox_time = x.seconds_until(t0);
+      auto bytes0 = metrics_.allocated_bytes ? telemetry::allocated_bytes() : 0;
       auto res = body();
       if (res != intrusive::task_result::skip) {
         telemetry::timer::observe(metrics_.processing_time, t0);
         metrics_.mailbox_time->observe(mbox_time);
         metrics_.mailbox_size->dec();
       }
+      // Skipped messages may still allocate memory, e.g., in a guard.
+      if (metrics_.allocated_bytes)
+        metrics_.allocated_bytes->inc(
+          static_cast<int64_t>(telemetry::allocated_bytes() - bytes0));
       return res;
     } else {
       return body();
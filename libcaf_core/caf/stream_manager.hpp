@@ -288,6 +288,10 @@ protected:
 
   virtual void finalize(const error& reason);
 
+  /// Called at the beginning of each `tick`. The default implementation does
+  /// nothing.
+  virtual void advance_time(time_point now);
+
   // -- implementation hooks for sinks -----------------------------------------
 
   /// Called when `in().closed()` changes to `true`. The default
@@ -330,6 +334,10 @@ protected:
   /// before sending underful batches.
   timespan max_batch_delay_;
 
+  /// Stores the maximum number of Bytes in the send buffer of a connection
+  /// before outbound paths withhold credit from remote sinks.
+  size_t max_pending_bytes_;
+
 private:
   void setf(int flag) noexcept {
     auto x = flags_;
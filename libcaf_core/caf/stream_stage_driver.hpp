@@ -22,6 +22,8 @@
 #include <tuple>
 #include <vector>
 
+#include "caf/actor_clock.hpp"
+#include "caf/downstream.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
 
@@ -81,6 +83,26 @@ public:
     return desired;
   }
 
+  /// Called on each stream tick, i.e., at most every
+  /// `caf.stream.max-batch-delay`, while `awaits_tick()` returns `true` or
+  /// the stage has other pending work. Allows drivers to emit elements based
+  /// on time rather than on input.
+  virtual void tick(downstream<output_type>&, actor_clock::time_point) {
+    // nop
+  }
+
+  /// Returns whether the driver needs further calls to `tick` even when the
+  /// stage has no pending input or output.
+  virtual bool awaits_tick() const noexcept {
+    return false;
+  }
+
+  /// Called after the last inbound path closed. Allows drivers to emit
+  /// buffered state before the stage shuts down.
+  virtual void inputs_closed(downstream<output_type>&) {
+    // nop
+  }
+
 protected:
   DownstreamManager& out_;
 };
@@ -0,0 +1,40 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::telemetry {
+
+/// Adds `bytes` to the allocation counter of the calling thread.
+///
+/// CAF has no means to observe memory allocations on its own. Applications
+/// that enable allocation accounting for actors (see
+/// `caf.metrics-filters.actors.accounting`) call this function from a custom
+/// allocator or from a replacement of the global `operator new`.
+CAF_CORE_EXPORT void count_allocation(size_t bytes) noexcept;
+
+/// Returns the sum of all values that the calling thread has passed to
+/// `count_allocation`.
+CAF_CORE_EXPORT uint64_t allocated_bytes() noexcept;
+
+} // namespace caf::telemetry
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <unordered_map>
 #include <vector>
@@ -25,11 +26,16 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/string_view.hpp"
+#include "caf/telemetry/metric_type.hpp"
 
 namespace caf::telemetry::collector {
 
 /// Collects system metrics and exports them to the text-based Prometheus
 /// format. For a documentation of the format, see: https://git.io/fjgDD.
+/// Optionally, the collector generates OpenMetrics instead.
+///
+/// The collector caches the generated text per metric family and only renders
+/// families again if their values have changed since the last run.
 class CAF_CORE_EXPORT prometheus {
 public:
   // -- member types -----------------------------------------------------------
@@ -39,6 +45,14 @@ public:
   /// have to maintain a null-terminator.
   using char_buffer = std::vector<char>;
 
+  /// Selects the text format of the output.
+  enum class format {
+    /// The text-based exposition format of Prometheus (version 0.0.4).
+    prometheus,
+    /// The OpenMetrics text format (version 1.0.0).
+    openmetrics,
+  };
+
   // -- properties -------------------------------------------------------------
 
   /// Returns the minimum scrape interval, i.e., the minimum time that needs to
@@ -52,6 +66,18 @@ public:
     min_scrape_interval_ = value;
   }
 
+  /// Returns the format of the generated text.
+  format output_format() const noexcept {
+    return format_;
+  }
+
+  /// Sets the format of the generated text. Drops all cached output.
+  void output_format(format value);
+
+  /// Returns the value for the HTTP header `Content-Type` that matches the
+  /// output format.
+  string_view content_type() const noexcept;
+
   // -- collect API ------------------------------------------------------------
 
   /// Applies this collector to the registry, filling the character buffer while
@@ -88,32 +114,86 @@ public:
                   const int_histogram* val);
 
 private:
+  /// Caches the generated text for a single metric family.
+  struct family_cache {
+    /// Stores the type of all instances. Sharded metrics appear as their
+    /// regular counterpart.
+    metric_type type;
+
+    /// Stores the instances of the family in the order of the last run.
+    std::vector<const metric*> instances;
+
+    /// Stores the values of all instances of the last run. Histograms add one
+    /// cumulative count per bucket plus the sum. Stores the bits of `double`
+    /// values for comparing them without special cases for NaN.
+    std::vector<uint64_t> values;
+
+    /// Stores the text for `values` without timestamps.
+    char_buffer text;
+
+    /// Signals that at least one instance or value differs from the last run.
+    bool dirty = true;
+
+    /// Points to the next position in `instances` while collecting.
+    size_t instance_pos = 0;
+
+    /// Points to the next position in `values` while collecting.
+    size_t value_pos = 0;
+  };
+
   /// Sets `current_family_` if not pointing to `family` already. When setting
-  /// the member variable, also writes meta information to `buf_`.
-  void set_current_family(const metric_family* family,
-                          string_view prometheus_type);
+  /// the member variable, also finalizes the previous family.
+  void set_current_family(const metric_family* family, metric_type type);
+
+  /// Adds an instance of the current family.
+  void add_instance(const metric* instance);
+
+  /// Adds a value of the current instance.
+  void add_value(uint64_t bits);
+
+  /// Renders the current family if necessary and copies its text to `buf_`.
+  void finalize_current_family();
+
+  /// Renders the text for all instances of `family`.
+  void render(const metric_family* family, family_cache& entry);
 
   template <class ValueType>
   void append_histogram(const metric_family* family, const metric* instance,
                         const histogram<ValueType>* val);
 
+  /// Returns the prefixes for all lines of `instance`, i.e., the name of the
+  /// metric plus labels. Histograms have one line per bucket plus one line for
+  /// the sum and one line for the count.
+  const std::vector<char_buffer>& line_prefixes(const metric_family* family,
+                                                const metric* instance,
+                                                metric_type type);
+
   /// Stores the generated text output.
   char_buffer buf_;
 
   /// Current timestamp.
   time_t now_ = 0;
 
-  /// Caches type information and help text for a metric.
-  std::unordered_map<const metric_family*, char_buffer> meta_info_;
+  /// Stores the rendered timestamp for the current run.
+  char_buffer timestamp_;
+
+  /// Caches the generated text per metric family.
+  std::unordered_map<const metric_family*, family_cache> families_;
 
-  /// Caches type information and help text for a metric.
+  /// Caches the line prefixes per metric instance.
   std::unordered_map<const metric*, std::vector<char_buffer>> virtual_metrics_;
 
   /// Caches which metric family is currently collected.
   const metric_family* current_family_ = nullptr;
 
+  /// Points to the cache entry for `current_family_`.
+  family_cache* current_entry_ = nullptr;
+
   /// Minimum time between re-iterating the registry.
   time_t min_scrape_interval_ = 0;
+
+  /// Selects the output format.
+  format format_ = format::prometheus;
 };
 
 } // namespace caf::telemetry::collector
@@ -19,6 +19,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 
 #include "caf/config.hpp"
@@ -84,20 +86,44 @@ public:
   /// Increments the bucket where the observed value falls into and increments
   /// the sum of all observed values.
   void observe(value_type value) {
-    // The last bucket has an upper bound of +inf or int_max, so we'll always
-    // find a bucket and increment the counters.
-    for (size_t index = 0;; ++index) {
-      auto& [upper_bound, count] = buckets_[index];
-      if (value <= upper_bound) {
-        count.inc();
-        sum_.inc(value);
-        return;
-      }
-    }
+    buckets_[bucket_index(value)].count.inc();
+    sum_.inc(value);
   }
 
   // -- observers --------------------------------------------------------------
 
+  /// Returns the index of the bucket where `value` falls into.
+  size_t bucket_index(value_type value) const noexcept {
+    switch (lookup_) {
+      case lookup_mode::power_of_two:
+        if constexpr (std::is_integral<value_type>::value) {
+          // Bucket i has the upper bound 2^(min_exponent_ + i), i.e., the
+          // index follows from the number of bits we need for `value - 1`.
+          if (value <= buckets_[0].upper_bound)
+            return 0;
+          auto index = bit_width(static_cast<uint64_t>(value - 1))
+                       - min_exponent_;
+          return std::min(index, num_buckets_ - 1);
+        }
+        [[fallthrough]];
+      case lookup_mode::binary_search: {
+        // The last bucket has an upper bound of +inf or int_max, so we'll
+        // always find a bucket.
+        auto below = [value](const bucket_type& x) {
+          return x.upper_bound < value;
+        };
+        auto first = buckets_;
+        auto last = buckets_ + (num_buckets_ - 1);
+        auto i = std::partition_point(first, last, below);
+        return static_cast<size_t>(i - first);
+      }
+      default:
+        for (size_t index = 0;; ++index)
+          if (value <= buckets_[index].upper_bound)
+            return index;
+    }
+  }
+
   /// Returns the ``counter`` objects with the configured upper bounds.
   span<const bucket_type> buckets() const noexcept {
     return {buckets_, num_buckets_};
@@ -109,6 +135,50 @@ public:
   }
 
 private:
+  /// Selects the algorithm for finding the bucket of an observed value.
+  enum class lookup_mode {
+    /// Scans all buckets in order. Fastest for few buckets.
+    linear_scan,
+    /// Performs a binary search over the upper bounds.
+    binary_search,
+    /// Computes the index in O(1) for consecutive powers of two.
+    power_of_two,
+  };
+
+  /// Buckets up to this number use a linear scan.
+  static constexpr size_t max_linear_scan_buckets = 8;
+
+  static size_t bit_width(uint64_t x) noexcept {
+#if defined(CAF_GCC) || defined(CAF_CLANG)
+    return x == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(x));
+#else
+    size_t result = 0;
+    for (; x != 0; x >>= 1)
+      ++result;
+    return result;
+#endif
+  }
+
+  /// Checks whether `upper_bounds` are consecutive powers of two and stores
+  /// the smallest exponent if so.
+  bool is_power_of_two_sequence(span<const value_type> upper_bounds) {
+    if constexpr (std::is_integral<value_type>::value) {
+      auto first = upper_bounds[0];
+      if (first <= 0 || (first & (first - 1)) != 0)
+        return false;
+      for (size_t index = 1; index < upper_bounds.size(); ++index) {
+        auto prev = upper_bounds[index - 1];
+        if (prev > std::numeric_limits<value_type>::max() / 2
+            || upper_bounds[index] != prev * 2)
+          return false;
+      }
+      min_exponent_ = bit_width(static_cast<uint64_t>(first)) - 1;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
   void init_buckets(span<const value_type> upper_bounds) {
     CAF_ASSERT(std::is_sorted(upper_bounds.begin(), upper_bounds.end()));
     using limits = std::numeric_limits<value_type>;
@@ -121,6 +191,12 @@ private:
       buckets_[index].upper_bound = limits::infinity();
     else
       buckets_[index].upper_bound = limits::max();
+    if (!upper_bounds.empty() && is_power_of_two_sequence(upper_bounds))
+      lookup_ = lookup_mode::power_of_two;
+    else if (num_buckets_ > max_linear_scan_buckets)
+      lookup_ = lookup_mode::binary_search;
+    else
+      lookup_ = lookup_mode::linear_scan;
   }
 
   bool init_buckets_from_config(span<const label> labels, const settings* cfg) {
@@ -144,6 +220,8 @@ private:
 
   size_t num_buckets_;
   bucket_type* buckets_;
+  lookup_mode lookup_;
+  size_t min_exponent_ = 0;
   gauge_type sum_;
 };
 
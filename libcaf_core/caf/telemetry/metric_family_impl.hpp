@@ -23,6 +23,9 @@
 #include <memory>
 #include <mutex>
 
+#include "caf/detail/read_mostly_index.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/hash/fnv.hpp"
 #include "caf/span.hpp"
 #include "caf/string_view.hpp"
 #include "caf/telemetry/label.hpp"
@@ -67,25 +70,35 @@ public:
     // nop
   }
 
+  /// Returns the metric instance for the given label values. Creates the
+  /// instance lazily if necessary. Looking up existing instances never blocks.
+  /// @note The returned pointer remains valid for the lifetime of the family.
+  ///       Hot code paths should resolve their instances once and then store
+  ///       the pointer instead of calling this function for each event.
   Type* get_or_add(span<const label_view> labels) {
-    auto has_label_values = [labels](const auto& metric_ptr) {
-      const auto& metric_labels = metric_ptr->labels();
+    auto has_label_values = [labels](const impl_type& metric) {
+      const auto& metric_labels = metric.labels();
       return std::is_permutation(metric_labels.begin(), metric_labels.end(),
                                  labels.begin(), labels.end());
     };
+    auto hash = hash_labels(labels);
+    if (auto ptr = index_.find(hash, has_label_values))
+      return std::addressof(ptr->impl());
     std::unique_lock<std::mutex> guard{mx_};
-    auto m = std::find_if(metrics_.begin(), metrics_.end(), has_label_values);
-    if (m == metrics_.end()) {
-      std::vector<label> cpy{labels.begin(), labels.end()};
-      std::sort(cpy.begin(), cpy.end());
-      std::unique_ptr<impl_type> ptr;
-      if constexpr (std::is_same<extra_setting_type, unit_t>::value)
-        ptr.reset(new impl_type(std::move(cpy)));
-      else
-        ptr.reset(new impl_type(std::move(cpy), config_, extra_setting_));
-      m = metrics_.emplace(m, std::move(ptr));
-    }
-    return std::addressof(m->get()->impl());
+    // Another thread may have added the instance since our lookup.
+    if (auto ptr = index_.find(hash, has_label_values))
+      return std::addressof(ptr->impl());
+    std::vector<label> cpy{labels.begin(), labels.end()};
+    std::sort(cpy.begin(), cpy.end());
+    std::unique_ptr<impl_type> ptr;
+    if constexpr (std::is_same<extra_setting_type, unit_t>::value)
+      ptr.reset(new impl_type(std::move(cpy)));
+    else
+      ptr.reset(new impl_type(std::move(cpy), config_, extra_setting_));
+    auto result = ptr.get();
+    metrics_.emplace_back(std::move(ptr));
+    index_.insert(hash, result);
+    return std::addressof(result->impl());
   }
 
   Type* get_or_add(std::initializer_list<label_view> labels) {
@@ -105,15 +118,32 @@ public:
   template <class Collector>
   void collect(Collector& collector) const {
     std::unique_lock<std::mutex> guard{mx_};
-    for (auto& ptr : metrics_)
-      collector(this, ptr.get(), std::addressof(ptr->impl()));
+    for (auto& ptr : metrics_) {
+      if constexpr (detail::has_snapshot_type_alias<Type>::value) {
+        // Sharded metrics appear as their regular counterpart to collectors.
+        auto snapshot = ptr->impl().snapshot();
+        collector(this, ptr.get(), std::addressof(snapshot));
+      } else {
+        collector(this, ptr.get(), std::addressof(ptr->impl()));
+      }
+    }
   }
 
 private:
+  /// Computes a hash value for a set of labels that ignores their order.
+  template <class Label>
+  static size_t hash_labels(span<const Label> labels) noexcept {
+    size_t result = 0;
+    for (const auto& lbl : labels)
+      result += hash::fnv<size_t>::compute(lbl.name(), lbl.value());
+    return result;
+  }
+
   const settings* config_;
   extra_setting_type extra_setting_;
   mutable std::mutex mx_;
   std::vector<std::unique_ptr<impl_type>> metrics_;
+  detail::read_mostly_index<impl_type> index_;
 };
 
 } // namespace caf::telemetry
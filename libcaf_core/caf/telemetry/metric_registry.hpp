@@ -25,6 +25,7 @@
 #include <mutex>
 
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/read_mostly_index.hpp"
 #include "caf/fwd.hpp"
 #include "caf/raise_error.hpp"
 #include "caf/settings.hpp"
@@ -33,6 +34,8 @@
 #include "caf/telemetry/gauge.hpp"
 #include "caf/telemetry/histogram.hpp"
 #include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/sharded_counter.hpp"
+#include "caf/telemetry/sharded_gauge.hpp"
 
 namespace caf::telemetry {
 
@@ -84,8 +87,8 @@ public:
                bool is_sum = false) {
     using gauge_type = gauge<ValueType>;
     using family_type = metric_family_impl<gauge_type>;
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
       assert_properties(ptr, gauge_type::runtime_type, labels, unit, is_sum);
       return static_cast<family_type*>(ptr);
     }
@@ -94,7 +97,7 @@ public:
                                              to_string(helptext),
                                              to_string(unit), is_sum);
     auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
+    add(std::move(ptr));
     return result;
   }
 
@@ -117,8 +120,8 @@ public:
                bool is_sum = false) {
     using gauge_type = gauge<ValueType>;
     using family_type = metric_family_impl<gauge_type>;
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
       assert_properties(ptr, gauge_type::runtime_type, labels, unit, is_sum);
       return static_cast<family_type*>(ptr);
     }
@@ -127,7 +130,7 @@ public:
                                              to_string(helptext),
                                              to_string(unit), is_sum);
     auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
+    add(std::move(ptr));
     return result;
   }
 
@@ -214,8 +217,8 @@ public:
                  string_view unit = "1", bool is_sum = false) {
     using counter_type = counter<ValueType>;
     using family_type = metric_family_impl<counter_type>;
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
       assert_properties(ptr, counter_type::runtime_type, labels, unit, is_sum);
       return static_cast<family_type*>(ptr);
     }
@@ -224,7 +227,7 @@ public:
                                              to_string(helptext),
                                              to_string(unit), is_sum);
     auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
+    add(std::move(ptr));
     return result;
   }
 
@@ -248,8 +251,8 @@ public:
                  string_view unit = "1", bool is_sum = false) {
     using counter_type = counter<ValueType>;
     using family_type = metric_family_impl<counter_type>;
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
       assert_properties(ptr, counter_type::runtime_type, labels, unit, is_sum);
       return static_cast<family_type*>(ptr);
     }
@@ -258,7 +261,7 @@ public:
                                              to_string(helptext),
                                              to_string(unit), is_sum);
     auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
+    add(std::move(ptr));
     return result;
   }
 
@@ -324,6 +327,113 @@ public:
     return fptr->get_or_add({});
   }
 
+  /// Returns a sharded gauge metric family. Sharded gauges behave like regular
+  /// gauges, but spread updates over multiple cells to scale with the number
+  /// of threads that update the same metric concurrently. Collectors receive
+  /// sharded gauges as regular gauges. See `gauge_family` for a description
+  /// of the parameters.
+  template <class ValueType = int64_t>
+  metric_family_impl<sharded_gauge<ValueType>>*
+  sharded_gauge_family(string_view prefix, string_view name,
+                       span_t<string_view> labels, string_view helptext,
+                       string_view unit = "1", bool is_sum = false) {
+    return simple_family<sharded_gauge<ValueType>>(prefix, name, labels,
+                                                   helptext, unit, is_sum);
+  }
+
+  /// @copydoc sharded_gauge_family
+  template <class ValueType = int64_t>
+  metric_family_impl<sharded_gauge<ValueType>>*
+  sharded_gauge_family(string_view prefix, string_view name,
+                       std::initializer_list<string_view> labels,
+                       string_view helptext, string_view unit = "1",
+                       bool is_sum = false) {
+    auto lbl_span = make_span(labels.begin(), labels.size());
+    return sharded_gauge_family<ValueType>(prefix, name, lbl_span, helptext,
+                                           unit, is_sum);
+  }
+
+  /// Returns a sharded gauge. See `gauge_instance` for a description of the
+  /// parameters.
+  template <class ValueType = int64_t>
+  sharded_gauge<ValueType>*
+  sharded_gauge_instance(string_view prefix, string_view name,
+                         std::initializer_list<label_view> labels,
+                         string_view helptext, string_view unit = "1",
+                         bool is_sum = false) {
+    span_t<label_view> lbls{labels.begin(), labels.size()};
+    auto fptr = simple_family<sharded_gauge<ValueType>>(prefix, name, lbls,
+                                                        helptext, unit, is_sum);
+    return fptr->get_or_add(lbls);
+  }
+
+  /// Returns a sharded gauge metric singleton. See `gauge_singleton` for a
+  /// description of the parameters.
+  template <class ValueType = int64_t>
+  sharded_gauge<ValueType>*
+  sharded_gauge_singleton(string_view prefix, string_view name,
+                          string_view helptext, string_view unit = "1",
+                          bool is_sum = false) {
+    span_t<string_view> lbls;
+    auto fptr = sharded_gauge_family<ValueType>(prefix, name, lbls, helptext,
+                                                unit, is_sum);
+    return fptr->get_or_add({});
+  }
+
+  /// Returns a sharded counter metric family. Sharded counters behave like
+  /// regular counters, but spread updates over multiple cells to scale with
+  /// the number of threads that update the same metric concurrently.
+  /// Collectors receive sharded counters as regular counters. See
+  /// `counter_family` for a description of the parameters.
+  template <class ValueType = int64_t>
+  metric_family_impl<sharded_counter<ValueType>>*
+  sharded_counter_family(string_view prefix, string_view name,
+                         span_t<string_view> labels, string_view helptext,
+                         string_view unit = "1", bool is_sum = false) {
+    return simple_family<sharded_counter<ValueType>>(prefix, name, labels,
+                                                     helptext, unit, is_sum);
+  }
+
+  /// @copydoc sharded_counter_family
+  template <class ValueType = int64_t>
+  metric_family_impl<sharded_counter<ValueType>>*
+  sharded_counter_family(string_view prefix, string_view name,
+                         std::initializer_list<string_view> labels,
+                         string_view helptext, string_view unit = "1",
+                         bool is_sum = false) {
+    auto lbl_span = make_span(labels.begin(), labels.size());
+    return sharded_counter_family<ValueType>(prefix, name, lbl_span, helptext,
+                                             unit, is_sum);
+  }
+
+  /// Returns a sharded counter. See `counter_instance` for a description of
+  /// the parameters.
+  template <class ValueType = int64_t>
+  sharded_counter<ValueType>*
+  sharded_counter_instance(string_view prefix, string_view name,
+                           std::initializer_list<label_view> labels,
+                           string_view helptext, string_view unit = "1",
+                           bool is_sum = false) {
+    span_t<label_view> lbls{labels.begin(), labels.size()};
+    auto fptr = simple_family<sharded_counter<ValueType>>(prefix, name, lbls,
+                                                          helptext, unit,
+                                                          is_sum);
+    return fptr->get_or_add(lbls);
+  }
+
+  /// Returns a sharded counter metric singleton. See `counter_singleton` for a
+  /// description of the parameters.
+  template <class ValueType = int64_t>
+  sharded_counter<ValueType>*
+  sharded_counter_singleton(string_view prefix, string_view name,
+                            string_view helptext, string_view unit = "1",
+                            bool is_sum = false) {
+    span_t<string_view> lbls;
+    auto fptr = sharded_counter_family<ValueType>(prefix, name, lbls, helptext,
+                                                  unit, is_sum);
+    return fptr->get_or_add({});
+  }
+
   /// Returns a histogram metric family. Creates the family lazily if necessary,
   /// but fails if the full name already belongs to a different family.
   /// @param prefix The prefix (namespace) this family belongs to. Usually the
@@ -355,8 +465,8 @@ public:
     using upper_bounds_list = std::vector<ValueType>;
     if (default_upper_bounds.empty())
       CAF_RAISE_ERROR("at least one bucket must exist in the default settings");
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
       assert_properties(ptr, histogram_type::runtime_type, label_names, unit,
                         is_sum);
       return static_cast<family_type*>(ptr);
@@ -384,7 +494,7 @@ public:
       to_sorted_vec(label_names), to_string(helptext), to_string(unit), is_sum,
       std::move(upper_bounds));
     auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
+    add(std::move(ptr));
     return result;
   }
 
@@ -486,13 +596,43 @@ public:
   }
 
 private:
+  /// Returns the family for `prefix` and `name` if it exists. Looks up
+  /// existing families without locking `families_mx_`. On a miss, locks
+  /// `guard` and tries again, allowing the caller to add a new family.
+  /// @pre `guard` manages `families_mx_` and does not own the lock.
+  /// @post `guard` owns the lock if the result is `nullptr`.
+  metric_family* fetch(const string_view& prefix, const string_view& name,
+                       std::unique_lock<std::mutex>& guard);
+
+  /// Adds a new family to the registry.
   /// @pre `families_mx_` is locked.
-  metric_family* fetch(const string_view& prefix, const string_view& name);
+  void add(std::unique_ptr<metric_family> ptr);
 
   static std::vector<std::string> to_sorted_vec(span_t<string_view> xs);
 
   static std::vector<std::string> to_sorted_vec(span_t<label_view> xs);
 
+  /// Returns the family for a metric type without extra family settings.
+  /// Creates the family lazily if necessary.
+  template <class Type, class LabelType>
+  metric_family_impl<Type>*
+  simple_family(string_view prefix, string_view name, span<LabelType> labels,
+                string_view helptext, string_view unit, bool is_sum) {
+    using family_type = metric_family_impl<Type>;
+    std::unique_lock<std::mutex> guard{families_mx_, std::defer_lock};
+    if (auto ptr = fetch(prefix, name, guard)) {
+      assert_properties(ptr, Type::runtime_type, labels, unit, is_sum);
+      return static_cast<family_type*>(ptr);
+    }
+    auto ptr = std::make_unique<family_type>(to_string(prefix), to_string(name),
+                                             to_sorted_vec(labels),
+                                             to_string(helptext),
+                                             to_string(unit), is_sum);
+    auto result = ptr.get();
+    add(std::move(ptr));
+    return result;
+  }
+
   template <class F>
   static auto visit_family(F& f, const metric_family* ptr) {
     switch (ptr->type()) {
@@ -506,9 +646,19 @@ private:
         return f(static_cast<const metric_family_impl<int_gauge>*>(ptr));
       case metric_type::dbl_histogram:
         return f(static_cast<const metric_family_impl<dbl_histogram>*>(ptr));
-      default:
-        CAF_ASSERT(ptr->type() == metric_type::int_histogram);
+      case metric_type::int_histogram:
         return f(static_cast<const metric_family_impl<int_histogram>*>(ptr));
+      case metric_type::sharded_dbl_counter:
+        return f(
+          static_cast<const metric_family_impl<sharded_dbl_counter>*>(ptr));
+      case metric_type::sharded_int_counter:
+        return f(
+          static_cast<const metric_family_impl<sharded_int_counter>*>(ptr));
+      case metric_type::sharded_dbl_gauge:
+        return f(static_cast<const metric_family_impl<sharded_dbl_gauge>*>(ptr));
+      default:
+        CAF_ASSERT(ptr->type() == metric_type::sharded_int_gauge);
+        return f(static_cast<const metric_family_impl<sharded_int_gauge>*>(ptr));
     }
   }
 
@@ -522,6 +672,7 @@ private:
 
   mutable std::mutex families_mx_;
   std::vector<std::unique_ptr<metric_family>> families_;
+  detail::read_mostly_index<metric_family> index_;
   const caf::settings* config_;
 };
 
@@ -27,6 +27,10 @@ enum class metric_type : uint8_t {
   int_gauge,
   dbl_histogram,
   int_histogram,
+  sharded_dbl_counter,
+  sharded_int_counter,
+  sharded_dbl_gauge,
+  sharded_int_gauge,
 };
 
 } // namespace caf::telemetry
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+#include "caf/config.hpp"
+#include "caf/fwd.hpp"
+#include "caf/span.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/sharded_gauge.hpp"
+
+namespace caf::telemetry {
+
+/// A counter for values that many threads update concurrently. Collectors see
+/// a sharded counter as a regular counter.
+/// @sa sharded_gauge
+template <class ValueType>
+class sharded_counter {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  using family_setting = unit_t;
+
+  /// The type collectors receive when visiting this metric.
+  using snapshot_type = counter<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr metric_type runtime_type
+    = std::is_same<value_type, double>::value
+        ? metric_type::sharded_dbl_counter
+        : metric_type::sharded_int_counter;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  sharded_counter() noexcept = default;
+
+  explicit sharded_counter(value_type initial_value) noexcept
+    : gauge_(initial_value) {
+    // nop
+  }
+
+  explicit sharded_counter(span<const label>) noexcept {
+    // nop
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Increments the counter by 1.
+  void inc() noexcept {
+    gauge_.inc();
+  }
+
+  /// Increments the counter by `amount`.
+  /// @pre `amount > 0`
+  void inc(value_type amount) noexcept {
+    CAF_ASSERT(amount > 0);
+    gauge_.inc(amount);
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the current value of the counter.
+  value_type value() const noexcept {
+    return gauge_.value();
+  }
+
+  /// Returns a regular counter that holds the current value.
+  snapshot_type snapshot() const noexcept {
+    return snapshot_type{value()};
+  }
+
+private:
+  sharded_gauge<value_type> gauge_;
+};
+
+/// Convenience alias for a sharded counter with value type `double`.
+using sharded_dbl_counter = sharded_counter<double>;
+
+/// Convenience alias for a sharded counter with value type `int64_t`.
+using sharded_int_counter = sharded_counter<int64_t>;
+
+} // namespace caf::telemetry
@@ -0,0 +1,139 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "caf/config.hpp"
+#include "caf/detail/thread_shard.hpp"
+#include "caf/fwd.hpp"
+#include "caf/span.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/metric_type.hpp"
+
+namespace caf::telemetry {
+
+/// A gauge that spreads its value over several cache-line-sized cells to
+/// avoid contention when many threads update the same metric. Each thread
+/// updates only its own cell, while reading the value sums up all cells.
+/// Collectors see a sharded gauge as a regular gauge.
+template <class ValueType>
+class sharded_gauge {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  using family_setting = unit_t;
+
+  /// The type collectors receive when visiting this metric.
+  using snapshot_type = gauge<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr metric_type runtime_type
+    = std::is_same<value_type, double>::value ? metric_type::sharded_dbl_gauge
+                                              : metric_type::sharded_int_gauge;
+
+  /// Number of cells. Must be a power of two.
+  static constexpr size_t num_shards = 16;
+
+  static_assert((num_shards & (num_shards - 1)) == 0,
+                "num_shards must be a power of two");
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  sharded_gauge() noexcept = default;
+
+  explicit sharded_gauge(value_type initial_value) noexcept {
+    cells_[0].value.value(initial_value);
+  }
+
+  explicit sharded_gauge(span<const label>) noexcept {
+    // nop
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Increments the gauge by 1.
+  void inc() noexcept {
+    local().inc();
+  }
+
+  /// Increments the gauge by `amount`.
+  void inc(value_type amount) noexcept {
+    local().inc(amount);
+  }
+
+  /// Decrements the gauge by 1.
+  void dec() noexcept {
+    local().dec();
+  }
+
+  /// Decrements the gauge by `amount`.
+  void dec(value_type amount) noexcept {
+    local().dec(amount);
+  }
+
+  /// Sets the gauge to `x`.
+  /// @warning Not atomic with respect to concurrent updates by other threads.
+  void value(value_type x) noexcept {
+    cells_[0].value.value(x);
+    for (size_t i = 1; i < num_shards; ++i)
+      cells_[i].value.value(0);
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the sum of all cells.
+  value_type value() const noexcept {
+    value_type result = 0;
+    for (auto& cell : cells_)
+      result += cell.value.value();
+    return result;
+  }
+
+  /// Returns a regular gauge that holds the current value.
+  snapshot_type snapshot() const noexcept {
+    return snapshot_type{value()};
+  }
+
+private:
+  struct alignas(CAF_CACHE_LINE_SIZE) cell {
+    gauge<value_type> value;
+  };
+
+  gauge<value_type>& local() noexcept {
+    return cells_[detail::thread_shard() & (num_shards - 1)].value;
+  }
+
+  std::array<cell, num_shards> cells_;
+};
+
+/// Convenience alias for a sharded gauge with value type `double`.
+using sharded_dbl_gauge = sharded_gauge<double>;
+
+/// Convenience alias for a sharded gauge with value type `int64_t`.
+using sharded_int_gauge = sharded_gauge<int64_t>;
+
+} // namespace caf::telemetry
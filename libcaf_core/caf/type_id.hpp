@@ -300,9 +300,11 @@ CAF_BEGIN_TYPE_ID_BLOCK(core_module, 0)
   CAF_ADD_TYPE_ID(core_module, (caf::error))
   CAF_ADD_TYPE_ID(core_module, (caf::exit_msg))
   CAF_ADD_TYPE_ID(core_module, (caf::exit_reason))
+  CAF_ADD_TYPE_ID(core_module, (caf::file_slice))
   CAF_ADD_TYPE_ID(core_module, (caf::group))
   CAF_ADD_TYPE_ID(core_module, (caf::group_down_msg))
   CAF_ADD_TYPE_ID(core_module, (caf::hashed_node_id))
+  CAF_ADD_TYPE_ID(core_module, (caf::hot_actor))
   CAF_ADD_TYPE_ID(core_module, (caf::ipv4_address))
   CAF_ADD_TYPE_ID(core_module, (caf::ipv4_endpoint))
   CAF_ADD_TYPE_ID(core_module, (caf::ipv4_subnet))
@@ -317,6 +319,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(core_module, 0)
   CAF_ADD_TYPE_ID(core_module, (caf::open_stream_msg))
   CAF_ADD_TYPE_ID(core_module, (caf::pec))
   CAF_ADD_TYPE_ID(core_module, (caf::sec))
+  CAF_ADD_TYPE_ID(core_module, (caf::stream<caf::file_slice>) )
   CAF_ADD_TYPE_ID(core_module, (caf::stream_slots))
   CAF_ADD_TYPE_ID(core_module, (caf::strong_actor_ptr))
   CAF_ADD_TYPE_ID(core_module, (caf::timeout_msg))
@@ -333,6 +336,8 @@ CAF_BEGIN_TYPE_ID_BLOCK(core_module, 0)
   CAF_ADD_TYPE_ID(core_module, (std::vector<caf::actor>) )
   CAF_ADD_TYPE_ID(core_module, (std::vector<caf::actor_addr>) )
   CAF_ADD_TYPE_ID(core_module, (std::vector<caf::config_value>) )
+  CAF_ADD_TYPE_ID(core_module, (std::vector<caf::file_slice>) )
+  CAF_ADD_TYPE_ID(core_module, (std::vector<caf::hot_actor>) )
   CAF_ADD_TYPE_ID(core_module, (std::vector<caf::strong_actor_ptr>) )
   CAF_ADD_TYPE_ID(core_module, (std::vector<caf::weak_actor_ptr>) )
   CAF_ADD_TYPE_ID(core_module, (std::vector<std::pair<std::string, message>>) )
@@ -390,7 +395,7 @@ namespace caf::detail {
 
 static constexpr type_id_t io_module_begin = id_block::core_module::end;
 
-static constexpr type_id_t io_module_end = io_module_begin + 19;
+static constexpr type_id_t io_module_end = io_module_begin + 20;
 
 static constexpr type_id_t net_module_begin = io_module_end;
 
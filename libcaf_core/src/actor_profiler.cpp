@@ -24,4 +24,9 @@ actor_profiler::~actor_profiler() {
   // nop
 }
 
+void actor_profiler::before_enqueue(const local_actor&,
+                                    const mailbox_element&) {
+  // nop
+}
+
 } // namespace caf
@@ -28,4 +28,16 @@ actor_proxy::~actor_proxy() {
   // nop
 }
 
+size_t actor_proxy::pending_bytes() const noexcept {
+  return 0;
+}
+
+void actor_proxy::add_pending_bytes_observer() noexcept {
+  // nop
+}
+
+void actor_proxy::remove_pending_bytes_observer() noexcept {
+  // nop
+}
+
 } // namespace caf
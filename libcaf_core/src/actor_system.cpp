@@ -23,6 +23,7 @@
 #include "caf/actor.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/mailbox_sampler.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/policy/work_sharing.hpp"
@@ -164,6 +165,29 @@ behavior spawn_serv_impl(stateful_actor<spawn_serv_state>* self) {
   };
 }
 
+// -- mailbox sampler ----------------------------------------------------------
+
+// The mailbox sampler actor periodically walks all scheduled actors and keeps
+// the result of the last run for answering introspection requests, i.e.,
+// `get_atom` messages.
+
+struct mailbox_sampler_state {
+  std::vector<hot_actor> hot_actors;
+  static inline const char* name = "caf.system.mailbox-sampler";
+};
+
+behavior mailbox_sampler_impl(stateful_actor<mailbox_sampler_state>* self,
+                              detail::mailbox_sampler* sampler,
+                              timespan interval) {
+  return {
+    [=](tick_atom) {
+      self->state.hot_actors = sampler->sample();
+      self->delayed_send(self, interval, tick_atom_v);
+    },
+    [=](get_atom) { return self->state.hot_actors; },
+  };
+}
+
 // -- stream server ------------------------------------------------------------
 
 // The stream server acts as a man-in-the-middle for all streams that cross the
@@ -220,10 +244,10 @@ namespace {
 auto make_base_metrics(telemetry::metric_registry& reg) {
   return actor_system::base_metrics_t{
     // Initialize the base metrics.
-    reg.counter_singleton("caf.system", "rejected-messages",
-                          "Number of rejected messages.", "1", true),
-    reg.counter_singleton("caf.system", "processed-messages",
-                          "Number of processed messages.", "1", true),
+    reg.sharded_counter_singleton("caf.system", "rejected-messages",
+                                  "Number of rejected messages.", "1", true),
+    reg.sharded_counter_singleton("caf.system", "processed-messages",
+                                  "Number of processed messages.", "1", true),
     reg.gauge_singleton("caf.system", "running-actors",
                         "Number of currently running actors."),
     reg.gauge_singleton("caf.system", "queued-messages",
@@ -248,6 +272,9 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
     1.,     // 1s
     5.,     // 5s
   }};
+  // Batch sizes depend on the credit policy and range from single elements up
+  // to thousands of elements.
+  std::array<int64_t, 5> batch_size_buckets{{1, 10, 100, 1000, 10000}};
   return actor_system::actor_metric_families_t{
     reg.histogram_family<double>(
       "caf.actor", "processing-time", {"name"}, default_buckets,
@@ -264,12 +291,29 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       reg.gauge_family("caf.actor.stream", "input-buffer-size",
                        {"name", "type"},
                        "Number of buffered stream elements from upstream."),
+      reg.histogram_family<int64_t>(
+        "caf.actor.stream", "batch-size", {"name", "type"}, batch_size_buckets,
+        "Number of elements per batch from upstream."),
+      reg.histogram_family<double>(
+        "caf.actor.stream", "batch-latency", {"name", "type"}, default_buckets,
+        "Time between emitting a batch upstream and processing it.",
+        "seconds"),
+      reg.histogram_family<double>(
+        "caf.actor.stream", "credit-round-trip-time", {"name", "type"},
+        default_buckets,
+        "Time between granting credit and receiving the next batch.",
+        "seconds"),
       reg.counter_family(
         "caf.actor.stream", "pushed-elements", {"name", "type"},
         "Number of elements that have been pushed downstream."),
       reg.gauge_family("caf.actor.stream", "output-buffer-size",
                        {"name", "type"},
                        "Number of buffered output stream elements."),
+      reg.histogram_family<double>(
+        "caf.actor.stream", "credit-starvation-time", {"name", "type"},
+        default_buckets,
+        "Time outbound paths wait for new credit after running out of credit.",
+        "seconds"),
     },
   };
 }
@@ -301,8 +345,24 @@ actor_system::actor_system(actor_system_config& cfg)
   if (auto lst = get_if<string_list>(&cfg,
                                      "caf.metrics-filters.actors.excludes"))
     metrics_actors_excludes_ = std::move(*lst);
-  if (!metrics_actors_includes_.empty())
+  if (auto interval = get_or(cfg, "caf.mailbox-sampler.interval", timespan{0});
+      interval.count() > 0) {
+    auto top_k = get_or(cfg, "caf.mailbox-sampler.top-k",
+                        defaults::mailbox_sampler::top_k);
+    mailbox_sampler_.reset(new detail::mailbox_sampler(metrics_, top_k));
+  }
+  if (!metrics_actors_includes_.empty()) {
     actor_metric_families_ = make_actor_metric_families(metrics_);
+    if (get_or(cfg, "caf.metrics-filters.actors.accounting", false)) {
+      auto& fs = actor_metric_families_;
+      fs.cpu_time = metrics_.counter_family<double>(
+        "caf.actor", "cpu-time", {"name"},
+        "CPU time an actor spends processing messages.", "seconds", true);
+      fs.allocated_bytes = metrics_.counter_family(
+        "caf.actor", "allocated", {"name"},
+        "Bytes an actor allocates while processing messages.", "bytes", true);
+    }
+  }
   // Spin up modules.
   for (auto& f : cfg.module_factories) {
     auto mod_ptr = f(*this);
@@ -370,15 +430,27 @@ actor_system::actor_system(actor_system_config& cfg)
   static constexpr auto Flags = hidden + lazy_init;
   spawn_serv(actor_cast<strong_actor_ptr>(spawn<Flags>(spawn_serv_impl)));
   config_serv(actor_cast<strong_actor_ptr>(spawn<Flags>(config_serv_impl)));
+  if (mailbox_sampler_) {
+    auto interval = get_or(cfg, "caf.mailbox-sampler.interval", timespan{0});
+    auto hdl = spawn<Flags>(mailbox_sampler_impl, mailbox_sampler_.get(),
+                            interval);
+    mailbox_sampler_serv_ = actor_cast<strong_actor_ptr>(std::move(hdl));
+  }
   // Start all modules.
   registry_.start();
   registry_.put("SpawnServ", spawn_serv());
   registry_.put("ConfigServ", config_serv());
+  if (mailbox_sampler_serv_)
+    registry_.put("MailboxSampler", mailbox_sampler_serv_);
   for (auto& mod : modules_)
     if (mod)
       mod->start();
   groups_.start();
   logger_->start();
+  // Trigger the first run of the sampler, which then schedules all
+  // subsequent runs by itself.
+  if (mailbox_sampler_serv_)
+    anon_send(actor_cast<actor>(mailbox_sampler_serv_), tick_atom_v);
 }
 
 actor_system::~actor_system() {
@@ -396,6 +468,10 @@ actor_system::~actor_system() {
     drop(config_serv_);
     registry_.erase("SpawnServ");
     registry_.erase("ConfigServ");
+    if (mailbox_sampler_serv_) {
+      drop(mailbox_sampler_serv_);
+      registry_.erase("MailboxSampler");
+    }
     // group module is the first one, relies on MM
     groups_.stop();
     // stop modules in reverse order
@@ -72,7 +72,9 @@ actor_system_config::actor_system_config()
     .add<timespan>(stream_max_batch_delay, "max-batch-delay",
                    "maximum delay for partial batches")
     .add<string>("credit-policy",
-                 "selects an implementation for credit computation");
+                 "selects an implementation for credit computation")
+    .add<size_t>("max-pending-bytes",
+                 "max. send buffer size before withholding remote credit");
   opt_group{custom_options_, "caf.stream.size-based-policy"}
     .add<int32_t>("bytes-per-batch", "desired batch size in bytes")
     .add<int32_t>("buffer-capacity", "maximum input buffer size in bytes")
@@ -82,6 +84,11 @@ actor_system_config::actor_system_config()
   opt_group{custom_options_, "caf.stream.token-based-policy"}
     .add<int32_t>("batch-size", "number of elements per batch")
     .add<int32_t>("buffer-size", "max. number of elements in the input buffer");
+  opt_group{custom_options_, "caf.stream.latency-based-policy"}
+    .add<timespan>("target-delay", "max. queueing delay of incoming batches")
+    .add<int32_t>("min-buffer-size", "min. number of elements in the buffer")
+    .add<int32_t>("max-buffer-size", "max. number of elements in the buffer")
+    .add<int32_t>("calibration-interval", "frequency of re-calibrations");
   opt_group{custom_options_, "caf.scheduler"}
     .add<string>("policy", "'stealing' (default) or 'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
@@ -89,6 +96,9 @@ actor_system_config::actor_system_config()
     .add<bool>("enable-profiling", "enables profiler output")
     .add<timespan>("profiling-resolution", "data collection rate")
     .add<string>("profiling-output-file", "output file for the profiler");
+  opt_group{custom_options_, "caf.mailbox-sampler"}
+    .add<timespan>("interval", "enables sampling of mailbox sizes at this rate")
+    .add<size_t>("top-k", "number of reported actors with deepest mailboxes");
   opt_group(custom_options_, "caf.work-stealing")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
@@ -108,7 +118,8 @@ actor_system_config::actor_system_config()
     .add<string>("path", "filesystem path for the log file")
     .add<string>("format", "format for individual log file entries")
     .add<string>("verbosity", "minimum severity level for file output")
-    .add<string_list>("excluded-components", "excluded components in files");
+    .add<string_list>("excluded-components", "excluded components in files")
+    .add<bool>("intern-sites", "writes each call site only once to the file");
   opt_group{custom_options_, "caf.logger.console"}
     .add<bool>("colored", "forces colored or uncolored output")
     .add<string>("format", "format for printed console lines")
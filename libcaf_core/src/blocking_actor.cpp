@@ -75,6 +75,7 @@ void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
     ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
   }
+  CAF_BEFORE_ENQUEUE(this, *ptr);
   // returns false if mailbox has been closed
   if (!mailbox().synchronized_push_back(mtx_, cv_, std::move(ptr))) {
     CAF_LOG_REJECT_EVENT();
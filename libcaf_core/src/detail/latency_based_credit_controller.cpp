@@ -0,0 +1,98 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/latency_based_credit_controller.hpp"
+
+#include <algorithm>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config_value.hpp"
+#include "caf/defaults.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/settings.hpp"
+#include "caf/timestamp.hpp"
+
+namespace caf::detail {
+
+latency_based_credit_controller::latency_based_credit_controller(
+  local_actor* ptr)
+  : min_delay_(timespan::max()) {
+  namespace fallback = defaults::stream::latency_policy;
+  // Initialize from the config parameters.
+  auto& cfg = ptr->system().config();
+  if (auto section = get_if<settings>(&cfg,
+                                      "caf.stream.latency-based-policy")) {
+    target_delay_ = get_or(*section, "target-delay", fallback::target_delay);
+    min_buffer_size_ = get_or(*section, "min-buffer-size",
+                              fallback::min_buffer_size);
+    max_buffer_size_ = get_or(*section, "max-buffer-size",
+                              fallback::max_buffer_size);
+    calibration_interval_ = get_or(*section, "calibration-interval",
+                                   fallback::calibration_interval);
+  } else {
+    target_delay_ = fallback::target_delay;
+    min_buffer_size_ = fallback::min_buffer_size;
+    max_buffer_size_ = fallback::max_buffer_size;
+    calibration_interval_ = fallback::calibration_interval;
+  }
+  // Sanitize the input.
+  min_buffer_size_ = std::max(min_buffer_size_, int32_t{1});
+  max_buffer_size_ = std::max(max_buffer_size_, min_buffer_size_);
+  calibration_interval_ = std::max(calibration_interval_, int32_t{1});
+  buffer_size_ = min_buffer_size_;
+}
+
+latency_based_credit_controller::~latency_based_credit_controller() {
+  // nop
+}
+
+void latency_based_credit_controller::before_processing(
+  downstream_msg::batch& x) {
+  // Ignore batches without timestamp, e.g., when created manually.
+  if (x.created == timestamp{})
+    return;
+  auto delay = std::max(make_timestamp() - x.created, timespan{0});
+  min_delay_ = std::min(min_delay_, delay);
+  ++samples_;
+}
+
+credit_controller::calibration latency_based_credit_controller::init() {
+  return {buffer_size_, batch_size(), calibration_interval_};
+}
+
+credit_controller::calibration latency_based_credit_controller::calibrate() {
+  if (samples_ > 0) {
+    if (min_delay_ > target_delay_) {
+      // A standing queue: the sink cannot keep up with the current credit.
+      slow_start_ = false;
+      buffer_size_ = std::max(buffer_size_ / 2, min_buffer_size_);
+    } else if (min_delay_ < target_delay_ / 2) {
+      // The pipeline is underutilized: allow more elements in flight.
+      auto new_size = slow_start_ ? int64_t{buffer_size_} * 2
+                                  : int64_t{buffer_size_} + batch_size();
+      buffer_size_ = static_cast<int32_t>(
+        std::min(new_size, int64_t{max_buffer_size_}));
+    }
+    min_delay_ = timespan::max();
+    samples_ = 0;
+  }
+  return {buffer_size_, batch_size(), calibration_interval_};
+}
+
+} // namespace caf::detail
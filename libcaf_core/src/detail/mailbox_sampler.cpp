@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/mailbox_sampler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "caf/scheduled_actor.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/int_gauge.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+// Orders candidates such that the actor with the smallest mailbox is at the
+// top of a heap.
+struct larger_mailbox {
+  bool operator()(const std::pair<size_t, scheduled_actor*>& x,
+                  const std::pair<size_t, scheduled_actor*>& y) const noexcept {
+    return x.first > y.first;
+  }
+};
+
+} // namespace
+
+mailbox_sampler::mailbox_sampler(telemetry::metric_registry& reg, size_t top_k)
+  : top_k_(top_k) {
+  std::array<int64_t, 5> buckets{{1, 10, 100, 1000, 10000}};
+  mailbox_sizes_ = reg.histogram_singleton(
+    "caf.system", "sampled-mailbox-size", buckets,
+    "Sampled number of messages in the mailbox of all actors.");
+  hot_actors_ = reg.gauge_family(
+    "caf.system", "hot-actor-mailbox-size", {"name"},
+    "Largest mailbox per actor type among the actors with the deepest "
+    "mailboxes.");
+}
+
+void mailbox_sampler::add(scheduled_actor* self) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  actors_.emplace(self);
+}
+
+void mailbox_sampler::remove(scheduled_actor* self) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  actors_.erase(self);
+}
+
+std::vector<hot_actor> mailbox_sampler::sample() {
+  std::vector<hot_actor> result;
+  { // Lifetime scope of the guard. Holding the lock keeps actors from
+    // removing themselves (and thus from getting destroyed) while we read
+    // their state.
+    std::unique_lock<std::mutex> guard{mtx_};
+    std::vector<std::pair<size_t, scheduled_actor*>> heap;
+    heap.reserve(top_k_ + 1);
+    for (auto self : actors_) {
+      auto size = self->sampled_mailbox_size();
+      mailbox_sizes_->observe(static_cast<int64_t>(size));
+      if (size == 0 || top_k_ == 0)
+        continue;
+      if (heap.size() < top_k_ || size > heap.front().first) {
+        heap.emplace_back(size, self);
+        std::push_heap(heap.begin(), heap.end(), larger_mailbox{});
+        if (heap.size() > top_k_) {
+          std::pop_heap(heap.begin(), heap.end(), larger_mailbox{});
+          heap.pop_back();
+        }
+      }
+    }
+    std::sort_heap(heap.begin(), heap.end(), larger_mailbox{});
+    result.reserve(heap.size());
+    for (auto& [size, self] : heap)
+      result.emplace_back(hot_actor{self->id(), self->name(), size});
+  }
+  // Update the gauges and reset all actor types that are no longer "hot".
+  std::unordered_map<std::string, telemetry::int_gauge*> gauges;
+  for (auto& x : result) {
+    auto& gauge = gauges[x.name];
+    if (gauge == nullptr) {
+      gauge = hot_actors_->get_or_add({{"name", x.name}});
+      gauge->value(static_cast<int64_t>(x.mailbox_size));
+    }
+  }
+  for (auto& kvp : hot_gauges_)
+    if (gauges.count(kvp.first) == 0)
+      kvp.second->value(0);
+  hot_gauges_.swap(gauges);
+  return result;
+}
+
+} // namespace caf::detail
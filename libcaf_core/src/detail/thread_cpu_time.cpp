@@ -0,0 +1,57 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/thread_cpu_time.hpp"
+
+#include <cstdint>
+
+#include "caf/config.hpp"
+
+#ifdef CAF_WINDOWS
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+namespace caf::detail {
+
+timespan thread_cpu_time() noexcept {
+#if defined(CAF_WINDOWS)
+  FILETIME creation_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                      &kernel_time, &user_time))
+    return timespan{0};
+  auto to_int = [](const FILETIME& x) {
+    return static_cast<int64_t>(x.dwHighDateTime) << 32 | x.dwLowDateTime;
+  };
+  // FILETIME counts in intervals of 100ns.
+  return timespan{(to_int(kernel_time) + to_int(user_time)) * 100};
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return timespan{0};
+  return timespan{int64_t{ts.tv_sec} * 1'000'000'000 + ts.tv_nsec};
+#else
+  return timespan{0};
+#endif
+}
+
+} // namespace caf::detail
@@ -207,8 +207,9 @@ size_t downstream_manager::buffered(stream_slot) const noexcept {
 }
 
 bool downstream_manager::stalled() const noexcept {
+  // Paths with withheld credit make progress once their connection drained.
   auto no_credit = [](const outbound_path& x) {
-    return x.open_credit == 0;
+    return x.open_credit == 0 && x.withheld_credit == 0;
   };
   return capacity() == 0 && all_paths(no_credit);
 }
@@ -35,9 +35,10 @@ downstream_manager_base::downstream_manager_base(stream_manager* parent)
 downstream_manager_base::downstream_manager_base(stream_manager* parent,
                                                  type_id_t type)
   : super(parent) {
-  auto [pushed_elements, output_buffer_size]
+  auto [pushed_elements, output_buffer_size, credit_starvation_time]
     = parent->self()->outbound_stream_metrics(type);
-  metrics_ = metrics_t{pushed_elements, output_buffer_size};
+  metrics_ = metrics_t{pushed_elements, output_buffer_size,
+                       credit_starvation_time};
 }
 
 downstream_manager_base::~downstream_manager_base() {
@@ -74,6 +75,7 @@ bool downstream_manager_base::insert_path(unique_path_ptr ptr) {
   CAF_ASSERT(ptr != nullptr);
   auto slot = ptr->slots.sender;
   CAF_ASSERT(slot != invalid_stream_slot);
+  ptr->credit_starvation_time = metrics_.credit_starvation_time;
   return paths_.emplace(slot, std::move(ptr)).second;
 }
 
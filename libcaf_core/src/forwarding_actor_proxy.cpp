@@ -27,8 +27,11 @@
 
 namespace caf {
 
-forwarding_actor_proxy::forwarding_actor_proxy(actor_config& cfg, actor dest)
-  : actor_proxy(cfg), broker_(std::move(dest)) {
+forwarding_actor_proxy::forwarding_actor_proxy(actor_config& cfg, actor dest,
+                                               send_buffer_ptr send_buffer)
+  : actor_proxy(cfg),
+    broker_(std::move(dest)),
+    send_buffer_(std::move(send_buffer)) {
   anon_send(broker_, monitor_atom_v, ctrl());
 }
 
@@ -38,7 +41,7 @@ forwarding_actor_proxy::~forwarding_actor_proxy() {
 
 void forwarding_actor_proxy::forward_msg(strong_actor_ptr sender,
                                          message_id mid, message msg,
-                                         const forwarding_stack* fwd) {
+                                         forwarding_stack* fwd) {
   CAF_LOG_TRACE(CAF_ARG(id())
                 << CAF_ARG(sender) << CAF_ARG(mid) << CAF_ARG(msg));
   if (msg.match_elements<exit_msg>())
@@ -48,7 +51,8 @@ void forwarding_actor_proxy::forward_msg(strong_actor_ptr sender,
   if (broker_)
     broker_->enqueue(nullptr, make_message_id(),
                      make_message(forward_atom_v, std::move(sender),
-                                  fwd != nullptr ? *fwd : tmp,
+                                  fwd != nullptr ? std::move(*fwd)
+                                                 : std::move(tmp),
                                   strong_actor_ptr{ctrl()}, mid,
                                   std::move(msg)),
                      nullptr);
@@ -80,6 +84,22 @@ bool forwarding_actor_proxy::remove_backlink(abstract_actor* x) {
   return false;
 }
 
+size_t forwarding_actor_proxy::pending_bytes() const noexcept {
+  return send_buffer_
+           ? send_buffer_->pending_bytes.load(std::memory_order_relaxed)
+           : 0;
+}
+
+void forwarding_actor_proxy::add_pending_bytes_observer() noexcept {
+  if (send_buffer_)
+    ++send_buffer_->observers;
+}
+
+void forwarding_actor_proxy::remove_pending_bytes_observer() noexcept {
+  if (send_buffer_)
+    --send_buffer_->observers;
+}
+
 void forwarding_actor_proxy::kill_proxy(execution_unit* ctx, error rsn) {
   actor tmp;
   { // lifetime scope of guard
@@ -18,6 +18,9 @@
 
 #include "caf/inbound_path.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 #include "caf/actor_system_config.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/meta_object.hpp"
@@ -48,9 +51,11 @@ inbound_path::inbound_path(stream_manager* ptr, type_id_t in_type) : mgr(ptr) {
   CAF_ASSERT(mgr != nullptr);
   mgr->ref();
   auto self = mgr->self();
-  auto [processed_elements, input_buffer_size]
+  auto [processed_elements, input_buffer_size, batch_size, batch_latency,
+        credit_round_trip_time]
     = self->inbound_stream_metrics(in_type);
-  metrics = metrics_t{processed_elements, input_buffer_size};
+  metrics = metrics_t{processed_elements, input_buffer_size, batch_size,
+                      batch_latency, credit_round_trip_time};
   mgr->register_input_path(this);
   CAF_STREAM_LOG_DEBUG(self->name()
                        << "opens input stream with element type"
@@ -100,6 +105,8 @@ void inbound_path::handle(downstream_msg::batch& batch) {
                                       << assigned_credit << "assigned credit");
   assigned_credit -= batch_size;
   CAF_ASSERT(assigned_credit >= 0);
+  if (metrics.batch_size != nullptr)
+    sample(batch);
   controller_->before_processing(batch);
   mgr->handle(this, batch);
   // Update settings as necessary.
@@ -132,6 +139,26 @@ void inbound_path::handle(downstream_msg::forced_close& x) {
   mgr->handle(this, x);
 }
 
+// -- metrics ------------------------------------------------------------------
+
+void inbound_path::sample(const downstream_msg::batch& x) {
+  metrics.batch_size->observe(x.xs_size);
+  // Ignore batches without timestamp, e.g., when created manually.
+  if (x.created == timestamp{})
+    return;
+  auto now = make_timestamp();
+  auto seconds = [](timespan dt) {
+    return std::chrono::duration<double>{std::max(dt, timespan{0})}.count();
+  };
+  metrics.batch_latency->observe(seconds(now - x.created));
+  // Only batches that the source created after receiving our credit complete
+  // a credit round trip.
+  if (credit_granted != timestamp{} && x.created >= credit_granted) {
+    metrics.credit_round_trip_time->observe(seconds(now - credit_granted));
+    credit_granted = timestamp{};
+  }
+}
+
 // -- messaging ----------------------------------------------------------------
 
 void inbound_path::emit_ack_open(local_actor* self, actor_addr rebind_from) {
@@ -153,6 +180,8 @@ void inbound_path::emit_ack_open(local_actor* self, actor_addr rebind_from) {
                    slots.invert(), self->address(), std::move(rebind_from),
                    self->ctrl(), assigned_credit, desired_batch_size));
   last_ack_time = self->now();
+  if (metrics.credit_round_trip_time != nullptr && assigned_credit > 0)
+    credit_granted = make_timestamp();
 }
 
 void inbound_path::emit_ack_batch(local_actor* self, int32_t new_credit) {
@@ -167,6 +196,9 @@ void inbound_path::emit_ack_batch(local_actor* self, int32_t new_credit) {
   last_acked_batch_id = last_batch_id;
   assigned_credit += new_credit;
   last_ack_time = self->now();
+  if (metrics.credit_round_trip_time != nullptr && new_credit > 0
+      && credit_granted == timestamp{})
+    credit_granted = make_timestamp();
 }
 
 void inbound_path::emit_regular_shutdown(local_actor* self) {
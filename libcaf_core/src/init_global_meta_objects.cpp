@@ -26,7 +26,9 @@
 #include "caf/config_value.hpp"
 #include "caf/downstream_msg.hpp"
 #include "caf/error.hpp"
+#include "caf/file_slice.hpp"
 #include "caf/group.hpp"
+#include "caf/hot_actor.hpp"
 #include "caf/ipv4_address.hpp"
 #include "caf/ipv4_endpoint.hpp"
 #include "caf/ipv4_subnet.hpp"
@@ -36,6 +38,7 @@
 #include "caf/message.hpp"
 #include "caf/message_id.hpp"
 #include "caf/node_id.hpp"
+#include "caf/stream.hpp"
 #include "caf/system_messages.hpp"
 #include "caf/timespan.hpp"
 #include "caf/timestamp.hpp"
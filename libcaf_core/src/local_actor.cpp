@@ -57,11 +57,17 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
   self->setf(abstract_actor::collects_metrics_flag);
   const auto& families = sys.actor_metric_families();
   string_view sv{name, strlen(name)};
-  return {
+  local_actor::metrics_t result{
     families.processing_time->get_or_add({{"name", sv}}),
     families.mailbox_time->get_or_add({{"name", sv}}),
     families.mailbox_size->get_or_add({{"name", sv}}),
   };
+  if (families.cpu_time != nullptr) {
+    result.cpu_time = families.cpu_time->get_or_add({{"name", sv}});
+    result.allocated_bytes = families.allocated_bytes->get_or_add(
+      {{"name", sv}});
+  }
+  return result;
 }
 
 } // namespace
@@ -36,6 +36,7 @@
 #include "caf/detail/get_process_id.hpp"
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/spsc_ringbuffer.hpp"
 #include "caf/intrusive/task_result.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/locks.hpp"
@@ -54,6 +55,34 @@ thread_local actor_id current_actor_id;
 // Stores a pointer to the system-wide logger.
 thread_local intrusive_ptr<logger> current_logger_ptr;
 
+// Assigns a unique ID to each logger.
+std::atomic<uint64_t> next_logger_id;
+
+// Keeps track of all call sites that were reached at least once and of all
+// loggers that call sites consult for computing their state.
+struct call_site_registry {
+  std::mutex mtx;
+  logger::call_site* head = nullptr;
+  std::vector<logger*> loggers;
+};
+
+call_site_registry& call_sites() {
+  static call_site_registry instance;
+  return instance;
+}
+
+// Magic bytes at the beginning of each session in a log file with interned
+// call sites.
+constexpr char interned_log_magic[] = "CAFBLOG";
+
+// Version of the file format for interned call sites.
+constexpr uint8_t interned_log_version = 1;
+
+// Tags for records in a log file with interned call sites.
+constexpr char header_record = 'H';
+constexpr char site_record = 'S';
+constexpr char event_record = 'E';
+
 constexpr string_view log_level_name[] = {
   "QUIET",
   "",
@@ -190,6 +219,31 @@ string_view reduce_symbol(std::ostream& out, string_view symbol) {
   return symbol;
 }
 
+// Writes `x` in native byte order.
+template <class T>
+void write_int(std::ostream& out, T x) {
+  out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+// Writes the size of `x` followed by its characters.
+void write_str(std::ostream& out, string_view x) {
+  write_int(out, static_cast<uint32_t>(x.size()));
+  out.write(x.data(), static_cast<std::streamsize>(x.size()));
+}
+
+template <class T>
+bool read_int(std::istream& in, T& x) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&x), sizeof(T)));
+}
+
+bool read_str(std::istream& in, std::string& x) {
+  uint32_t size = 0;
+  if (!read_int(in, size))
+    return false;
+  x.resize(size);
+  return size == 0 || static_cast<bool>(in.read(&x[0], size));
+}
+
 } // namespace
 
 logger::config::config()
@@ -197,7 +251,8 @@ logger::config::config()
       file_verbosity(CAF_LOG_LEVEL),
       console_verbosity(CAF_LOG_LEVEL),
       inline_output(false),
-      console_coloring(false) {
+      console_coloring(false),
+      intern_sites(false) {
   // nop
 }
 
@@ -265,11 +320,97 @@ actor_id logger::thread_local_aid(actor_id aid) {
   return aid;
 }
 
+struct logger::thread_queue {
+  /// Stores events until the logger thread picks them up.
+  detail::spsc_ringbuffer<event, queue_size> events;
+
+  /// Counts events that the thread dropped because `events` was full.
+  std::atomic<size_t> dropped{0};
+
+  /// Signals that the thread terminated and no longer uses this queue.
+  std::atomic<bool> closed{false};
+
+  /// Signals that the logger no longer exists.
+  std::atomic<bool> orphaned{false};
+};
+
 void logger::log(event&& x) {
-  if (cfg_.inline_output)
+  if (cfg_.inline_output) {
     handle_event(x);
-  else
-    queue_.push_back(std::move(x));
+    return;
+  }
+  auto& queue = local_queue();
+  // We never block the calling thread. If the logger cannot keep up, we drop
+  // the event and the logger reports the number of lost events.
+  if (!queue.events.try_push(x))
+    queue.dropped.fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in `run` to make sure that the logger thread either
+  // sees our event or we see that it went to sleep.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_)
+    wakeup();
+}
+
+logger::thread_queue& logger::local_queue() {
+  // Threads may log to multiple loggers, e.g., in unit tests with several
+  // actor systems. Hence, we cache one queue per logger. When the thread
+  // terminates, the destructor hands all queues back to their loggers.
+  struct queue_cache {
+    std::vector<std::pair<uint64_t, thread_queue_ptr>> entries;
+    ~queue_cache() {
+      for (auto& entry : entries)
+        entry.second->closed = true;
+    }
+  };
+  thread_local queue_cache cache;
+  auto& entries = cache.entries;
+  for (auto& [id, ptr] : entries)
+    if (id == id_)
+      return *ptr;
+  // Forget queues of loggers that no longer exist before adding a new one.
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](auto& entry) {
+                                 return entry.second->orphaned.load();
+                               }),
+                entries.end());
+  auto queue = std::make_shared<thread_queue>();
+  {
+    std::unique_lock<std::mutex> guard{queues_mx_};
+    queues_.emplace_back(queue);
+  }
+  entries.emplace_back(id_, queue);
+  return *queue;
+}
+
+size_t logger::drain(std::vector<event>& buf) {
+  size_t dropped = 0;
+  std::unique_lock<std::mutex> guard{queues_mx_};
+  auto i = queues_.begin();
+  while (i != queues_.end()) {
+    auto& queue = **i;
+    // Read the flag before draining, because the thread may still push events
+    // until closing its queue.
+    auto closed = queue.closed.load();
+    queue.events.drain(buf);
+    dropped += queue.dropped.exchange(0, std::memory_order_relaxed);
+    if (closed)
+      i = queues_.erase(i);
+    else
+      ++i;
+  }
+  return dropped;
+}
+
+bool logger::has_pending() {
+  std::unique_lock<std::mutex> guard{queues_mx_};
+  return std::any_of(queues_.begin(), queues_.end(), [](auto& queue) {
+    return !queue->events.empty() || queue->dropped.load() > 0;
+  });
+}
+
+void logger::wakeup() {
+  std::unique_lock<std::mutex> guard{wakeup_mx_};
+  wakeup_cv_.notify_one();
 }
 
 void logger::set_current_actor_system(actor_system* x) {
@@ -281,18 +422,139 @@ logger* logger::current_logger() {
 }
 
 bool logger::accepts(unsigned level, string_view cname) {
-  if (level > cfg_.verbosity)
+  if (level > verbosity())
     return false;
+  shared_lock<detail::shared_spinlock> guard{filter_mtx_};
   return std::none_of(global_filter_.begin(), global_filter_.end(),
                       [=](string_view name) { return name == cname; });
 }
 
-logger::logger(actor_system& sys) : system_(sys), t0_(make_timestamp()) {
+bool logger::call_site::init() {
+  auto& reg = call_sites();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  // Another thread may have registered this site in the meantime.
+  if (state_.load(std::memory_order_relaxed) == unknown) {
+    next_ = reg.head;
+    reg.head = this;
+    update();
+  }
+  return state_.load(std::memory_order_relaxed) == on;
+}
+
+void logger::call_site::update() {
+  auto& loggers = call_sites().loggers;
+  auto accepted = std::any_of(loggers.begin(), loggers.end(), [this](logger* x) {
+    return x->accepts(level_, component_);
+  });
+  state_.store(accepted ? on : off, std::memory_order_relaxed);
+}
+
+void logger::file_verbosity(unsigned level) {
+  if (cfg_.file_verbosity == CAF_LOG_LEVEL_QUIET)
+    return;
+  {
+    std::unique_lock<detail::shared_spinlock> guard{filter_mtx_};
+    file_verbosity_ = std::min(level, unsigned{CAF_LOG_LEVEL_TRACE});
+    update_global_filter();
+  }
+  update_call_sites();
+}
+
+void logger::console_verbosity(unsigned level) {
+  if (cfg_.console_verbosity == CAF_LOG_LEVEL_QUIET)
+    return;
+  {
+    std::unique_lock<detail::shared_spinlock> guard{filter_mtx_};
+    console_verbosity_ = std::min(level, unsigned{CAF_LOG_LEVEL_TRACE});
+    update_global_filter();
+  }
+  update_call_sites();
+}
+
+void logger::file_excluded_components(std::vector<std::string> names) {
+  std::sort(names.begin(), names.end());
+  {
+    std::unique_lock<detail::shared_spinlock> guard{filter_mtx_};
+    file_filter_ = std::move(names);
+    update_global_filter();
+  }
+  update_call_sites();
+}
+
+void logger::console_excluded_components(std::vector<std::string> names) {
+  std::sort(names.begin(), names.end());
+  {
+    std::unique_lock<detail::shared_spinlock> guard{filter_mtx_};
+    console_filter_ = std::move(names);
+    update_global_filter();
+  }
+  update_call_sites();
+}
+
+void logger::update_global_filter() {
+  auto file_lvl = file_verbosity();
+  auto console_lvl = console_verbosity();
+  verbosity_ = std::max(file_lvl, console_lvl);
+  global_filter_.clear();
+  if (file_lvl > CAF_LOG_LEVEL_QUIET && console_lvl > CAF_LOG_LEVEL_QUIET)
+    std::set_intersection(file_filter_.begin(), file_filter_.end(),
+                          console_filter_.begin(), console_filter_.end(),
+                          std::back_inserter(global_filter_));
+  else if (file_lvl > CAF_LOG_LEVEL_QUIET)
+    global_filter_ = file_filter_;
+  else if (console_lvl > CAF_LOG_LEVEL_QUIET)
+    global_filter_ = console_filter_;
+}
+
+void logger::register_at_call_sites() {
+  auto& reg = call_sites();
+  {
+    std::unique_lock<std::mutex> guard{reg.mtx};
+    reg.loggers.emplace_back(this);
+  }
+  update_call_sites();
+}
+
+void logger::unregister_at_call_sites() {
+  auto& reg = call_sites();
+  {
+    std::unique_lock<std::mutex> guard{reg.mtx};
+    auto i = std::find(reg.loggers.begin(), reg.loggers.end(), this);
+    if (i == reg.loggers.end())
+      return;
+    reg.loggers.erase(i);
+  }
+  update_call_sites();
+}
+
+void logger::update_call_sites() {
+  auto& reg = call_sites();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  for (auto site = reg.head; site != nullptr; site = site->next_)
+    site->update();
+}
+
+logger::logger(actor_system& sys)
+  : verbosity_(CAF_LOG_LEVEL_QUIET),
+    file_verbosity_(CAF_LOG_LEVEL_QUIET),
+    console_verbosity_(CAF_LOG_LEVEL_QUIET),
+    system_(sys),
+    t0_(make_timestamp()),
+    id_(next_logger_id++),
+    stopping_(false),
+    sleeping_(false) {
   // nop
 }
 
 logger::~logger() {
+  unregister_at_call_sites();
   stop();
+  {
+    std::unique_lock<std::mutex> guard{queues_mx_};
+    for (auto& queue : queues_)
+      queue->orphaned = true;
+    queues_.clear();
+  }
   // tell system our dtor is done
   std::unique_lock<std::mutex> guard{system_.logger_dtor_mtx_};
   system_.logger_dtor_done_ = true;
@@ -318,21 +580,15 @@ void logger::init(actor_system_config& cfg) {
   cfg_.verbosity = std::max(cfg_.file_verbosity, cfg_.console_verbosity);
   if (cfg_.verbosity == CAF_LOG_LEVEL_QUIET)
     return;
-  if (cfg_.file_verbosity > CAF_LOG_LEVEL_QUIET
-      && cfg_.console_verbosity > CAF_LOG_LEVEL_QUIET) {
+  {
+    std::unique_lock<detail::shared_spinlock> guard{filter_mtx_};
+    file_verbosity_ = cfg_.file_verbosity;
+    console_verbosity_ = cfg_.console_verbosity;
     read_filter(file_filter_, "caf.logger.file.excluded-components");
     read_filter(console_filter_, "caf.logger.console.excluded-components");
     std::sort(file_filter_.begin(), file_filter_.end());
     std::sort(console_filter_.begin(), console_filter_.end());
-    std::set_intersection(file_filter_.begin(), file_filter_.end(),
-                          console_filter_.begin(), console_filter_.end(),
-                          std::back_inserter(global_filter_));
-  } else if (cfg_.file_verbosity > CAF_LOG_LEVEL_QUIET) {
-    read_filter(file_filter_, "caf.logger.file.excluded-components");
-    global_filter_ = file_filter_;
-  } else {
-    read_filter(console_filter_, "caf.logger.console.excluded-components");
-    global_filter_ = console_filter_;
+    update_global_filter();
   }
   // Parse the format string.
   file_format_
@@ -344,16 +600,29 @@ void logger::init(actor_system_config& cfg) {
     cfg_.inline_output = true;
   // If not set to `false`, CAF enables colored output when writing to TTYs.
   cfg_.console_coloring = get_or(cfg, "caf.logger.console.colored", true);
+  cfg_.intern_sites = get_or(cfg, "caf.logger.file.intern-sites", false);
+  register_at_call_sites();
 }
 
 bool logger::open_file() {
   if (file_verbosity() == CAF_LOG_LEVEL_QUIET || file_name_.empty())
     return false;
-  file_.open(file_name_, std::ios::out | std::ios::app);
+  auto mode = std::ios::out | std::ios::app;
+  if (cfg_.intern_sites)
+    mode |= std::ios::binary;
+  file_.open(file_name_, mode);
   if (!file_) {
     std::cerr << "unable to open log file " << file_name_ << std::endl;
     return false;
   }
+  if (cfg_.intern_sites) {
+    // Each session starts with a header, because we append to existing files.
+    interned_sites_.clear();
+    file_.put(header_record);
+    file_.write(interned_log_magic, sizeof(interned_log_magic) - 1);
+    write_int(file_, interned_log_version);
+    write_int(file_, static_cast<int64_t>(t0_.time_since_epoch().count()));
+  }
   return true;
 }
 
@@ -439,8 +708,14 @@ void logger::render_date(std::ostream& out, timestamp x) {
   detail::print(adapter, x);
 }
 
-void logger::render(std::ostream& out, const line_format& lf,
-                    const event& x) const {
+namespace {
+
+// Renders `x` using the line format `lf` to `out`, calling `print_thread` for
+// rendering the thread field.
+template <class PrintThread>
+void render_fields(std::ostream& out, const logger::line_format& lf,
+                   const logger::event& x, timestamp t0,
+                   PrintThread print_thread) {
   auto ms_time_diff = [](timestamp t0, timestamp tn) {
     using namespace std::chrono;
     return duration_cast<milliseconds>(tn - t0).count();
@@ -448,25 +723,107 @@ void logger::render(std::ostream& out, const line_format& lf,
   // clang-format off
   for (auto& f : lf)
     switch (f.kind) {
-      case category_field:     out << x.category_name;             break;
-      case class_name_field:   render_fun_prefix(out, x);          break;
-      case date_field:         render_date(out, x.tstamp);         break;
-      case file_field:         out << x.file_name;                 break;
-      case line_field:         out << x.line_number;               break;
-      case message_field:      out << x.message;                   break;
-      case method_field:       render_fun_name(out, x);            break;
-      case newline_field:      out << std::endl;                   break;
-      case priority_field:     out << log_level_name[x.level];     break;
-      case runtime_field:      out << ms_time_diff(t0_, x.tstamp); break;
-      case thread_field:       out << x.tid;                       break;
-      case actor_field:        out << "actor" << x.aid;            break;
-      case percent_sign_field: out << '%';                         break;
-      case plain_text_field:   out << f.text;                      break;
+      case logger::category_field:     out << x.category_name;         break;
+      case logger::class_name_field:   logger::render_fun_prefix(out, x);
+                                                                       break;
+      case logger::date_field:         logger::render_date(out, x.tstamp);
+                                                                       break;
+      case logger::file_field:         out << x.file_name;             break;
+      case logger::line_field:         out << x.line_number;           break;
+      case logger::message_field:      out << x.message;               break;
+      case logger::method_field:       logger::render_fun_name(out, x);
+                                                                       break;
+      case logger::newline_field:      out << std::endl;               break;
+      case logger::priority_field:     out << log_level_name[x.level]; break;
+      case logger::runtime_field:      out << ms_time_diff(t0, x.tstamp);
+                                                                       break;
+      case logger::thread_field:       print_thread(out);              break;
+      case logger::actor_field:        out << "actor" << x.aid;        break;
+      case logger::percent_sign_field: out << '%';                     break;
+      case logger::plain_text_field:   out << f.text;                  break;
       default: ; // nop
     }
   // clang-format on
 }
 
+} // namespace
+
+void logger::render(std::ostream& out, const line_format& lf,
+                    const event& x) const {
+  render_fields(out, lf, x, t0_, [&x](std::ostream& os) { os << x.tid; });
+}
+
+bool logger::render_interned_log(std::istream& in, std::ostream& out,
+                                 const line_format& lf) {
+  struct site {
+    unsigned level;
+    unsigned line;
+    std::string category;
+    std::string pretty_fun;
+    std::string simple_fun;
+    std::string file_name;
+  };
+  std::vector<site> sites;
+  timestamp t0;
+  bool has_header = false;
+  char tag;
+  while (in.get(tag)) {
+    switch (tag) {
+      case header_record: {
+        char magic[sizeof(interned_log_magic) - 1];
+        uint8_t version = 0;
+        int64_t t0_count = 0;
+        if (!in.read(magic, sizeof(magic))
+            || !std::equal(magic, magic + sizeof(magic), interned_log_magic)
+            || !read_int(in, version) || version != interned_log_version
+            || !read_int(in, t0_count))
+          return false;
+        t0 = timestamp{timestamp::duration{t0_count}};
+        sites.clear();
+        has_header = true;
+        break;
+      }
+      case site_record: {
+        uint32_t id = 0;
+        site x;
+        if (!has_header || !read_int(in, id) || id != sites.size()
+            || !read_int(in, x.level) || !read_int(in, x.line)
+            || !read_str(in, x.category) || !read_str(in, x.pretty_fun)
+            || !read_str(in, x.simple_fun) || !read_str(in, x.file_name))
+          return false;
+        sites.emplace_back(std::move(x));
+        break;
+      }
+      case event_record: {
+        uint32_t id = 0;
+        uint64_t tid = 0;
+        actor_id aid = 0;
+        int64_t ts = 0;
+        std::string msg;
+        if (!read_int(in, id) || id >= sites.size() || !read_int(in, tid)
+            || !read_int(in, aid) || !read_int(in, ts) || !read_str(in, msg))
+          return false;
+        auto& x = sites[id];
+        event e{x.level,
+                x.line,
+                x.category,
+                x.pretty_fun,
+                x.simple_fun,
+                x.file_name,
+                std::move(msg),
+                std::thread::id{},
+                aid,
+                timestamp{timestamp::duration{ts}}};
+        render_fields(out, lf, e, t0, [tid](std::ostream& os) { os << tid; });
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return in.eof();
+}
+
 logger::line_format logger::parse_format(const std::string& format_str) {
   std::vector<field> res;
   auto plain_text_first = format_str.begin();
@@ -522,43 +879,105 @@ string_view logger::skip_path(string_view path) {
 }
 
 void logger::run() {
-  // Bail out without printing anything if the first event we receive is the
-  // shutdown (empty) event.
-  queue_.wait_nonempty();
-  if (queue_.front().message.empty())
-    return;
-  if (!open_file() && console_verbosity() == CAF_LOG_LEVEL_QUIET)
-    return;
-  log_first_line();
-  // Loop until receiving an empty message.
+  std::vector<event> events;
+  // We open the log file lazily and bail out without printing anything if we
+  // never receive any event.
+  bool started = false;
+  bool has_output = false;
   for (;;) {
-    // Handle current head of the queue.
-    auto& e = queue_.front();
-    if (e.message.empty()) {
-      log_last_line();
-      return;
+    // Read the flag before draining to make sure we pick up all events that
+    // threads have logged before calling `stop`.
+    auto stopping = stopping_.load();
+    if (auto dropped = drain(events); dropped > 0)
+      events.emplace_back(CAF_LOG_MAKE_EVENT(0, CAF_LOG_COMPONENT,
+                                             CAF_LOG_LEVEL_WARNING,
+                                             "dropped" << dropped
+                                                       << "events: queue full"));
+    if (!events.empty()) {
+      if (!started) {
+        started = true;
+        has_output = open_file()
+                     || console_verbosity() != CAF_LOG_LEVEL_QUIET;
+        if (has_output)
+          log_first_line();
+      }
+      if (has_output) {
+        // Order the events of this batch by time. This only interleaves
+        // events that arrived in the same batch, i.e., events from different
+        // batches may still appear out of order.
+        std::stable_sort(events.begin(), events.end(),
+                         [](const event& x, const event& y) {
+                           return x.tstamp < y.tstamp;
+                         });
+        for (auto& e : events)
+          handle_event(e);
+      }
+      events.clear();
+    } else if (stopping) {
+      break;
+    } else {
+      std::unique_lock<std::mutex> guard{wakeup_mx_};
+      sleeping_ = true;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!stopping_ && !has_pending())
+        wakeup_cv_.wait_for(guard, std::chrono::seconds(1));
+      sleeping_ = false;
     }
-    handle_event(e);
-    // Prepare next iteration.
-    queue_.pop_front();
-    queue_.wait_nonempty();
   }
+  if (has_output)
+    log_last_line();
 }
 
 void logger::handle_file_event(const event& x) {
   // Print to file if available.
-  if (file_ && x.level <= file_verbosity()
-      && none_of(file_filter_.begin(), file_filter_.end(),
-                 [&x](string_view name) { return name == x.category_name; }))
+  if (!file_ || x.level > file_verbosity())
+    return;
+  {
+    shared_lock<detail::shared_spinlock> guard{filter_mtx_};
+    if (std::any_of(file_filter_.begin(), file_filter_.end(),
+                    [&x](string_view name) { return name == x.category_name; }))
+      return;
+  }
+  if (cfg_.intern_sites)
+    write_interned(x);
+  else
     render(file_, file_format_, x);
 }
 
+void logger::write_interned(const event& x) {
+  auto key = std::make_tuple(x.pretty_fun.data(), x.category_name.data(),
+                             x.line_number, x.level);
+  auto i = interned_sites_.find(key);
+  if (i == interned_sites_.end()) {
+    // Write each call site only once and refer to it by ID afterwards.
+    auto id = static_cast<uint32_t>(interned_sites_.size());
+    i = interned_sites_.emplace(key, id).first;
+    file_.put(site_record);
+    write_int(file_, id);
+    write_int(file_, x.level);
+    write_int(file_, x.line_number);
+    write_str(file_, x.category_name);
+    write_str(file_, x.pretty_fun);
+    write_str(file_, x.simple_fun);
+    write_str(file_, x.file_name);
+  }
+  file_.put(event_record);
+  write_int(file_, i->second);
+  write_int(file_, static_cast<uint64_t>(std::hash<std::thread::id>{}(x.tid)));
+  write_int(file_, x.aid);
+  write_int(file_, static_cast<int64_t>(x.tstamp.time_since_epoch().count()));
+  write_str(file_, x.message);
+}
+
 void logger::handle_console_event(const event& x) {
   if (x.level > console_verbosity())
     return;
-  if (std::any_of(console_filter_.begin(), console_filter_.end(),
-                  [&x](string_view name) { return name == x.category_name; }))
-    return;
+  {
+    shared_lock<detail::shared_spinlock> guard{filter_mtx_};
+    if (std::any_of(console_filter_.begin(), console_filter_.end(),
+                    [&x](string_view name) { return name == x.category_name; }))
+      return;
+  }
   if (cfg_.console_coloring) {
     switch (x.level) {
       default:
@@ -606,9 +1025,14 @@ void logger::log_first_line() {
     return msg;
   };
   namespace lg = defaults::logger;
-  e.message = make_message(cfg_.file_verbosity, file_filter_);
+  std::string console_message;
+  {
+    shared_lock<detail::shared_spinlock> guard{filter_mtx_};
+    e.message = make_message(file_verbosity(), file_filter_);
+    console_message = make_message(console_verbosity(), console_filter_);
+  }
   handle_file_event(e);
-  e.message = make_message(cfg_.console_verbosity, console_filter_);
+  e.message = std::move(console_message);
   handle_console_event(e);
 }
 
@@ -672,8 +1096,8 @@ void logger::stop() {
   }
   if (!thread_.joinable())
     return;
-  // A default-constructed event causes the logger to shutdown.
-  queue_.push_back(event{});
+  stopping_ = true;
+  wakeup();
   thread_.join();
 }
 
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/mapped_file.hpp"
+
+#include <algorithm>
+
+#include "caf/config.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/sec.hpp"
+
+#ifdef CAF_WINDOWS
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace caf {
+
+mapped_file::mapped_file() noexcept
+  : data_(nullptr), size_(0), mapping_(nullptr) {
+  // nop
+}
+
+mapped_file::mapped_file(byte_buffer buf) noexcept
+  : data_(buf.data()), size_(buf.size()), mapping_(nullptr) {
+  buf_.swap(buf);
+}
+
+mapped_file::~mapped_file() {
+  if (mapping_ == nullptr)
+    return;
+#ifdef CAF_WINDOWS
+  UnmapViewOfFile(mapping_);
+#else
+  munmap(mapping_, size_);
+#endif
+}
+
+void mapped_file::will_need(size_t offset, size_t len) const noexcept {
+#if !defined(CAF_WINDOWS) && defined(MADV_WILLNEED)
+  if (mapping_ == nullptr || offset >= size_)
+    return;
+  // madvise requires a page-aligned address.
+  static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto first = offset - offset % page_size;
+  len = std::min(len + (offset - first), size_ - first);
+  madvise(static_cast<char*>(mapping_) + first, len, MADV_WILLNEED);
+#else
+  CAF_IGNORE_UNUSED(offset);
+  CAF_IGNORE_UNUSED(len);
+#endif
+}
+
+expected<mapped_file_ptr> mapped_file::open(const std::string& path) {
+  mapped_file_ptr result{new mapped_file, false};
+#ifdef CAF_WINDOWS
+  auto fd = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (fd == INVALID_HANDLE_VALUE)
+    return make_error(sec::cannot_open_file, path);
+  auto fd_guard = detail::make_scope_guard([fd] { CloseHandle(fd); });
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(fd, &file_size))
+    return make_error(sec::cannot_open_file, path);
+  if (file_size.QuadPart == 0)
+    return result;
+  auto hdl = CreateFileMappingA(fd, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (hdl == nullptr)
+    return make_error(sec::cannot_open_file, path);
+  auto hdl_guard = detail::make_scope_guard([hdl] { CloseHandle(hdl); });
+  auto ptr = MapViewOfFile(hdl, FILE_MAP_READ, 0, 0, 0);
+  if (ptr == nullptr)
+    return make_error(sec::cannot_open_file, path);
+  result->size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return make_error(sec::cannot_open_file, path);
+  auto fd_guard = detail::make_scope_guard([fd] { ::close(fd); });
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+    return make_error(sec::cannot_open_file, path);
+  if (st.st_size == 0)
+    return result;
+  auto size = static_cast<size_t>(st.st_size);
+  auto ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (ptr == MAP_FAILED)
+    return make_error(sec::cannot_open_file, path);
+#  ifdef MADV_SEQUENTIAL
+  madvise(ptr, size, MADV_SEQUENTIAL);
+#  endif
+  result->size_ = size;
+#endif
+  result->mapping_ = ptr;
+  result->data_ = static_cast<const byte*>(ptr);
+  return result;
+}
+
+} // namespace caf
@@ -0,0 +1,318 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/message_tracer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "caf/detail/get_process_id.hpp"
+#include "caf/detail/print.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+
+namespace {
+
+// Assigns a unique ID to each tracer.
+std::atomic<uint64_t> next_tracer_id;
+
+} // namespace
+
+// -- member types -------------------------------------------------------------
+
+struct message_tracer::thread_buffer {
+  thread_buffer(size_t size, uint32_t thread) : events(size), thread(thread) {
+    // nop
+  }
+
+  /// Guards all other member variables. Only the export functions compete with
+  /// the owning thread for this lock.
+  std::mutex mtx;
+
+  /// Stores events as ring buffer.
+  std::vector<event> events;
+
+  /// Points to the slot for the next event.
+  size_t next = 0;
+
+  /// Stores how many slots contain valid events.
+  size_t size = 0;
+
+  /// Identifies the owning thread in the output.
+  uint32_t thread;
+
+  /// Signals that the tracer no longer exists.
+  std::atomic<bool> orphaned{false};
+};
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+message_tracer::message_tracer(size_t buffer_size)
+  : buffer_size_(buffer_size > 0 ? buffer_size : 1),
+    id_(next_tracer_id++),
+    t0_(std::chrono::steady_clock::now()) {
+  // nop
+}
+
+message_tracer::~message_tracer() {
+  std::unique_lock<std::mutex> guard{buffers_mx_};
+  for (auto& buf : buffers_)
+    buf->orphaned = true;
+}
+
+// -- properties ---------------------------------------------------------------
+
+std::vector<message_tracer::event> message_tracer::events() {
+  std::vector<event> result;
+  {
+    std::unique_lock<std::mutex> guard{buffers_mx_};
+    for (auto& buf : buffers_) {
+      std::unique_lock<std::mutex> buf_guard{buf->mtx};
+      // The oldest event is at `next` once the ring buffer is full.
+      auto first = buf->size < buf->events.size() ? 0 : buf->next;
+      for (size_t i = 0; i < buf->size; ++i)
+        result.emplace_back(buf->events[(first + i) % buf->events.size()]);
+    }
+  }
+  std::stable_sort(result.begin(), result.end(),
+                   [](const event& x, const event& y) {
+                     return x.timestamp < y.timestamp;
+                   });
+  return result;
+}
+
+// -- export -------------------------------------------------------------------
+
+namespace {
+
+// Chrome expects timestamps in microseconds.
+void print_timestamp(std::string& buf, int64_t ns) {
+  detail::print(buf, ns / 1000);
+  buf += '.';
+  auto fraction = std::to_string(ns % 1000);
+  buf.insert(buf.end(), 3 - fraction.size(), '0');
+  buf += fraction;
+}
+
+void print_header(std::string& buf, string_view name, string_view category,
+                  char phase, int64_t ns, uint32_t pid, uint32_t tid) {
+  buf += R"({"name":)";
+  detail::print_escaped(buf, name);
+  buf += R"(,"cat":")";
+  buf.insert(buf.end(), category.begin(), category.end());
+  buf += R"(","ph":")";
+  buf += phase;
+  buf += R"(","ts":)";
+  print_timestamp(buf, ns);
+  buf += R"(,"pid":)";
+  detail::print(buf, pid);
+  buf += R"(,"tid":)";
+  detail::print(buf, tid);
+}
+
+void print_args(std::string& buf, const message_tracer::event& x) {
+  buf += R"(,"args":{"actor":)";
+  detail::print_escaped(buf, x.name);
+  buf += R"(,"aid":)";
+  detail::print(buf, x.aid);
+  buf += R"(,"message":)";
+  detail::print_escaped(buf, to_string(x.types));
+  buf += "}}";
+}
+
+void print_flow(std::string& buf, const message_tracer::event& x, char phase,
+                uint32_t pid) {
+  buf += ",\n";
+  print_header(buf, "message", "caf.flow", phase, x.timestamp, pid, x.thread);
+  // IDs are addresses, which exceed the precision of JSON numbers.
+  buf += R"(,"id":")";
+  detail::print(buf, x.flow);
+  buf += '"';
+  // Bind the end of the arrow to the slice of the receiver.
+  if (phase == 'f')
+    buf += R"(,"bp":"e")";
+  buf += '}';
+}
+
+} // namespace
+
+void message_tracer::write_chrome_trace(std::ostream& out) {
+  auto xs = events();
+  auto pid = static_cast<uint32_t>(detail::get_process_id());
+  std::vector<uint32_t> threads;
+  for (auto& x : xs)
+    threads.emplace_back(x.thread);
+  std::sort(threads.begin(), threads.end());
+  threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+  std::string buf;
+  buf += R"({"displayTimeUnit":"ns","traceEvents":[)";
+  auto first = true;
+  auto separate = [&] {
+    if (first)
+      first = false;
+    else
+      buf += ',';
+    buf += '\n';
+  };
+  for (auto tid : threads) {
+    separate();
+    buf += R"({"name":"thread_name","ph":"M","pid":)";
+    detail::print(buf, pid);
+    buf += R"(,"tid":)";
+    detail::print(buf, tid);
+    buf += R"(,"args":{"name":"thread )";
+    detail::print(buf, tid);
+    buf += R"("}})";
+  }
+  for (auto& x : xs) {
+    separate();
+    switch (x.type) {
+      case event_type::send:
+        print_header(buf, "send", "caf", 'i', x.timestamp, pid, x.thread);
+        buf += R"(,"s":"t")";
+        print_args(buf, x);
+        print_flow(buf, x, 's', pid);
+        break;
+      case event_type::enqueue:
+        print_header(buf, "enqueue", "caf", 'i', x.timestamp, pid, x.thread);
+        buf += R"(,"s":"t")";
+        print_args(buf, x);
+        print_flow(buf, x, 't', pid);
+        break;
+      case event_type::dequeue:
+        print_header(buf, x.name, "caf", 'B', x.timestamp, pid, x.thread);
+        print_args(buf, x);
+        print_flow(buf, x, 'f', pid);
+        break;
+      case event_type::processing_end:
+        print_header(buf, x.name, "caf", 'E', x.timestamp, pid, x.thread);
+        buf += '}';
+        break;
+    }
+    // Avoid buffering the entire trace in memory.
+    if (buf.size() >= 65536) {
+      out << buf;
+      buf.clear();
+    }
+  }
+  buf += "\n]}\n";
+  out << buf;
+}
+
+void message_tracer::clear() {
+  std::unique_lock<std::mutex> guard{buffers_mx_};
+  for (auto& buf : buffers_) {
+    std::unique_lock<std::mutex> buf_guard{buf->mtx};
+    buf->next = 0;
+    buf->size = 0;
+  }
+}
+
+// -- overrides ----------------------------------------------------------------
+
+void message_tracer::add_actor(const local_actor&, const local_actor*) {
+  // nop
+}
+
+void message_tracer::remove_actor(const local_actor&) {
+  // nop
+}
+
+void message_tracer::before_processing(const local_actor& self,
+                                       const mailbox_element& element) {
+  record(event_type::dequeue, self, &element);
+}
+
+void message_tracer::after_processing(const local_actor& self,
+                                      invoke_message_result) {
+  record(event_type::processing_end, self, nullptr);
+}
+
+void message_tracer::before_sending(const local_actor& self,
+                                    mailbox_element& element) {
+  record(event_type::send, self, &element);
+}
+
+void message_tracer::before_sending_scheduled(const local_actor& self,
+                                              actor_clock::time_point,
+                                              mailbox_element& element) {
+  record(event_type::send, self, &element);
+}
+
+void message_tracer::before_enqueue(const local_actor& self,
+                                    const mailbox_element& element) {
+  record(event_type::enqueue, self, &element);
+}
+
+// -- utility functions --------------------------------------------------------
+
+message_tracer::thread_buffer& message_tracer::local_buffer() {
+  // Threads may record events for multiple tracers, e.g., in unit tests with
+  // several actor systems. Hence, we cache one buffer per tracer.
+  thread_local std::vector<std::pair<uint64_t, thread_buffer_ptr>> cache;
+  for (auto& [id, ptr] : cache)
+    if (id == id_)
+      return *ptr;
+  // Forget buffers of tracers that no longer exist before adding a new one.
+  cache.erase(std::remove_if(cache.begin(), cache.end(),
+                             [](auto& entry) {
+                               return entry.second->orphaned.load();
+                             }),
+              cache.end());
+  thread_buffer_ptr buf;
+  {
+    std::unique_lock<std::mutex> guard{buffers_mx_};
+    auto thread = static_cast<uint32_t>(buffers_.size() + 1);
+    buf = std::make_shared<thread_buffer>(buffer_size_, thread);
+    buffers_.emplace_back(buf);
+  }
+  cache.emplace_back(id_, buf);
+  return *buf;
+}
+
+void message_tracer::record(event_type type, const local_actor& self,
+                            const mailbox_element* element) {
+  auto ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - t0_)
+              .count();
+  auto& buf = local_buffer();
+  std::unique_lock<std::mutex> guard{buf.mtx};
+  auto& x = buf.events[buf.next];
+  x.type = type;
+  x.thread = buf.thread;
+  x.timestamp = static_cast<int64_t>(ts);
+  if (element != nullptr) {
+    x.flow = reinterpret_cast<uintptr_t>(element);
+    x.types = element->payload.types();
+  } else {
+    x.flow = 0;
+    x.types = make_type_id_list();
+  }
+  x.aid = self.id();
+  x.name = self.name();
+  buf.next = (buf.next + 1) % buf.events.size();
+  if (buf.size < buf.events.size())
+    ++buf.size;
+}
+
+} // namespace caf
@@ -18,6 +18,10 @@
 
 #include "caf/outbound_path.hpp"
 
+#include <algorithm>
+#include <chrono>
+
+#include "caf/actor_proxy.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/logger.hpp"
 #include "caf/no_stages.hpp"
@@ -35,17 +39,21 @@ constexpr int32_t max_batch_size = 128 * 1024;
 outbound_path::outbound_path(stream_slot sender_slot,
                              strong_actor_ptr receiver_hdl)
   : slots(sender_slot, invalid_stream_slot),
-    hdl(std::move(receiver_hdl)),
     next_batch_id(1),
     open_credit(0),
+    withheld_credit(0),
+    remote_hdl(nullptr),
+    observes_remote_hdl(false),
     desired_batch_size(50),
     next_ack_id(1),
-    closing(false) {
-  // nop
+    closing(false),
+    credit_starvation_time(nullptr) {
+  rebind(std::move(receiver_hdl));
 }
 
 outbound_path::~outbound_path() {
-  // nop
+  if (observes_remote_hdl)
+    remote_hdl->remove_pending_bytes_observer();
 }
 
 void outbound_path::emit_batch(local_actor* self, int32_t xs_size, message xs) {
@@ -56,8 +64,11 @@ void outbound_path::emit_batch(local_actor* self, int32_t xs_size, message xs) {
   open_credit -= xs_size;
   CAF_ASSERT(open_credit >= 0);
   auto bid = next_batch_id++;
+  auto now = make_timestamp();
+  if (open_credit == 0 && credit_starvation_time != nullptr)
+    credit_exhausted = now;
   downstream_msg::batch batch{static_cast<int32_t>(xs_size), std::move(xs),
-                              bid};
+                              bid, now};
   unsafe_send_as(self, hdl,
                  downstream_msg{slots, self->address(), std::move(batch)});
 }
@@ -98,4 +109,44 @@ void outbound_path::set_desired_batch_size(int32_t value) noexcept {
                                                            : value;
 }
 
+void outbound_path::rebind(strong_actor_ptr receiver_hdl) {
+  if (observes_remote_hdl) {
+    remote_hdl->remove_pending_bytes_observer();
+    observes_remote_hdl = false;
+  }
+  hdl = std::move(receiver_hdl);
+  // Only proxies know the state of the connection to their node.
+  remote_hdl = hdl ? dynamic_cast<actor_proxy*>(hdl->get()) : nullptr;
+}
+
+bool outbound_path::congested(size_t max_pending_bytes) const noexcept {
+  return max_pending_bytes > 0 && remote_hdl != nullptr
+         && remote_hdl->pending_bytes() > max_pending_bytes;
+}
+
+void outbound_path::grant_credit(int32_t amount, size_t max_pending_bytes) {
+  CAF_ASSERT(amount >= 0);
+  // Brokers only track the send buffer of connections with observers.
+  if (max_pending_bytes > 0 && remote_hdl != nullptr && !observes_remote_hdl) {
+    remote_hdl->add_pending_bytes_observer();
+    observes_remote_hdl = true;
+  }
+  withheld_credit += amount;
+  release_credit(max_pending_bytes);
+}
+
+bool outbound_path::release_credit(size_t max_pending_bytes) {
+  if (withheld_credit == 0 || congested(max_pending_bytes))
+    return false;
+  CAF_LOG_DEBUG(CAF_ARG(slots) << CAF_ARG(withheld_credit));
+  open_credit += withheld_credit;
+  withheld_credit = 0;
+  if (credit_exhausted != timestamp{}) {
+    auto dt = std::max(make_timestamp() - credit_exhausted, timespan{0});
+    credit_starvation_time->observe(std::chrono::duration<double>{dt}.count());
+    credit_exhausted = timestamp{};
+  }
+  return true;
+}
+
 } // namespace caf
@@ -0,0 +1,185 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/sampling_actor_profiler.hpp"
+
+#include <array>
+#include <chrono>
+#include <string>
+
+#include "caf/actor_system.hpp"
+#include "caf/invoke_message_result.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/label_view.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+#include "caf/type_id_list.hpp"
+
+namespace caf {
+
+namespace {
+
+// Stores the measurement in progress on the current thread.
+struct sample_state {
+  // Counts processed messages for picking every N-th message.
+  size_t counter = 0;
+
+  // Points to the actor that processes the sampled message or `nullptr` if no
+  // measurement is in progress.
+  const local_actor* self = nullptr;
+
+  // Points to the profiler that started the measurement.
+  const sampling_actor_profiler* profiler = nullptr;
+
+  // Stores when the actor started processing the sampled message.
+  std::chrono::steady_clock::time_point start;
+
+  // Stores how long the sampled message waited in the mailbox or a negative
+  // value if the message carries no enqueue timestamp.
+  double mailbox_time = -1.;
+
+  // Counts messages that the actor sent while processing the sampled message.
+  int64_t sent_messages = 0;
+
+  // Stores the types of the sampled message.
+  type_id_list types = make_type_id_list();
+};
+
+thread_local sample_state current_sample;
+
+// Handling a single message generally should take microseconds (see the
+// default buckets for caf.actor.processing-time).
+constexpr std::array<double, 9> time_buckets{{
+  .00001, // 10us
+  .0001,  // 100us
+  .0005,  // 500us
+  .001,   // 1ms
+  .01,    // 10ms
+  .1,     // 100ms
+  .5,     // 500ms
+  1.,     // 1s
+  5.,     // 5s
+}};
+
+// Most actors send a handful of messages per input at most, but broadcasting
+// actors may easily send hundreds.
+constexpr std::array<int64_t, 9> fan_out_buckets{{
+  0, 1, 2, 4, 8, 16, 32, 64, 128,
+}};
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+sampling_actor_profiler::sampling_actor_profiler(size_t sample_rate)
+  : sample_rate_(sample_rate > 0 ? sample_rate : 1) {
+  // nop
+}
+
+sampling_actor_profiler::~sampling_actor_profiler() {
+  // nop
+}
+
+// -- overrides ----------------------------------------------------------------
+
+void sampling_actor_profiler::add_actor(const local_actor&,
+                                        const local_actor*) {
+  // nop
+}
+
+void sampling_actor_profiler::remove_actor(const local_actor&) {
+  // nop
+}
+
+void sampling_actor_profiler::before_processing(
+  const local_actor& self, const mailbox_element& element) {
+  auto& st = current_sample;
+  // Skip nested invocations while measuring another message.
+  if (st.self != nullptr || ++st.counter % sample_rate_ != 0)
+    return;
+  init_families(self);
+  st.self = &self;
+  st.profiler = this;
+  st.start = std::chrono::steady_clock::now();
+  if (element.enqueue_time != std::chrono::steady_clock::time_point{})
+    st.mailbox_time = element.seconds_until(st.start);
+  else
+    st.mailbox_time = -1.;
+  st.sent_messages = 0;
+  st.types = element.payload.types();
+}
+
+void sampling_actor_profiler::after_processing(const local_actor& self,
+                                               invoke_message_result result) {
+  auto& st = current_sample;
+  if (st.self != &self || st.profiler != this)
+    return;
+  st.self = nullptr;
+  // Skipped messages remain in the mailbox and the actor processes them later.
+  if (result == invoke_message_result::skipped)
+    return;
+  auto processing_time = std::chrono::duration<double>{
+    std::chrono::steady_clock::now() - st.start};
+  auto message = to_string(st.types);
+  std::initializer_list<telemetry::label_view> labels{{"name", self.name()},
+                                                      {"message", message}};
+  processing_time_->get_or_add(labels)->observe(processing_time.count());
+  if (st.mailbox_time >= 0.)
+    mailbox_time_->get_or_add(labels)->observe(st.mailbox_time);
+  fan_out_->get_or_add(labels)->observe(st.sent_messages);
+}
+
+void sampling_actor_profiler::before_sending(const local_actor& self,
+                                             mailbox_element& element) {
+  element.set_enqueue_time();
+  auto& st = current_sample;
+  if (st.self == &self && st.profiler == this)
+    ++st.sent_messages;
+}
+
+void sampling_actor_profiler::before_sending_scheduled(
+  const local_actor& self, actor_clock::time_point, mailbox_element&) {
+  // The clock sets no enqueue timestamp for delayed messages. Hence, we
+  // measure the fan-out only.
+  auto& st = current_sample;
+  if (st.self == &self && st.profiler == this)
+    ++st.sent_messages;
+}
+
+// -- initialization -----------------------------------------------------------
+
+void sampling_actor_profiler::init_families(const local_actor& self) {
+  std::call_once(families_initialized_, [this, &self] {
+    auto& reg = self.home_system().metrics();
+    processing_time_ = reg.histogram_family<double>(
+      "caf.actor.profiler", "processing-time", {"name", "message"},
+      time_buckets, "Time an actor needs to process sampled messages.",
+      "seconds");
+    mailbox_time_ = reg.histogram_family<double>(
+      "caf.actor.profiler", "mailbox-time", {"name", "message"}, time_buckets,
+      "Time a sampled message waits in the mailbox before processing.",
+      "seconds");
+    fan_out_ = reg.histogram_family<int64_t>(
+      "caf.actor.profiler", "fan-out", {"name", "message"}, fan_out_buckets,
+      "Number of messages an actor sends while processing a sampled message.");
+  });
+}
+
+} // namespace caf
@@ -23,9 +23,12 @@
 #include "caf/config.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/default_invoke_result_visitor.hpp"
+#include "caf/detail/mailbox_sampler.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/detail/private_thread.hpp"
+#include "caf/detail/scope_guard.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/detail/thread_cpu_time.hpp"
 #include "caf/inbound_path.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
 
@@ -126,6 +129,7 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
   : super(cfg),
     mailbox_(unit, unit, unit, unit, unit),
     timeout_id_(0),
+    stream_timeout_(actor_clock::time_point::max()),
     default_handler_(print_and_drop),
     error_handler_(default_error_handler),
     down_handler_(default_down_handler),
@@ -163,6 +167,10 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
     ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
   }
+  auto sampled = getf(abstract_actor::is_sampled_flag);
+  if (sampled)
+    sampled_mailbox_size_.fetch_add(1, std::memory_order_relaxed);
+  CAF_BEFORE_ENQUEUE(this, *ptr);
   switch (mailbox().push_back(std::move(ptr))) {
     case intrusive::inbox_result::unblocked_reader: {
       CAF_LOG_ACCEPT_EVENT(true);
@@ -184,6 +192,8 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       home_system().base_metrics().rejected_messages->inc();
       if (collects_metrics)
         metrics_.mailbox_size->dec();
+      if (sampled)
+        sampled_mailbox_size_.fetch_sub(1, std::memory_order_relaxed);
       if (mid.is_request()) {
         detail::sync_request_bouncer f{exit_reason()};
         f(sender, mid);
@@ -210,6 +220,10 @@ void scheduled_actor::launch(execution_unit* eu, bool lazy, bool hide) {
   CAF_PUSH_AID_FROM_PTR(this);
   CAF_LOG_TRACE(CAF_ARG(lazy) << CAF_ARG(hide));
   CAF_ASSERT(!getf(is_blocking_flag));
+  if (auto sampler = home_system().mailbox_sampler()) {
+    setf(is_sampled_flag);
+    sampler->add(this);
+  }
   if (!hide)
     register_at_system();
   if (getf(is_detached_flag)) {
@@ -246,6 +260,9 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   stream_managers_.clear();
   pending_stream_managers_.clear();
   get_downstream_queue().cleanup();
+  // Stop the sampler from reading our state, since we might get destroyed.
+  if (getf(is_sampled_flag))
+    home_system().mailbox_sampler()->remove(this);
   // Clear mailbox.
   if (!mailbox_.closed()) {
     mailbox_.close();
@@ -285,6 +302,16 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
   CAF_LOG_TRACE(CAF_ARG(max_throughput));
   if (!activate(ctx))
     return resumable::done;
+  // Measure the CPU time of the entire run, since querying the CPU clock of
+  // the thread per message would add a system call on some platforms.
+  auto cpu_guard = detail::make_scope_guard(
+    [cpu_time = metrics_.cpu_time,
+     t0 = metrics_.cpu_time ? detail::thread_cpu_time() : timespan{0}] {
+      if (cpu_time) {
+        auto delta = detail::thread_cpu_time() - t0;
+        cpu_time->inc(std::chrono::duration<double>{delta}.count());
+      }
+    });
   size_t consumed = 0;
   actor_clock::time_point tout{actor_clock::duration_type{0}};
   auto reset_timeouts_if_needed = [&] {
@@ -507,7 +534,7 @@ void scheduled_actor::quit(error x) {
 auto scheduled_actor::inbound_stream_metrics(type_id_t type)
   -> inbound_stream_metrics_t {
   if (!has_metrics_enabled())
-    return {nullptr, nullptr};
+    return {};
   if (auto i = inbound_stream_metrics_.find(type);
       i != inbound_stream_metrics_.end())
     return i->second;
@@ -515,9 +542,14 @@ auto scheduled_actor::inbound_stream_metrics(type_id_t type)
   auto actor_name = string_view{actor_name_cstr, strlen(actor_name_cstr)};
   auto tname = query_type_name(type);
   auto fs = system().actor_metric_families().stream;
+  std::initializer_list<telemetry::label_view> labels{{"name", actor_name},
+                                                      {"type", tname}};
   inbound_stream_metrics_t result{
-    fs.processed_elements->get_or_add({{"name", actor_name}, {"type", tname}}),
-    fs.input_buffer_size->get_or_add({{"name", actor_name}, {"type", tname}}),
+    fs.processed_elements->get_or_add(labels),
+    fs.input_buffer_size->get_or_add(labels),
+    fs.batch_size->get_or_add(labels),
+    fs.batch_latency->get_or_add(labels),
+    fs.credit_round_trip_time->get_or_add(labels),
   };
   inbound_stream_metrics_.emplace(type, result);
   return result;
@@ -526,7 +558,7 @@ auto scheduled_actor::inbound_stream_metrics(type_id_t type)
 auto scheduled_actor::outbound_stream_metrics(type_id_t type)
   -> outbound_stream_metrics_t {
   if (!has_metrics_enabled())
-    return {nullptr, nullptr};
+    return {};
   if (auto i = outbound_stream_metrics_.find(type);
       i != outbound_stream_metrics_.end())
     return i->second;
@@ -534,9 +566,12 @@ auto scheduled_actor::outbound_stream_metrics(type_id_t type)
   auto actor_name = string_view{actor_name_cstr, strlen(actor_name_cstr)};
   auto tname = query_type_name(type);
   auto fs = system().actor_metric_families().stream;
+  std::initializer_list<telemetry::label_view> labels{{"name", actor_name},
+                                                      {"type", tname}};
   outbound_stream_metrics_t result{
-    fs.pushed_elements->get_or_add({{"name", actor_name}, {"type", tname}}),
-    fs.output_buffer_size->get_or_add({{"name", actor_name}, {"type", tname}}),
+    fs.pushed_elements->get_or_add(labels),
+    fs.output_buffer_size->get_or_add(labels),
+    fs.credit_starvation_time->get_or_add(labels),
   };
   outbound_stream_metrics_.emplace(type, result);
   return result;
@@ -587,6 +622,11 @@ uint64_t scheduled_actor::set_stream_timeout(actor_clock::time_point x) {
     CAF_LOG_DEBUG("drop infinite timeout");
     return 0;
   }
+  // Do not touch the clock if an earlier timeout is already pending.
+  if (stream_timeout_ <= x) {
+    CAF_LOG_DEBUG("keep pending stream timeout");
+    return 0;
+  }
   // Do not request a timeout if all streams are idle.
   std::vector<stream_manager_ptr> mgrs;
   for (auto& kvp : stream_managers_)
@@ -599,6 +639,7 @@ uint64_t scheduled_actor::set_stream_timeout(actor_clock::time_point x) {
     return 0;
   }
   // Delegate call.
+  stream_timeout_ = x;
   return set_timeout("stream", x);
 }
 
@@ -647,6 +688,7 @@ scheduled_actor::categorize(mailbox_element& x) {
         bhvr_stack_.back().handle_timeout();
     } else if (tm.type == "stream") {
       CAF_LOG_DEBUG("handle stream timeout message");
+      stream_timeout_ = actor_clock::time_point::max();
       set_stream_timeout(advance_streams(clock().now()));
     } else {
       // Drop. Other types not supported yet.
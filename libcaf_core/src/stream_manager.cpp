@@ -41,6 +41,8 @@ stream_manager::stream_manager(scheduled_actor* selfptr, stream_priority prio)
   auto& cfg = selfptr->config();
   max_batch_delay_ = get_or(cfg, "caf.stream.max-batch-delay",
                             defaults::stream::max_batch_delay);
+  max_pending_bytes_ = get_or(cfg, "caf.stream.max-pending-bytes",
+                              defaults::stream::max_pending_bytes);
 }
 
 stream_manager::~stream_manager() {
@@ -85,7 +87,7 @@ bool stream_manager::handle(stream_slots slots, upstream_msg::ack_open& x) {
     return false;
   }
   if (x.rebind_from != x.rebind_to) {
-    ptr->hdl = x.rebind_to;
+    ptr->rebind(x.rebind_to);
   }
   ptr->slots.receiver = slots.sender;
   ptr->open_credit = x.initial_demand;
@@ -99,7 +101,7 @@ void stream_manager::handle(stream_slots slots, upstream_msg::ack_batch& x) {
   CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(x));
   CAF_ASSERT(x.desired_batch_size > 0);
   if (auto path = out().path(slots.receiver); path != nullptr) {
-    path->open_credit += x.new_capacity;
+    path->grant_credit(x.new_capacity, max_pending_bytes_);
     CAF_ASSERT(path->open_credit >= 0);
     path->set_desired_batch_size(x.desired_batch_size);
     path->next_ack_id = x.acknowledged_id + 1;
@@ -299,6 +301,11 @@ stream_manager::add_unchecked_inbound_path_impl(type_id_t input_type,
 }
 
 void stream_manager::tick(time_point now) {
+  advance_time(now);
+  // Remote sinks may receive withheld credit after their connection drained.
+  if (max_pending_bytes_ > 0)
+    out().for_each_path(
+      [this](outbound_path& x) { x.release_credit(max_pending_bytes_); });
   do {
     out().tick(now, max_batch_delay_);
     for (auto path : inbound_paths_)
@@ -318,6 +325,10 @@ void stream_manager::finalize(const error&) {
   // nop
 }
 
+void stream_manager::advance_time(time_point) {
+  // nop
+}
+
 void stream_manager::output_closed(error) {
   // nop
 }
@@ -0,0 +1,37 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/telemetry/allocation_counter.hpp"
+
+namespace caf::telemetry {
+
+namespace {
+
+thread_local uint64_t allocated_bytes_per_thread;
+
+} // namespace
+
+void count_allocation(size_t bytes) noexcept {
+  allocated_bytes_per_thread += bytes;
+}
+
+uint64_t allocated_bytes() noexcept {
+  return allocated_bytes_per_thread;
+}
+
+} // namespace caf::telemetry
@@ -18,7 +18,9 @@
 
 #include "caf/telemetry/collector/prometheus.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <ctime>
 #include <type_traits>
 
@@ -54,6 +56,11 @@ struct separator_to_underline {
   string_view str;
 };
 
+// Renders the name of a metric family without the suffix `_total`.
+struct base_name {
+  const metric_family* family;
+};
+
 void append(prometheus::char_buffer&) {
   // End of recursion.
 }
@@ -74,6 +81,9 @@ template <class T, class... Ts>
 std::enable_if_t<std::is_integral<T>::value>
 append(prometheus::char_buffer& buf, T val, Ts&&... xs);
 
+template <class... Ts>
+void append(prometheus::char_buffer&, base_name, Ts&&...);
+
 template <class... Ts>
 void append(prometheus::char_buffer&, const metric_family*, Ts&&...);
 
@@ -139,13 +149,19 @@ append(prometheus::char_buffer& buf, T val, Ts&&... xs) {
   append(buf, std::forward<Ts>(xs)...);
 }
 
+template <class... Ts>
+void append(prometheus::char_buffer& buf, base_name x, Ts&&... xs) {
+  append(buf, separator_to_underline{x.family->prefix()}, '_',
+         separator_to_underline{x.family->name()});
+  if (x.family->unit() != "1"_sv)
+    append(buf, '_', x.family->unit());
+  append(buf, std::forward<Ts>(xs)...);
+}
+
 template <class... Ts>
 void append(prometheus::char_buffer& buf, const metric_family* family,
             Ts&&... xs) {
-  append(buf, separator_to_underline{family->prefix()}, '_',
-         separator_to_underline{family->name()});
-  if (family->unit() != "1"_sv)
-    append(buf, '_', family->unit());
+  append(buf, base_name{family});
   if (family->is_sum())
     append(buf, "_total"_sv);
   append(buf, std::forward<Ts>(xs)...);
@@ -183,16 +199,95 @@ void append(prometheus::char_buffer& buf, const prometheus::char_buffer& x,
   append(buf, std::forward<Ts>(xs)...);
 }
 
+uint64_t to_bits(int64_t x) {
+  return static_cast<uint64_t>(x);
+}
+
+uint64_t to_bits(double x) {
+  uint64_t result;
+  memcpy(&result, &x, sizeof(double));
+  return result;
+}
+
+int64_t int_from_bits(uint64_t x) {
+  return static_cast<int64_t>(x);
+}
+
+double dbl_from_bits(uint64_t x) {
+  double result;
+  memcpy(&result, &x, sizeof(double));
+  return result;
+}
+
+template <class ValueType>
+auto make_virtual_metrics(const metric_family* family, const metric* instance,
+                          const histogram<ValueType>* val) {
+  std::vector<prometheus::char_buffer> result;
+  auto add_result = [&](auto&&... xs) {
+    result.emplace_back();
+    append(result.back(), std::forward<decltype(xs)>(xs)...);
+  };
+  auto buckets = val->buckets();
+  auto num_buckets = buckets.size();
+  CAF_ASSERT(num_buckets > 1);
+  auto labels = instance->labels();
+  labels.emplace_back("le", "");
+  result.reserve(num_buckets + 2);
+  size_t index = 0;
+  // Create bucket variable names for 1..N-1.
+  for (; index < num_buckets - 1; ++index) {
+    auto upper_bound = std::to_string(buckets[index].upper_bound);
+    labels.back().value(upper_bound);
+    add_result(family, "_bucket", labels, ' ');
+  }
+  // The last bucket always sets le="+Inf"
+  labels.back().value("+Inf");
+  add_result(family, "_bucket", labels, ' ');
+  labels.pop_back();
+  add_result(family, "_sum", labels, ' ');
+  add_result(family, "_count", labels, ' ');
+  return result;
+}
+
 } // namespace
 
+// -- properties ---------------------------------------------------------------
+
+void prometheus::output_format(format value) {
+  if (format_ == value)
+    return;
+  format_ = value;
+  // All cached text depends on the format.
+  buf_.clear();
+  families_.clear();
+  virtual_metrics_.clear();
+}
+
+string_view prometheus::content_type() const noexcept {
+  if (format_ == format::openmetrics)
+    return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+  return "text/plain; version=0.0.4";
+}
+
+// -- collect API --------------------------------------------------------------
+
 string_view prometheus::collect_from(const metric_registry& registry,
                                      time_t now) {
   if (!buf_.empty() && now - now_ < min_scrape_interval_)
     return {buf_.data(), buf_.size()};
   buf_.clear();
   now_ = now;
+  // Prometheus expects milliseconds, OpenMetrics expects seconds.
+  timestamp_.clear();
+  if (format_ == format::openmetrics)
+    append(timestamp_, ' ', static_cast<int64_t>(now), '\n');
+  else
+    append(timestamp_, ' ', ms_timestamp{now}, '\n');
   registry.collect(*this);
+  finalize_current_family();
   current_family_ = nullptr;
+  if (format_ == format::openmetrics)
+    append(buf_, "# EOF\n"_sv);
   return {buf_.data(), buf_.size()};
 }
 
@@ -200,32 +295,34 @@ string_view prometheus::collect_from(const metric_registry& registry) {
   return collect_from(registry, time(NULL));
 }
 
+// -- call operators for the metric registry -----------------------------------
+
 void prometheus::operator()(const metric_family* family, const metric* instance,
                             const dbl_counter* counter) {
-  set_current_family(family, "counter");
-  append(buf_, family, instance, ' ', counter->value(), ' ', ms_timestamp{now_},
-         '\n');
+  set_current_family(family, metric_type::dbl_counter);
+  add_instance(instance);
+  add_value(to_bits(counter->value()));
 }
 
 void prometheus::operator()(const metric_family* family, const metric* instance,
                             const int_counter* counter) {
-  set_current_family(family, "counter");
-  append(buf_, family, instance, ' ', counter->value(), ' ', ms_timestamp{now_},
-         '\n');
+  set_current_family(family, metric_type::int_counter);
+  add_instance(instance);
+  add_value(to_bits(counter->value()));
 }
 
 void prometheus::operator()(const metric_family* family, const metric* instance,
                             const dbl_gauge* gauge) {
-  set_current_family(family, "gauge");
-  append(buf_, family, instance, ' ', gauge->value(), ' ', ms_timestamp{now_},
-         '\n');
+  set_current_family(family, metric_type::dbl_gauge);
+  add_instance(instance);
+  add_value(to_bits(gauge->value()));
 }
 
 void prometheus::operator()(const metric_family* family, const metric* instance,
                             const int_gauge* gauge) {
-  set_current_family(family, "gauge");
-  append(buf_, family, instance, ' ', gauge->value(), ' ', ms_timestamp{now_},
-         '\n');
+  set_current_family(family, metric_type::int_gauge);
+  add_instance(instance);
+  add_value(to_bits(gauge->value()));
 }
 
 void prometheus::operator()(const metric_family* family, const metric* instance,
@@ -238,75 +335,195 @@ void prometheus::operator()(const metric_family* family, const metric* instance,
   append_histogram(family, instance, val);
 }
 
+// -- utility functions --------------------------------------------------------
+
 void prometheus::set_current_family(const metric_family* family,
-                                    string_view prometheus_type) {
+                                    metric_type type) {
   if (current_family_ == family)
     return;
+  finalize_current_family();
   current_family_ = family;
-  auto i = meta_info_.find(family);
-  if (i == meta_info_.end()) {
-    i = meta_info_.emplace(family, char_buffer{}).first;
-    if (!family->helptext().empty())
-      append(i->second, "# HELP ", family, ' ', family->helptext(), '\n');
-    append(i->second, "# TYPE ", family, ' ', prometheus_type, '\n');
+  // Note: references to elements of an unordered map remain valid when
+  //       inserting new elements.
+  auto [i, added] = families_.emplace(family, family_cache{});
+  current_entry_ = &i->second;
+  if (added || current_entry_->type != type) {
+    current_entry_->type = type;
+    current_entry_->dirty = true;
   }
-  buf_.insert(buf_.end(), i->second.begin(), i->second.end());
+  current_entry_->instance_pos = 0;
+  current_entry_->value_pos = 0;
 }
 
-namespace {
+void prometheus::add_instance(const metric* instance) {
+  auto& entry = *current_entry_;
+  auto pos = entry.instance_pos++;
+  if (pos < entry.instances.size()) {
+    if (entry.instances[pos] != instance) {
+      entry.instances[pos] = instance;
+      entry.dirty = true;
+    }
+  } else {
+    entry.instances.emplace_back(instance);
+    entry.dirty = true;
+  }
+}
 
-template <class ValueType>
-auto make_virtual_metrics(const metric_family* family, const metric* instance,
-                          const histogram<ValueType>* val) {
-  std::vector<prometheus::char_buffer> result;
-  auto add_result = [&](auto&&... xs) {
-    result.emplace_back();
-    append(result.back(), std::forward<decltype(xs)>(xs)...);
-  };
-  auto buckets = val->buckets();
-  auto num_buckets = buckets.size();
-  CAF_ASSERT(num_buckets > 1);
-  auto labels = instance->labels();
-  labels.emplace_back("le", "");
-  result.reserve(num_buckets + 2);
-  size_t index = 0;
-  // Create bucket variable names for 1..N-1.
-  for (; index < num_buckets - 1; ++index) {
-    auto upper_bound = std::to_string(buckets[index].upper_bound);
-    labels.back().value(upper_bound);
-    add_result(family, "_bucket", labels, ' ');
+void prometheus::add_value(uint64_t bits) {
+  auto& entry = *current_entry_;
+  auto pos = entry.value_pos++;
+  if (pos < entry.values.size()) {
+    if (entry.values[pos] != bits) {
+      entry.values[pos] = bits;
+      entry.dirty = true;
+    }
+  } else {
+    entry.values.emplace_back(bits);
+    entry.dirty = true;
   }
-  // The last bucket always sets le="+Inf"
-  labels.back().value("+Inf");
-  add_result(family, "_bucket", labels, ' ');
-  labels.pop_back();
-  add_result(family, "_sum", labels, ' ');
-  add_result(family, "_count", labels, ' ');
-  return result;
 }
 
-} // namespace
+void prometheus::finalize_current_family() {
+  if (current_entry_ == nullptr)
+    return;
+  auto& entry = *current_entry_;
+  current_entry_ = nullptr;
+  if (entry.instance_pos != entry.instances.size()
+      || entry.value_pos != entry.values.size()) {
+    entry.instances.resize(entry.instance_pos);
+    entry.values.resize(entry.value_pos);
+    entry.dirty = true;
+  }
+  if (entry.dirty) {
+    render(current_family_, entry);
+    entry.dirty = false;
+  }
+  // Copy the cached text line by line and add the timestamp to each sample.
+  auto first = entry.text.begin();
+  auto last = entry.text.end();
+  while (first != last) {
+    auto eol = std::find(first, last, '\n');
+    if (*first == '#') {
+      buf_.insert(buf_.end(), first, eol + 1);
+    } else {
+      buf_.insert(buf_.end(), first, eol);
+      buf_.insert(buf_.end(), timestamp_.begin(), timestamp_.end());
+    }
+    first = eol + 1;
+  }
+}
+
+const std::vector<prometheus::char_buffer>&
+prometheus::line_prefixes(const metric_family* family, const metric* instance,
+                          metric_type type) {
+  auto i = virtual_metrics_.find(instance);
+  if (i != virtual_metrics_.end())
+    return i->second;
+  // Histograms add their line prefixes while collecting, since we need the
+  // upper bounds of the buckets.
+  CAF_ASSERT(type != metric_type::dbl_histogram
+             && type != metric_type::int_histogram);
+  std::vector<char_buffer> prefixes(1);
+  if (format_ == format::openmetrics
+      && (type == metric_type::dbl_counter || type == metric_type::int_counter))
+    append(prefixes[0], base_name{family}, "_total"_sv, instance, ' ');
+  else
+    append(prefixes[0], family, instance, ' ');
+  return virtual_metrics_.emplace(instance, std::move(prefixes)).first->second;
+}
+
+void prometheus::render(const metric_family* family, family_cache& entry) {
+  auto& text = entry.text;
+  text.clear();
+  string_view type_name;
+  switch (entry.type) {
+    case metric_type::dbl_counter:
+    case metric_type::int_counter:
+      type_name = "counter";
+      break;
+    case metric_type::dbl_gauge:
+    case metric_type::int_gauge:
+      type_name = "gauge";
+      break;
+    default:
+      type_name = "histogram";
+  }
+  // OpenMetrics requires the suffix `_total` for counter samples, but not for
+  // the name of the family.
+  auto om = format_ == format::openmetrics;
+  auto append_name = [&] {
+    if (om && type_name == "counter"_sv)
+      append(text, base_name{family});
+    else
+      append(text, family);
+  };
+  if (!family->helptext().empty()) {
+    append(text, "# HELP "_sv);
+    append_name();
+    append(text, ' ', family->helptext(), '\n');
+  }
+  append(text, "# TYPE "_sv);
+  append_name();
+  append(text, ' ', type_name, '\n');
+  if (om && family->unit() != "1"_sv) {
+    append(text, "# UNIT "_sv);
+    append_name();
+    append(text, ' ', family->unit(), '\n');
+  }
+  auto value = entry.values.begin();
+  for (auto instance : entry.instances) {
+    auto& prefixes = line_prefixes(family, instance, entry.type);
+    switch (entry.type) {
+      case metric_type::dbl_counter:
+      case metric_type::dbl_gauge:
+        append(text, prefixes[0], dbl_from_bits(*value++), '\n');
+        break;
+      case metric_type::int_counter:
+      case metric_type::int_gauge:
+        append(text, prefixes[0], int_from_bits(*value++), '\n');
+        break;
+      case metric_type::dbl_histogram: {
+        // Counts of double histograms appear as double values.
+        auto num_buckets = prefixes.size() - 2;
+        auto count = 0.;
+        for (size_t index = 0; index < num_buckets; ++index) {
+          count = static_cast<double>(int_from_bits(*value++));
+          append(text, prefixes[index], count, '\n');
+        }
+        append(text, prefixes[num_buckets], dbl_from_bits(*value++), '\n');
+        append(text, prefixes[num_buckets + 1], count, '\n');
+        break;
+      }
+      default: {
+        auto num_buckets = prefixes.size() - 2;
+        auto count = int64_t{0};
+        for (size_t index = 0; index < num_buckets; ++index) {
+          count = int_from_bits(*value++);
+          append(text, prefixes[index], count, '\n');
+        }
+        append(text, prefixes[num_buckets], int_from_bits(*value++), '\n');
+        append(text, prefixes[num_buckets + 1], count, '\n');
+      }
+    }
+  }
+}
 
 template <class ValueType>
 void prometheus::append_histogram(const metric_family* family,
                                   const metric* instance,
                                   const histogram<ValueType>* val) {
-  auto i = virtual_metrics_.find(instance);
-  if (i == virtual_metrics_.end()) {
-    auto metrics = make_virtual_metrics(family, instance, val);
-    i = virtual_metrics_.emplace(instance, std::move(metrics)).first;
-  }
-  set_current_family(family, "histogram");
-  auto& vm = i->second;
-  auto buckets = val->buckets();
-  auto acc = ValueType{0};
-  auto index = size_t{0};
-  for (; index < buckets.size(); ++index) {
-    acc += buckets[index].count.value();
-    append(buf_, vm[index], acc, ' ', ms_timestamp{now_}, '\n');
+  set_current_family(family, histogram<ValueType>::runtime_type);
+  if (virtual_metrics_.count(instance) == 0)
+    virtual_metrics_.emplace(instance,
+                             make_virtual_metrics(family, instance, val));
+  add_instance(instance);
+  // Store cumulative counts, since the output only contains those.
+  auto acc = int64_t{0};
+  for (auto& bucket : val->buckets()) {
+    acc += bucket.count.value();
+    add_value(to_bits(acc));
   }
-  append(buf_, vm[index++], val->sum(), ' ', ms_timestamp{now_}, '\n');
-  append(buf_, vm[index++], acc, ' ', ms_timestamp{now_}, '\n');
+  add_value(to_bits(val->sum()));
 }
 
 } // namespace caf::telemetry::collector
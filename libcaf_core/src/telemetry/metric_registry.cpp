@@ -20,6 +20,7 @@
 
 #include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
+#include "caf/hash/fnv.hpp"
 #include "caf/telemetry/dbl_gauge.hpp"
 #include "caf/telemetry/int_gauge.hpp"
 #include "caf/telemetry/metric_family_impl.hpp"
@@ -49,15 +50,30 @@ metric_registry::~metric_registry() {
   // nop
 }
 
+namespace {
+
+size_t family_hash(string_view prefix, string_view name) noexcept {
+  return hash::fnv<size_t>::compute(prefix, name);
+}
+
+} // namespace
+
 metric_family* metric_registry::fetch(const string_view& prefix,
-                                      const string_view& name) {
-  auto eq = [&](const auto& ptr) {
-    return ptr->prefix() == prefix && ptr->name() == name;
+                                      const string_view& name,
+                                      std::unique_lock<std::mutex>& guard) {
+  auto eq = [&](const metric_family& x) {
+    return x.prefix() == prefix && x.name() == name;
   };
-  if (auto i = std::find_if(families_.begin(), families_.end(), eq);
-      i != families_.end())
-    return i->get();
-  return nullptr;
+  auto hash = family_hash(prefix, name);
+  if (auto ptr = index_.find(hash, eq))
+    return ptr;
+  guard.lock();
+  return index_.find(hash, eq);
+}
+
+void metric_registry::add(std::unique_ptr<metric_family> ptr) {
+  index_.insert(family_hash(ptr->prefix(), ptr->name()), ptr.get());
+  families_.emplace_back(std::move(ptr));
 }
 
 std::vector<std::string>
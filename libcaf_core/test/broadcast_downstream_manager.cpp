@@ -518,4 +518,32 @@ CAF_TEST(two_paths_different_sizes_without_force) {
   }
 }
 
+CAF_TEST(paths_without_filter_share_batches) {
+  // Give alice 100 elements to send and paths to bob and carl with the same
+  // desired batch size.
+  alice.add_path_to(bob, 10);
+  alice.add_path_to(carl, 10);
+  for (int i = 1; i <= 100; ++i)
+    alice.mgr.out().push(i);
+  alice.new_round(25, false);
+  CAF_REQUIRE_EQUAL(bob.mbox.size(), 2u);
+  CAF_REQUIRE_EQUAL(carl.mbox.size(), 2u);
+  // Bob and carl must receive the very same payload instead of copies.
+  auto payload = [](const message& msg) {
+    auto& dm = msg.get_as<downstream_msg>(0);
+    return get<downstream_msg::batch>(dm.content).xs.cptr();
+  };
+  for (size_t i = 0; i < 2; ++i)
+    CAF_CHECK_EQUAL(payload(bob.mbox[i]), payload(carl.mbox[i]));
+  CAF_CHECK_EQUAL(batches(bob), batches_type({BATCH(1, 10), BATCH(11, 20)}));
+  CAF_CHECK_EQUAL(batches(carl), batches_type({BATCH(1, 10), BATCH(11, 20)}));
+  CAF_CHECK_EQUAL(alice.credit_for(bob), 5u);
+  CAF_CHECK_EQUAL(alice.credit_for(carl), 5u);
+  // Leftover elements remain in the central buffer until forced out.
+  alice.new_round(0, true);
+  CAF_CHECK_EQUAL(batches(bob), batches_type({BATCH(21, 25)}));
+  CAF_CHECK_EQUAL(batches(carl), batches_type({BATCH(21, 25)}));
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 75u);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
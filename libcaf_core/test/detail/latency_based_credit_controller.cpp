@@ -0,0 +1,128 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.latency_based_credit_controller
+
+#include "caf/detail/latency_based_credit_controller.hpp"
+
+#include "core-test.hpp"
+
+using namespace caf;
+
+using controller = detail::latency_based_credit_controller;
+
+namespace {
+
+struct config : actor_system_config {
+  config() {
+    set("caf.stream.latency-based-policy.target-delay", timespan{10'000'000});
+    set("caf.stream.latency-based-policy.min-buffer-size", 16);
+    set("caf.stream.latency-based-policy.max-buffer-size", 256);
+    set("caf.stream.latency-based-policy.calibration-interval", 5);
+  }
+};
+
+struct fixture : test_coordinator_fixture<config> {
+  fixture() {
+    hdl = sys.spawn([] { return behavior{}; });
+    self = static_cast<local_actor*>(actor_cast<abstract_actor*>(hdl));
+  }
+
+  // Feeds `n` batches with the given queueing delay to `ctrl`.
+  void feed(controller& ctrl, timespan delay, int n = 5) {
+    for (int i = 0; i < n; ++i) {
+      downstream_msg::batch x{1, make_message(std::vector<int>{1}), i,
+                              make_timestamp() - delay};
+      ctrl.before_processing(x);
+    }
+  }
+
+  actor hdl;
+
+  local_actor* self;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(latency_based_credit_controller_tests, fixture)
+
+CAF_TEST(the controller starts with the minimum buffer size) {
+  controller ctrl{self};
+  auto [max_credit, batch_size, next_calibration] = ctrl.init();
+  CAF_CHECK_EQUAL(max_credit, 16);
+  CAF_CHECK_EQUAL(batch_size, 2);
+  CAF_CHECK_EQUAL(next_calibration, 5);
+  CAF_CHECK(ctrl.slow_start());
+}
+
+CAF_TEST(the controller doubles the buffer while delays stay low) {
+  controller ctrl{self};
+  ctrl.init();
+  feed(ctrl, timespan{0});
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 32);
+  feed(ctrl, timespan{0});
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 64);
+  for (int i = 0; i < 5; ++i) {
+    feed(ctrl, timespan{0});
+    ctrl.calibrate();
+  }
+  CAF_CHECK_EQUAL(ctrl.buffer_size(), 256);
+}
+
+CAF_TEST(the controller halves the buffer when consumers lag) {
+  controller ctrl{self};
+  ctrl.init();
+  for (int i = 0; i < 3; ++i) {
+    feed(ctrl, timespan{0});
+    ctrl.calibrate();
+  }
+  CAF_REQUIRE_EQUAL(ctrl.buffer_size(), 128);
+  feed(ctrl, std::chrono::milliseconds(50));
+  auto calibration = ctrl.calibrate();
+  CAF_CHECK_EQUAL(calibration.max_credit, 64);
+  CAF_CHECK_EQUAL(calibration.batch_size, 8);
+  CAF_CHECK(!ctrl.slow_start());
+  CAF_MESSAGE("after leaving slow start, the buffer grows by one batch");
+  feed(ctrl, timespan{0});
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 72);
+  CAF_MESSAGE("the buffer never shrinks below the minimum");
+  for (int i = 0; i < 10; ++i) {
+    feed(ctrl, std::chrono::milliseconds(50));
+    ctrl.calibrate();
+  }
+  CAF_CHECK_EQUAL(ctrl.buffer_size(), 16);
+}
+
+CAF_TEST(the controller uses the minimum delay per interval) {
+  controller ctrl{self};
+  ctrl.init();
+  feed(ctrl, std::chrono::milliseconds(50), 4);
+  feed(ctrl, timespan{0}, 1);
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 32);
+}
+
+CAF_TEST(the controller keeps its buffer when delays are near the target) {
+  controller ctrl{self};
+  ctrl.init();
+  feed(ctrl, std::chrono::milliseconds(7));
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 16);
+  CAF_MESSAGE("calibrating without samples keeps the buffer as well");
+  CAF_CHECK_EQUAL(ctrl.calibrate().max_credit, 16);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,122 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.mailbox_sampler
+
+#include "caf/detail/mailbox_sampler.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/telemetry/int_gauge.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct testee_state {
+  static inline const char* name = "testee";
+};
+
+behavior testee_impl(stateful_actor<testee_state>*) {
+  return {
+    [](int) {
+      // nop
+    },
+  };
+}
+
+struct config : actor_system_config {
+  config() {
+    put(content, "caf.mailbox-sampler.interval", timespan{1'000'000'000});
+    put(content, "caf.mailbox-sampler.top-k", size_t{2});
+  }
+};
+
+struct fixture : test_coordinator_fixture<config> {
+  fixture() {
+    uut = sys.mailbox_sampler();
+    sampler = sys.registry().get<actor>("MailboxSampler");
+  }
+
+  // Sends `num` messages to `hdl` without processing them.
+  void fill(const actor& hdl, int num) {
+    for (int i = 0; i < num; ++i)
+      self->send(hdl, i);
+  }
+
+  detail::mailbox_sampler* uut;
+  actor sampler;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(mailbox_sampler_tests, fixture)
+
+CAF_TEST(the sampler is available when configuring an interval) {
+  CAF_REQUIRE_NOT_EQUAL(uut, nullptr);
+  CAF_CHECK_EQUAL(uut->top_k(), 2u);
+  CAF_CHECK(sampler != nullptr);
+}
+
+CAF_TEST(the sampler reports the actors with the deepest mailboxes) {
+  run();
+  auto t1 = sys.spawn(testee_impl);
+  auto t2 = sys.spawn(testee_impl);
+  auto t3 = sys.spawn(testee_impl);
+  fill(t1, 1);
+  fill(t2, 3);
+  fill(t3, 2);
+  auto hot_actors = uut->sample();
+  std::vector<hot_actor> expected{{t2.id(), "testee", 3},
+                                  {t3.id(), "testee", 2}};
+  CAF_CHECK_EQUAL(hot_actors, expected);
+  auto gauge = sys.metrics()
+                 .gauge_family("caf.system", "hot-actor-mailbox-size", {"name"},
+                               "")
+                 ->get_or_add({{"name", "testee"}});
+  CAF_CHECK_EQUAL(gauge->value(), 3);
+  CAF_MESSAGE("processing all messages empties the list of hot actors");
+  run();
+  CAF_CHECK_EQUAL(uut->sample(), std::vector<hot_actor>{});
+  CAF_CHECK_EQUAL(gauge->value(), 0);
+}
+
+CAF_TEST(the sampler actor answers introspection requests) {
+  run();
+  auto testee = sys.spawn(testee_impl);
+  fill(testee, 3);
+  self->send(sampler, tick_atom_v);
+  expect((tick_atom), from(self).to(sampler));
+  self->send(sampler, get_atom_v);
+  expect((get_atom), from(self).to(sampler));
+  std::vector<hot_actor> expected{{testee.id(), "testee", 3}};
+  expect((std::vector<hot_actor>),
+         from(sampler).to(self).with(std::move(expected)));
+}
+
+CAF_TEST(terminated actors no longer show up) {
+  run();
+  auto testee = sys.spawn(testee_impl);
+  fill(testee, 3);
+  CAF_CHECK_EQUAL(uut->sample().size(), 1u);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+  run();
+  CAF_CHECK_EQUAL(uut->sample(), std::vector<hot_actor>{});
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.read_mostly_index
+
+#include "caf/detail/read_mostly_index.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_index = detail::read_mostly_index<int>;
+
+// Maps all values to a few hash values to force collisions.
+size_t bad_hash(int x) {
+  return static_cast<size_t>(x % 3);
+}
+
+} // namespace
+
+CAF_TEST(indexes find all inserted values) {
+  std::vector<std::unique_ptr<int>> values;
+  int_index uut;
+  CAF_CHECK_EQUAL(uut.find(0, [](int) { return true; }), nullptr);
+  for (int i = 0; i < 100; ++i) {
+    values.emplace_back(std::make_unique<int>(i));
+    uut.insert(bad_hash(i), values.back().get());
+  }
+  CAF_CHECK_EQUAL(uut.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    auto ptr = uut.find(bad_hash(i), [i](int x) { return x == i; });
+    if (CAF_CHECK_NOT_EQUAL(ptr, nullptr))
+      CAF_CHECK_EQUAL(ptr, values[static_cast<size_t>(i)].get());
+  }
+  CAF_CHECK_EQUAL(uut.find(bad_hash(100), [](int x) { return x == 100; }),
+                  nullptr);
+}
+
+CAF_TEST(readers may run concurrently to a writer) {
+  constexpr int num_values = 10'000;
+  std::vector<std::unique_ptr<int>> values;
+  for (int i = 0; i < num_values; ++i)
+    values.emplace_back(std::make_unique<int>(i));
+  int_index uut;
+  std::atomic<int> inserted{0};
+  std::atomic<size_t> errors{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+    readers.emplace_back([&] {
+      while (inserted.load() < num_values) {
+        // Every value inserted before our load must be visible.
+        auto n = inserted.load();
+        for (int x = 0; x < n; x += 97)
+          if (uut.find(static_cast<size_t>(x), [x](int y) { return x == y; })
+              == nullptr)
+            ++errors;
+      }
+    });
+  for (int i = 0; i < num_values; ++i) {
+    uut.insert(static_cast<size_t>(i), values[static_cast<size_t>(i)].get());
+    inserted.store(i + 1);
+  }
+  for (auto& t : readers)
+    t.join();
+  CAF_CHECK_EQUAL(errors.load(), 0u);
+}
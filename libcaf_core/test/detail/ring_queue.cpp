@@ -0,0 +1,141 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.ring_queue
+
+#include "caf/detail/ring_queue.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_queue = detail::ring_queue<int>;
+
+std::vector<int> iota(int first, int last) {
+  std::vector<int> result(static_cast<size_t>(last - first));
+  std::iota(result.begin(), result.end(), first);
+  return result;
+}
+
+template <class T>
+std::vector<T> to_vector(const detail::ring_queue<T>& xs) {
+  return {xs.begin(), xs.end()};
+}
+
+struct fixture {
+  int_queue q;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(ring_queue_tests, fixture)
+
+CAF_TEST(default constructed queues are empty) {
+  CAF_CHECK(q.empty());
+  CAF_CHECK_EQUAL(q.size(), 0u);
+  CAF_CHECK_EQUAL(q.capacity(), 0u);
+  CAF_CHECK(q.begin() == q.end());
+}
+
+CAF_TEST(queues grow to the next power of two) {
+  for (int i = 0; i < 17; ++i)
+    q.push_back(i);
+  CAF_CHECK_EQUAL(q.size(), 17u);
+  CAF_CHECK_EQUAL(q.capacity(), 32u);
+  CAF_CHECK_EQUAL(to_vector(q), iota(0, 17));
+  auto xs = iota(17, 100);
+  q.insert(q.end(), xs.begin(), xs.end());
+  CAF_CHECK_EQUAL(q.capacity(), 128u);
+  CAF_CHECK_EQUAL(to_vector(q), iota(0, 100));
+}
+
+CAF_TEST(queues wrap around without reallocating) {
+  for (int i = 0; i < 16; ++i)
+    q.push_back(i);
+  q.erase(q.begin(), q.begin() + 10);
+  CAF_CHECK_EQUAL(q.front(), 10);
+  for (int i = 16; i < 26; ++i)
+    q.push_back(i);
+  CAF_CHECK_EQUAL(q.capacity(), 16u);
+  CAF_CHECK_EQUAL(to_vector(q), iota(10, 26));
+  CAF_CHECK_EQUAL(q.back(), 25);
+  CAF_CHECK_EQUAL(q[3], 13);
+  CAF_CHECK_EQUAL(q.end() - q.begin(), 16);
+}
+
+CAF_TEST(take_front moves elements across the wrap-around point) {
+  for (int i = 0; i < 16; ++i)
+    q.push_back(i);
+  q.erase(q.begin(), q.begin() + 12);
+  for (int i = 16; i < 24; ++i)
+    q.push_back(i);
+  std::vector<int> xs;
+  q.take_front(10, xs);
+  CAF_CHECK_EQUAL(xs, iota(12, 22));
+  CAF_CHECK_EQUAL(to_vector(q), iota(22, 24));
+  q.take_front(2, xs);
+  CAF_CHECK_EQUAL(xs, iota(12, 24));
+  CAF_CHECK(q.empty());
+}
+
+CAF_TEST(queues insert and erase elements at arbitrary positions) {
+  for (int i = 0; i < 16; ++i)
+    q.push_back(i);
+  // Move the head close to the end of the buffer to cover the wrap-around.
+  q.erase(q.begin(), q.begin() + 12);
+  for (int i = 16; i < 22; ++i)
+    q.push_back(i);
+  CAF_REQUIRE_EQUAL(to_vector(q), iota(12, 22));
+  auto xs = std::vector<int>{100, 101, 102};
+  auto i = q.insert(q.begin() + 3, xs.begin(), xs.end());
+  CAF_CHECK_EQUAL(*i, 100);
+  CAF_CHECK_EQUAL(to_vector(q), (std::vector<int>{12, 13, 14, 100, 101, 102,
+                                                  15, 16, 17, 18, 19, 20, 21}));
+  i = q.erase(q.begin() + 3, q.begin() + 6);
+  CAF_CHECK_EQUAL(*i, 15);
+  CAF_CHECK_EQUAL(to_vector(q), iota(12, 22));
+  q.erase(q.begin() + 9);
+  q.erase(q.begin() + 1);
+  CAF_CHECK_EQUAL(to_vector(q),
+                  (std::vector<int>{12, 14, 15, 16, 17, 18, 19, 20}));
+  q.erase(q.end(), q.end());
+  CAF_CHECK_EQUAL(q.size(), 8u);
+}
+
+CAF_TEST(queues destroy non-trivial elements) {
+  detail::ring_queue<std::string> strs;
+  for (int i = 0; i < 20; ++i)
+    strs.emplace_back(std::to_string(i));
+  strs.pop_front();
+  CAF_CHECK_EQUAL(strs.front(), "1");
+  strs.erase(strs.begin() + 1, strs.begin() + 3);
+  CAF_CHECK_EQUAL(strs[1], "4");
+  auto copy = strs;
+  CAF_CHECK_EQUAL(to_vector(copy), to_vector(strs));
+  strs.clear();
+  CAF_CHECK(strs.empty());
+  CAF_CHECK_EQUAL(copy.size(), 17u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.spsc_ringbuffer
+
+#include "caf/detail/spsc_ringbuffer.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_ringbuffer = detail::spsc_ringbuffer<int, 8>;
+
+} // namespace
+
+CAF_TEST(ringbuffers reject new elements when full) {
+  int_ringbuffer buf;
+  CAF_CHECK(buf.empty());
+  for (int i = 0; i < 8; ++i)
+    CAF_CHECK(buf.try_push(i));
+  int x = 8;
+  CAF_CHECK(!buf.try_push(x));
+  CAF_CHECK(buf.try_pop(x));
+  CAF_CHECK_EQUAL(x, 0);
+  x = 8;
+  CAF_CHECK(buf.try_push(x));
+  std::vector<int> xs;
+  CAF_CHECK_EQUAL(buf.drain(xs), 8u);
+  CAF_CHECK_EQUAL(xs, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+  CAF_CHECK(buf.empty());
+  CAF_CHECK(!buf.try_pop(x));
+}
+
+CAF_TEST(producers and consumers may run concurrently) {
+  constexpr int num_values = 100'000;
+  int_ringbuffer buf;
+  std::thread producer{[&buf] {
+    for (int i = 0; i < num_values; ++i) {
+      auto x = i;
+      while (!buf.try_push(x))
+        std::this_thread::yield();
+    }
+  }};
+  std::vector<int> xs;
+  xs.reserve(num_values);
+  while (xs.size() < static_cast<size_t>(num_values))
+    if (buf.drain(xs) == 0)
+      std::this_thread::yield();
+  producer.join();
+  size_t out_of_order = 0;
+  for (int i = 0; i < num_values; ++i)
+    if (xs[static_cast<size_t>(i)] != i)
+      ++out_of_order;
+  CAF_CHECK_EQUAL(out_of_order, 0u);
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE detail.two_stacks_aggregator
+
+#include "caf/detail/two_stacks_aggregator.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <string>
+
+using namespace caf;
+
+namespace {
+
+// Concatenation is associative but not commutative, i.e., any reordering of
+// the values in the queue shows up in the aggregate.
+struct concat {
+  using value_type = std::string;
+
+  value_type identity() const {
+    return {};
+  }
+
+  value_type combine(const value_type& x, const value_type& y) const {
+    return x + y;
+  }
+};
+
+struct fixture {
+  detail::two_stacks_aggregator<concat> uut;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(two_stacks_aggregator_tests, fixture)
+
+CAF_TEST(an empty aggregator returns the identity) {
+  CAF_CHECK(uut.empty());
+  CAF_CHECK_EQUAL(uut.size(), 0u);
+  CAF_CHECK_EQUAL(uut.query(), "");
+}
+
+CAF_TEST(aggregators combine values from oldest to newest) {
+  uut.push("a");
+  uut.push("b");
+  uut.push("c");
+  CAF_CHECK_EQUAL(uut.size(), 3u);
+  CAF_CHECK_EQUAL(uut.query(), "abc");
+  uut.pop();
+  CAF_CHECK_EQUAL(uut.query(), "bc");
+  uut.push("d");
+  CAF_CHECK_EQUAL(uut.query(), "bcd");
+  uut.pop();
+  uut.pop();
+  CAF_CHECK_EQUAL(uut.query(), "d");
+  uut.pop();
+  CAF_CHECK(uut.empty());
+  CAF_CHECK_EQUAL(uut.query(), "");
+}
+
+CAF_TEST(aggregators implement sliding windows) {
+  std::string input = "abcdefghijklmnopqrstuvwxyz";
+  for (size_t i = 0; i < input.size(); ++i) {
+    uut.push(input.substr(i, 1));
+    if (uut.size() > 4)
+      uut.pop();
+    auto first = i < 3 ? 0 : i - 3;
+    CAF_CHECK_EQUAL(uut.query(), input.substr(first, i - first + 1));
+  }
+}
+
+CAF_TEST(clearing an aggregator removes all values) {
+  uut.push("a");
+  uut.push("b");
+  uut.pop();
+  uut.push("c");
+  uut.clear();
+  CAF_CHECK(uut.empty());
+  CAF_CHECK_EQUAL(uut.query(), "");
+  uut.push("d");
+  CAF_CHECK_EQUAL(uut.query(), "d");
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -22,10 +22,16 @@
 
 #include "core-test.hpp"
 
+#include <cstdio>
 #include <ctime>
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "caf/all.hpp"
+#include "caf/detail/get_process_id.hpp"
 
 using namespace caf;
 using namespace std::chrono;
@@ -213,4 +219,97 @@ CAF_TEST(render_fun_prefix) {
   foo::tpl<T>::run();
 }
 
+CAF_TEST(log files with interned sites render to the configured line format) {
+  auto file_name = "logger-test-" + std::to_string(detail::get_process_id())
+                   + ".blog";
+  cfg.set("caf.logger.file.path", file_name);
+  cfg.set("caf.logger.file.intern-sites", true);
+  { // Lifetime scope of the actor system.
+    actor_system sys{cfg};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+      threads.emplace_back([&sys, i] {
+        for (int j = 0; j < 10; ++j) {
+          auto msg = "thread " + std::to_string(i) + " event "
+                     + std::to_string(j);
+          auto e = CAF_LOG_MAKE_EVENT(0, "caf", CAF_LOG_LEVEL_DEBUG, msg);
+          sys.logger().log(std::move(e));
+        }
+      });
+    for (auto& t : threads)
+      t.join();
+  }
+  add(logger::message_field);
+  add(logger::newline_field);
+  std::ifstream in{file_name, std::ios::binary};
+  std::ostringstream out;
+  CAF_CHECK(logger::render_interned_log(in, out, lf));
+  in.close();
+  std::remove(file_name.c_str());
+  auto output = out.str();
+  for (int i = 0; i < 4; ++i) {
+    auto last_pos = std::string::npos;
+    for (int j = 0; j < 10; ++j) {
+      auto line = "thread " + std::to_string(i) + " event "
+                  + std::to_string(j) + "\n";
+      auto pos = output.find(line);
+      if (!CAF_CHECK_NOT_EQUAL(pos, std::string::npos))
+        continue;
+      // Events from the same thread must appear in order.
+      if (last_pos != std::string::npos)
+        CAF_CHECK_GREATER(pos, last_pos);
+      last_pos = pos;
+    }
+  }
+}
+
+CAF_TEST(rendering rejects malformed logs with interned sites) {
+  std::istringstream in{"Xgarbage"};
+  std::ostringstream out;
+  CAF_CHECK(!logger::render_interned_log(in, out, lf));
+}
+
+CAF_TEST(call sites follow runtime changes of verbosity and filters) {
+  // Call sites must outlive all loggers.
+  static logger::call_site info_site{CAF_LOG_LEVEL_INFO, "caf_flow"};
+  static logger::call_site debug_site{CAF_LOG_LEVEL_DEBUG, "caf_flow"};
+  static logger::call_site other_site{CAF_LOG_LEVEL_DEBUG, "caf"};
+  cfg.set("caf.logger.file.verbosity", "info");
+  {
+    actor_system sys{cfg};
+    auto& lg = sys.logger();
+    CAF_CHECK(info_site.enabled());
+    CAF_CHECK(!debug_site.enabled());
+    CAF_MESSAGE("raising the verbosity enables the debug sites");
+    lg.file_verbosity(CAF_LOG_LEVEL_DEBUG);
+    CAF_CHECK_EQUAL(lg.verbosity(), unsigned{CAF_LOG_LEVEL_DEBUG});
+    CAF_CHECK(info_site.enabled());
+    CAF_CHECK(debug_site.enabled());
+    CAF_CHECK(other_site.enabled());
+    CAF_MESSAGE("excluding a component disables all of its sites");
+    lg.file_excluded_components({"caf_flow"});
+    CAF_CHECK(!lg.accepts(CAF_LOG_LEVEL_INFO, "caf_flow"));
+    CAF_CHECK(!info_site.enabled());
+    CAF_CHECK(!debug_site.enabled());
+    CAF_CHECK(other_site.enabled());
+    CAF_MESSAGE("lowering the verbosity disables the debug sites");
+    lg.file_excluded_components({});
+    lg.file_verbosity(CAF_LOG_LEVEL_INFO);
+    CAF_CHECK(info_site.enabled());
+    CAF_CHECK(!debug_site.enabled());
+    CAF_CHECK(!other_site.enabled());
+  }
+  CAF_MESSAGE("call sites turn off after all loggers are gone");
+  CAF_CHECK(!info_site.enabled());
+}
+
+CAF_TEST(runtime changes cannot enable outputs that were quiet at startup) {
+  static logger::call_site site{CAF_LOG_LEVEL_ERROR, "caf"};
+  cfg.set("caf.logger.file.verbosity", "quiet");
+  actor_system sys{cfg};
+  sys.logger().file_verbosity(CAF_LOG_LEVEL_DEBUG);
+  CAF_CHECK_EQUAL(sys.logger().verbosity(), unsigned{CAF_LOG_LEVEL_QUIET});
+  CAF_CHECK(!site.enabled());
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,163 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE mapped_file
+
+#include "caf/mapped_file.hpp"
+
+#include "core-test.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/attach_mapped_file_source.hpp"
+#include "caf/attach_stream_sink.hpp"
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/file_slice.hpp"
+#include "caf/stateful_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t record_size = 16;
+
+constexpr size_t num_records = 100;
+
+TESTEE_SETUP();
+
+VARARGS_TESTEE(file_reader, mapped_file_ptr file, size_t read_ahead) {
+  return {
+    [=](join_atom, actor sink) {
+      attach_mapped_file_source(self, sink, file, record_size, read_ahead);
+    },
+  };
+}
+
+TESTEE_STATE(slice_collector) {
+  std::vector<file_slice> slices;
+};
+
+TESTEE(slice_collector) {
+  return {
+    [=](stream<file_slice> in) {
+      return attach_stream_sink(
+        self, in,
+        // initialize state
+        [](unit_t&) {
+          // nop
+        },
+        // processing step
+        [=](unit_t&, file_slice x) {
+          self->state.slices.emplace_back(std::move(x));
+        });
+    },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  std::string path;
+
+  std::string content;
+
+  fixture() : path("caf-mapped-file-test.bin") {
+    // Write `num_records` records plus a trailing partial record.
+    for (size_t i = 0; i < num_records * record_size + 3; ++i)
+      content += static_cast<char>('a' + i % 26);
+    std::ofstream out{path, std::ios::binary};
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  ~fixture() {
+    std::remove(path.c_str());
+  }
+
+  std::string to_str(const file_slice& x) {
+    return {reinterpret_cast<const char*>(x.data()), x.size()};
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(mapped_file_tests, fixture)
+
+CAF_TEST(mapped files expose the content of a file) {
+  auto file = unbox(mapped_file::open(path));
+  CAF_REQUIRE_EQUAL(file->size(), content.size());
+  CAF_CHECK(file->mapped());
+  std::string str{reinterpret_cast<const char*>(file->data()), file->size()};
+  CAF_CHECK_EQUAL(str, content);
+}
+
+CAF_TEST(opening a missing file fails) {
+  auto file = mapped_file::open("caf-mapped-file-test-missing.bin");
+  CAF_REQUIRE(!file);
+  CAF_CHECK_EQUAL(file.error(), sec::cannot_open_file);
+}
+
+CAF_TEST(file slices serialize their content) {
+  auto file = unbox(mapped_file::open(path));
+  file_slice slice{file, record_size, record_size};
+  byte_buffer buf;
+  binary_serializer sink{sys, buf};
+  if (!sink.apply_object(slice))
+    CAF_FAIL("serialization failed: " << sink.get_error());
+  file_slice copy;
+  binary_deserializer source{sys, buf};
+  if (!source.apply_object(copy))
+    CAF_FAIL("deserialization failed: " << source.get_error());
+  CAF_CHECK(!copy.file()->mapped());
+  CAF_CHECK_EQUAL(to_str(copy), content.substr(record_size, record_size));
+}
+
+CAF_TEST(mapped file sources emit records without copying) {
+  auto file = unbox(mapped_file::open(path));
+  auto sink = sys.spawn(slice_collector);
+  // A small read-ahead window makes the source advise the OS several times.
+  auto src = sys.spawn(file_reader, file, record_size * 8);
+  run();
+  self->send(src, join_atom_v, sink);
+  run();
+  auto& slices = deref<slice_collector_actor>(sink).state.slices;
+  CAF_REQUIRE_EQUAL(slices.size(), num_records);
+  for (size_t i = 0; i < num_records; ++i) {
+    auto& slice = slices[i];
+    CAF_CHECK(slice.file() == file);
+    CAF_CHECK(slice.data() == file->data() + i * record_size);
+    CAF_CHECK_EQUAL(to_str(slice), content.substr(i * record_size, record_size));
+  }
+}
+
+CAF_TEST(mapped file sources reject empty records) {
+  auto file = unbox(mapped_file::open(path));
+  error err;
+  sys.spawn([&](event_based_actor* self) {
+    if (auto res = attach_mapped_file_source(self, file, 0); !res)
+      err = std::move(res.error());
+  });
+  run();
+  CAF_CHECK_EQUAL(err, sec::invalid_argument);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE message_tracer
+
+#include "caf/message_tracer.hpp"
+
+#include "core-test.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "caf/mailbox_element.hpp"
+
+using namespace caf;
+
+namespace {
+
+using event_type = message_tracer::event_type;
+
+struct foo_state {
+  static inline const char* name = "foo";
+};
+
+struct bar_state {
+  static inline const char* name = "bar";
+};
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() {
+    foo = sys.spawn([](stateful_actor<foo_state>*) -> behavior {
+      return {
+        [](int32_t) {},
+      };
+    });
+    bar = sys.spawn([](stateful_actor<bar_state>*) -> behavior {
+      return {
+        [](int32_t) {},
+      };
+    });
+    run();
+  }
+
+  mailbox_element_ptr make_element() {
+    return make_mailbox_element(nullptr, make_message_id(), {}, int32_t{42});
+  }
+
+  // Calls the profiler hooks as if foo sent `element` to bar.
+  void send_foo_to_bar(actor_profiler& prof, mailbox_element& element) {
+    auto& foo_ref = deref<local_actor>(foo);
+    auto& bar_ref = deref<local_actor>(bar);
+    prof.before_sending(foo_ref, element);
+    prof.before_enqueue(bar_ref, element);
+    prof.before_processing(bar_ref, element);
+    prof.after_processing(bar_ref, invoke_message_result::consumed);
+  }
+
+  actor foo;
+  actor bar;
+};
+
+bool contains(const std::string& str, string_view what) {
+  return str.find(what.data(), 0, what.size()) != std::string::npos;
+}
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(message_tracer_tests, fixture)
+
+CAF_TEST(the tracer records all steps of a message flow) {
+  message_tracer tracer;
+  auto element = make_element();
+  send_foo_to_bar(tracer, *element);
+  auto events = tracer.events();
+  if (!CAF_CHECK_EQUAL(events.size(), 4u))
+    return;
+  auto flow = reinterpret_cast<uintptr_t>(element.get());
+  CAF_CHECK(events[0].type == event_type::send);
+  CAF_CHECK_EQUAL(events[0].aid, foo.id());
+  CAF_CHECK_EQUAL(string_view{events[0].name}, "foo");
+  CAF_CHECK_EQUAL(events[0].flow, flow);
+  CAF_CHECK(events[1].type == event_type::enqueue);
+  CAF_CHECK_EQUAL(events[1].aid, bar.id());
+  CAF_CHECK_EQUAL(events[1].flow, flow);
+  CAF_CHECK(events[2].type == event_type::dequeue);
+  CAF_CHECK_EQUAL(events[2].aid, bar.id());
+  CAF_CHECK_EQUAL(events[2].flow, flow);
+  CAF_CHECK_EQUAL(events[2].types, make_type_id_list<int32_t>());
+  CAF_CHECK(events[3].type == event_type::processing_end);
+  CAF_CHECK_EQUAL(events[3].aid, bar.id());
+  for (size_t i = 1; i < events.size(); ++i)
+    CAF_CHECK_GREATER_OR_EQUAL(events[i].timestamp, events[i - 1].timestamp);
+}
+
+CAF_TEST(each thread keeps only the most recent events) {
+  message_tracer tracer{4};
+  auto& foo_ref = deref<local_actor>(foo);
+  auto element = make_element();
+  for (int i = 0; i < 3; ++i)
+    tracer.before_sending(foo_ref, *element);
+  for (int i = 0; i < 3; ++i)
+    tracer.before_processing(foo_ref, *element);
+  auto events = tracer.events();
+  if (CAF_CHECK_EQUAL(events.size(), 4u)) {
+    CAF_CHECK(events[0].type == event_type::send);
+    CAF_CHECK(events[1].type == event_type::dequeue);
+    CAF_CHECK(events[3].type == event_type::dequeue);
+  }
+  tracer.clear();
+  CAF_CHECK(tracer.events().empty());
+}
+
+CAF_TEST(the tracer assigns one buffer per thread) {
+  message_tracer tracer;
+  auto element = make_element();
+  send_foo_to_bar(tracer, *element);
+  std::thread t{[&] { send_foo_to_bar(tracer, *element); }};
+  t.join();
+  auto events = tracer.events();
+  if (CAF_CHECK_EQUAL(events.size(), 8u)) {
+    CAF_CHECK_EQUAL(events.front().thread, 1u);
+    CAF_CHECK_EQUAL(events.back().thread, 2u);
+  }
+}
+
+CAF_TEST(the tracer writes events in the Chrome trace format) {
+  message_tracer tracer;
+  auto element = make_element();
+  send_foo_to_bar(tracer, *element);
+  std::ostringstream out;
+  tracer.write_chrome_trace(out);
+  auto str = out.str();
+  CAF_MESSAGE("trace:\n" << str);
+  CAF_CHECK(starts_with(str, R"({"displayTimeUnit":"ns","traceEvents":[)"));
+  CAF_CHECK(ends_with(str, "]}\n"));
+  CAF_CHECK(contains(str, R"("name":"thread_name","ph":"M")"));
+  CAF_CHECK(contains(str, R"({"name":"send","cat":"caf","ph":"i")"));
+  CAF_CHECK(contains(str, R"({"name":"bar","cat":"caf","ph":"B")"));
+  CAF_CHECK(contains(str, R"({"name":"bar","cat":"caf","ph":"E")"));
+  CAF_CHECK(contains(str, R"("message":"[int32_t]")"));
+  auto flow = reinterpret_cast<uintptr_t>(element.get());
+  auto id = R"("id":")" + std::to_string(flow) + '"';
+  CAF_CHECK(contains(str, R"("cat":"caf.flow","ph":"s")"));
+  CAF_CHECK(contains(str, R"("cat":"caf.flow","ph":"t")"));
+  CAF_CHECK(contains(str, R"("cat":"caf.flow","ph":"f")"));
+  CAF_CHECK(contains(str, id + R"(,"bp":"e"})"));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
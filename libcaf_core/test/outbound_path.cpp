@@ -0,0 +1,139 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE outbound_path
+
+#include "caf/outbound_path.hpp"
+
+#include "core-test.hpp"
+
+#include <atomic>
+#include <memory>
+
+#include "caf/actor_system.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
+#include "caf/make_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t max_pending_bytes = 1024;
+
+behavior dummy_sink() {
+  return {
+    [](int32_t) {
+      // nop
+    },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  forwarding_actor_proxy::send_buffer_ptr send_buffer;
+
+  std::atomic<size_t>* pending;
+
+  strong_actor_ptr proxy;
+
+  fixture()
+    : send_buffer(
+      std::make_shared<forwarding_actor_proxy::send_buffer_state>()),
+      pending(&send_buffer->pending_bytes) {
+    actor_config conf;
+    proxy = make_actor<forwarding_actor_proxy, strong_actor_ptr>(
+      sys.next_actor_id(), sys.node(), &sys, conf, actor{}, send_buffer);
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(outbound_path_tests, fixture)
+
+CAF_TEST(paths to local sinks never withhold credit) {
+  auto sink = actor_cast<strong_actor_ptr>(sys.spawn(dummy_sink));
+  outbound_path path{1, sink};
+  CAF_CHECK(path.remote_hdl == nullptr);
+  path.grant_credit(10, max_pending_bytes);
+  CAF_CHECK_EQUAL(path.open_credit, 10);
+  CAF_CHECK_EQUAL(path.withheld_credit, 0);
+}
+
+CAF_TEST(paths to remote sinks withhold credit while congested) {
+  outbound_path path{1, proxy};
+  CAF_REQUIRE(path.remote_hdl != nullptr);
+  CAF_MESSAGE("credit passes through while the send buffer is small");
+  pending->store(max_pending_bytes);
+  path.grant_credit(10, max_pending_bytes);
+  CAF_CHECK_EQUAL(path.open_credit, 10);
+  CAF_CHECK_EQUAL(path.withheld_credit, 0);
+  CAF_MESSAGE("a full send buffer causes the path to withhold credit");
+  pending->store(max_pending_bytes + 1);
+  CAF_CHECK(path.congested(max_pending_bytes));
+  path.grant_credit(20, max_pending_bytes);
+  path.grant_credit(5, max_pending_bytes);
+  CAF_CHECK_EQUAL(path.open_credit, 10);
+  CAF_CHECK_EQUAL(path.withheld_credit, 25);
+  CAF_CHECK(!path.release_credit(max_pending_bytes));
+  CAF_MESSAGE("the path releases all credit after the send buffer drained");
+  pending->store(0);
+  CAF_CHECK(path.release_credit(max_pending_bytes));
+  CAF_CHECK_EQUAL(path.open_credit, 35);
+  CAF_CHECK_EQUAL(path.withheld_credit, 0);
+}
+
+CAF_TEST(a limit of zero disables withholding credit) {
+  outbound_path path{1, proxy};
+  pending->store(max_pending_bytes * 100);
+  CAF_CHECK(!path.congested(0));
+  path.grant_credit(10, 0);
+  CAF_CHECK_EQUAL(path.open_credit, 10);
+}
+
+CAF_TEST(paths observe the connection only with a limit) {
+  { // Lifetime scope of the path.
+    outbound_path path{1, proxy};
+    CAF_MESSAGE("paths do not observe connections until receiving credit");
+    CAF_CHECK_EQUAL(send_buffer->observers.load(), 0u);
+    path.grant_credit(10, 0);
+    CAF_CHECK_EQUAL(send_buffer->observers.load(), 0u);
+    CAF_MESSAGE("paths observe their connection once with a limit");
+    path.grant_credit(10, max_pending_bytes);
+    path.grant_credit(10, max_pending_bytes);
+    CAF_CHECK_EQUAL(send_buffer->observers.load(), 1u);
+    CAF_MESSAGE("rebinding a path to a local actor stops observing");
+    path.rebind(actor_cast<strong_actor_ptr>(sys.spawn(dummy_sink)));
+    CAF_CHECK_EQUAL(send_buffer->observers.load(), 0u);
+    path.rebind(proxy);
+    path.grant_credit(10, max_pending_bytes);
+    CAF_CHECK_EQUAL(send_buffer->observers.load(), 1u);
+  }
+  CAF_MESSAGE("destroying a path stops observing");
+  CAF_CHECK_EQUAL(send_buffer->observers.load(), 0u);
+}
+
+CAF_TEST(rebinding a path updates its remote handle) {
+  outbound_path path{1, proxy};
+  CAF_CHECK(path.remote_hdl != nullptr);
+  path.rebind(actor_cast<strong_actor_ptr>(sys.spawn(dummy_sink)));
+  CAF_CHECK(path.remote_hdl == nullptr);
+  path.rebind(proxy);
+  CAF_CHECK(path.remote_hdl != nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
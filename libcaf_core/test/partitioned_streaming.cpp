@@ -0,0 +1,194 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE partitioned_streaming
+
+#include "caf/attach_partitioned_stream_source.hpp"
+
+#include "core-test.hpp"
+
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/attach_ordered_merge_sink.hpp"
+#include "caf/attach_stream_sink.hpp"
+#include "caf/attach_stream_stage.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/ordered_merge.hpp"
+#include "caf/stateful_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+// Routes each integer to the partition `x % n`.
+struct identity_hash {
+  size_t operator()(int32_t x) const noexcept {
+    return static_cast<size_t>(x);
+  }
+};
+
+using manager_type = partition_downstream_manager<int32_t, identity_hash>;
+
+TESTEE_SETUP();
+
+VARARGS_TESTEE(partitioner, std::vector<actor> workers, actor merge,
+               int32_t num_elements) {
+  attach_partitioned_stream_source(
+    self, workers, merge,
+    // initialize state
+    [](int32_t& x) { x = 0; },
+    // get next element
+    [=](int32_t& x, downstream<int32_t>& out, size_t num) {
+      for (size_t i = 0; i < num && x < num_elements; ++i)
+        out.push(x++);
+    },
+    // check whether we reached the end
+    [=](const int32_t& x) { return x == num_elements; }, unit,
+    policy::arg<manager_type>::value);
+  return {
+    [=](ok_atom) {
+      // nop
+    },
+  };
+}
+
+TESTEE_STATE(doubler) {
+  std::vector<int32_t> inputs;
+};
+
+TESTEE(doubler) {
+  return {
+    [=](stream<int32_t> in) {
+      return attach_stream_stage(
+        self, in,
+        // initialize state
+        [](unit_t&) {
+          // nop
+        },
+        // processing step
+        [=](unit_t&, downstream<int32_t>& out, int32_t x) {
+          self->state.inputs.emplace_back(x);
+          out.push(x * 2);
+        });
+    },
+  };
+}
+
+TESTEE_STATE(merger) {
+  ordered_merge<int32_t> merge;
+  std::vector<int32_t> received;
+  std::vector<int32_t> results;
+  size_t max_pending = 0;
+};
+
+TESTEE(merger) {
+  return {
+    [=](stream<int32_t> in) {
+      auto& st = self->state;
+      return attach_ordered_merge_sink(
+        self, in, st.merge,
+        // get sequence number
+        [&st](int32_t x) {
+          st.received.emplace_back(x);
+          st.max_pending = std::max(st.max_pending, st.merge.pending());
+          return static_cast<uint64_t>(x / 2);
+        },
+        // consume elements in order
+        [&st](int32_t x) { st.results.emplace_back(x); });
+    },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  std::vector<actor> workers;
+
+  actor merge;
+
+  fixture() {
+    for (int i = 0; i < 3; ++i)
+      workers.emplace_back(sys.spawn(doubler));
+    merge = sys.spawn(merger);
+    run();
+  }
+
+  std::vector<int32_t> iota(int32_t first, int32_t last, int32_t step = 1) {
+    std::vector<int32_t> result;
+    for (auto x = first; x < last; x += step)
+      result.emplace_back(x);
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(partitioned_streaming_tests, fixture)
+
+CAF_TEST(the partition manager routes elements by their hash value) {
+  sys.spawn(partitioner, workers, merge, 300);
+  run();
+  for (int32_t i = 0; i < 3; ++i) {
+    auto& inputs = deref<doubler_actor>(workers[i]).state.inputs;
+    CAF_CHECK_EQUAL(inputs, iota(i, 300, 3));
+  }
+}
+
+CAF_TEST(ordered merges restore the input order) {
+  sys.spawn(partitioner, workers, merge, 300);
+  run();
+  auto& st = deref<merger_actor>(merge).state;
+  CAF_CHECK_EQUAL(st.received.size(), 300u);
+  CAF_CHECK_NOT_EQUAL(st.received, iota(0, 600, 2));
+  CAF_CHECK_GREATER(st.max_pending, 0u);
+  CAF_CHECK_EQUAL(st.results, iota(0, 600, 2));
+  CAF_CHECK_EQUAL(st.merge.pending(), 0u);
+  CAF_CHECK_EQUAL(st.merge.next(), 300u);
+}
+
+CAF_TEST(ordered merges buffer elements until their predecessors arrive) {
+  ordered_merge<int32_t> uut;
+  std::vector<int32_t> results;
+  auto f = [&](int32_t x) { results.emplace_back(x); };
+  uut.push(2, 20, f);
+  uut.push(1, 10, f);
+  CAF_CHECK_EQUAL(uut.pending(), 2u);
+  CAF_CHECK(results.empty());
+  uut.push(0, 0, f);
+  CAF_CHECK_EQUAL(results, std::vector<int32_t>({0, 10, 20}));
+  CAF_CHECK_EQUAL(uut.pending(), 0u);
+  CAF_CHECK_EQUAL(uut.next(), 3u);
+}
+
+CAF_TEST(ordered merges drop stale and duplicate elements) {
+  ordered_merge<int32_t> uut;
+  std::vector<int32_t> results;
+  auto f = [&](int32_t x) { results.emplace_back(x); };
+  CAF_CHECK(uut.push(0, 0, f));
+  CAF_CHECK(uut.push(2, 20, f));
+  CAF_CHECK(!uut.push(0, 0, f));
+  CAF_CHECK(!uut.push(2, 21, f));
+  CAF_CHECK_EQUAL(uut.pending(), 1u);
+  CAF_CHECK(uut.push(1, 10, f));
+  CAF_CHECK(!uut.push(1, 11, f));
+  CAF_CHECK_EQUAL(results, std::vector<int32_t>({0, 10, 20}));
+  CAF_CHECK_EQUAL(uut.pending(), 0u);
+  CAF_CHECK_EQUAL(uut.next(), 3u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -22,12 +22,15 @@
 
 #include <memory>
 #include <numeric>
+#include <vector>
 
 #include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/attach_stream_sink.hpp"
 #include "caf/attach_stream_stage.hpp"
+#include "caf/detail/simple_actor_clock.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/fuse_stream_steps.hpp"
 #include "caf/stateful_actor.hpp"
 
 using std::string;
@@ -72,6 +75,30 @@ TESTEE(infinite_source) {
   };
 }
 
+TESTEE_STATE(lazy_source) {
+  int fin_called = 0;
+};
+
+TESTEE(lazy_source) {
+  return {
+    [=](string& fname) -> result<stream<int>> {
+      CAF_CHECK_EQUAL(fname, "numbers.txt");
+      return attach_stream_source(
+        self, [](bool& pushed) { pushed = false; },
+        [](bool& pushed, downstream<int>& out, size_t) {
+          if (!pushed) {
+            out.push(1);
+            pushed = true;
+          }
+        },
+        [](const bool&) { return false; }, fin<bool>(self));
+    },
+    [](ok_atom) {
+      // nop
+    },
+  };
+}
+
 TESTEE_STATE(file_reader) {
   int fin_called = 0;
 };
@@ -225,6 +252,38 @@ TESTEE(doubler) {
   };
 }
 
+TESTEE_STATE(fused_filter_doubler) {
+  int fin_called = 0;
+};
+
+TESTEE(fused_filter_doubler) {
+  CAF_IGNORE_UNUSED(self);
+  return {
+    [=](stream<int>& in) {
+      return attach_stream_stage(
+        self,
+        // input stream
+        in,
+        // initialize state
+        [](unit_t&) {
+          // nop
+        },
+        // processing steps
+        fuse_stream_steps(
+          [](downstream<int>& out, int x) {
+            if ((x & 0x01) != 0)
+              out.push(x);
+          },
+          [](downstream<int64_t>& out, int x) { out.push(int64_t{x}); },
+          [](downstream<int>& out, int64_t x) {
+            out.push(static_cast<int>(x * 2));
+          }),
+        // cleanup
+        fin<unit_t>(self));
+    },
+  };
+}
+
 struct fixture : test_coordinator_fixture<> {
   void tick() {
     advance_time(cfg.stream_credit_round_interval);
@@ -235,6 +294,20 @@ struct fixture : test_coordinator_fixture<> {
   void hard_kill(const actor& x) {
     deref(x).cleanup(exit_reason::kill, nullptr);
   }
+
+  /// Returns the pending stream timeouts of `x`.
+  std::vector<actor_clock::time_point> stream_timeouts(const actor& x) {
+    using clock_type = detail::simple_actor_clock;
+    std::vector<actor_clock::time_point> result;
+    for (auto& kvp : sched.clock().schedule()) {
+      if (kvp.second->subtype != clock_type::ordinary_timeout_type)
+        continue;
+      auto& tout = static_cast<clock_type::ordinary_timeout&>(*kvp.second);
+      if (tout.type == "stream" && tout.self == actor_cast<strong_actor_ptr>(x))
+        result.emplace_back(kvp.first);
+    }
+    return result;
+  }
 };
 
 } // namespace
@@ -441,6 +514,27 @@ CAF_TEST(depth_4_pipeline_500_items) {
   CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.fin_called, 1);
 }
 
+CAF_TEST(depth_3_pipeline_with_fused_stage_500_items) {
+  auto src = sys.spawn(file_reader, 500u);
+  auto stg = sys.spawn(fused_filter_doubler);
+  auto snk = sys.spawn(sum_up);
+  CAF_MESSAGE(CAF_ARG(self) << CAF_ARG(src) << CAF_ARG(stg) << CAF_ARG(snk));
+  CAF_MESSAGE("initiate stream handshake");
+  self->send(snk * stg * src, "numbers.txt");
+  expect((string), from(self).to(src).with("numbers.txt"));
+  expect((open_stream_msg), from(self).to(stg));
+  expect((open_stream_msg), from(self).to(snk));
+  expect((upstream_msg::ack_open), from(snk).to(stg));
+  expect((upstream_msg::ack_open), from(stg).to(src));
+  CAF_MESSAGE("start data transmission");
+  run();
+  CAF_MESSAGE("the fused stage produces the same result as two stages");
+  CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.x, 125000);
+  CAF_CHECK_EQUAL(deref<file_reader_actor>(src).state.fin_called, 1);
+  CAF_CHECK_EQUAL(deref<fused_filter_doubler_actor>(stg).state.fin_called, 1);
+  CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.fin_called, 1);
+}
+
 CAF_TEST(depth_3_pipeline_graceful_shutdown) {
   auto src = sys.spawn(file_reader, 50u);
   auto stg = sys.spawn(filter);
@@ -485,4 +579,30 @@ CAF_TEST(depth_3_pipeline_infinite_source) {
   CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.fin_called, 1);
 }
 
+CAF_TEST(pending stream timeouts absorb later deadlines) {
+  auto src = sys.spawn(lazy_source);
+  auto snk = sys.spawn(sum_up);
+  auto delay = deref<sum_up_actor>(snk).max_batch_delay();
+  self->send(snk * src, "numbers.txt");
+  expect((string), from(self).to(src).with("numbers.txt"));
+  expect((open_stream_msg), from(self).to(snk));
+  expect((upstream_msg::ack_open), from(snk).to(src));
+  CAF_MESSAGE("the source awaits a tick for sending its underfull batch");
+  auto touts = stream_timeouts(src);
+  CAF_REQUIRE_EQUAL(touts.size(), 1u);
+  CAF_CHECK(touts[0] == sched.clock().now() + delay);
+  CAF_MESSAGE("new messages do not postpone pending stream timeouts");
+  sched.clock().advance_time(delay / 2);
+  self->send(src, ok_atom_v);
+  expect((ok_atom), from(self).to(src));
+  CAF_CHECK(stream_timeouts(src) == touts);
+  CAF_MESSAGE("idle streams suspend their ticks");
+  run();
+  CAF_CHECK_EQUAL(deref<sum_up_actor>(snk).state.x, 1);
+  CAF_CHECK(stream_timeouts(src).empty());
+  CAF_CHECK(stream_timeouts(snk).empty());
+  anon_send_exit(src, exit_reason::user_shutdown);
+  run();
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
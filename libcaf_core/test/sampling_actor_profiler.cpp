@@ -0,0 +1,156 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE sampling_actor_profiler
+
+#include "caf/sampling_actor_profiler.hpp"
+
+#include "core-test.hpp"
+
+#include "caf/mailbox_element.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct foo_state {
+  static inline const char* name = "foo";
+};
+
+struct bar_state {
+  static inline const char* name = "bar";
+};
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() {
+    foo = sys.spawn([](stateful_actor<foo_state>*) -> behavior {
+      return {
+        [](int32_t) {},
+      };
+    });
+    bar = sys.spawn([](stateful_actor<bar_state>*) -> behavior {
+      return {
+        [](int32_t) {},
+      };
+    });
+    run();
+  }
+
+  mailbox_element_ptr make_element() {
+    return make_mailbox_element(nullptr, make_message_id(), {}, int32_t{42});
+  }
+
+  // Calls the profiler hooks as if `self` processed `element`.
+  void process(actor_profiler& prof, const actor& self,
+               const mailbox_element& element,
+               invoke_message_result result = invoke_message_result::consumed) {
+    auto& ref = deref<local_actor>(self);
+    prof.before_processing(ref, element);
+    prof.after_processing(ref, result);
+  }
+
+  // Returns the histogram for actor type `name` and message type `int32_t`.
+  template <class ValueType>
+  telemetry::histogram<ValueType>* get(string_view metric, string_view name) {
+    // The registry ignores the buckets for existing families.
+    ValueType buckets[] = {1};
+    auto unit = std::is_same<ValueType, double>::value ? "seconds" : "1";
+    auto fptr = sys.metrics().histogram_family<ValueType>(
+      "caf.actor.profiler", metric, {"name", "message"}, buckets, "", unit);
+    auto message = to_string(make_type_id_list<int32_t>());
+    return fptr->get_or_add({{"name", name}, {"message", message}});
+  }
+
+  template <class ValueType>
+  static int64_t count(const telemetry::histogram<ValueType>* hist) {
+    int64_t result = 0;
+    for (auto& bucket : hist->buckets())
+      result += bucket.count.value();
+    return result;
+  }
+
+  actor foo;
+  actor bar;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(sampling_actor_profiler_tests, fixture)
+
+CAF_TEST(the profiler samples one out of N messages) {
+  sampling_actor_profiler prof{2};
+  CAF_CHECK_EQUAL(prof.sample_rate(), 2u);
+  for (int i = 0; i < 10; ++i)
+    process(prof, foo, *make_element());
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "foo")), 5);
+  CAF_CHECK_EQUAL(count(get<int64_t>("fan-out", "foo")), 5);
+}
+
+CAF_TEST(the profiler aggregates per actor type) {
+  sampling_actor_profiler prof{1};
+  for (int i = 0; i < 3; ++i)
+    process(prof, foo, *make_element());
+  process(prof, bar, *make_element());
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "foo")), 3);
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "bar")), 1);
+}
+
+CAF_TEST(the profiler ignores skipped messages) {
+  sampling_actor_profiler prof{1};
+  process(prof, foo, *make_element(), invoke_message_result::skipped);
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "foo")), 0);
+  process(prof, foo, *make_element());
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "foo")), 1);
+}
+
+CAF_TEST(the profiler measures the mailbox time of stamped messages) {
+  sampling_actor_profiler prof{1};
+  auto& bar_ref = deref<local_actor>(bar);
+  CAF_MESSAGE("messages from actors carry a timestamp");
+  auto stamped = make_element();
+  prof.before_sending(bar_ref, *stamped);
+  process(prof, foo, *stamped);
+  CAF_CHECK_EQUAL(count(get<double>("mailbox-time", "foo")), 1);
+  CAF_MESSAGE("messages without timestamp only affect the processing time");
+  process(prof, foo, *make_element());
+  CAF_CHECK_EQUAL(count(get<double>("mailbox-time", "foo")), 1);
+  CAF_CHECK_EQUAL(count(get<double>("processing-time", "foo")), 2);
+}
+
+CAF_TEST(the fan out counts messages sent while processing a sample) {
+  sampling_actor_profiler prof{1};
+  auto& foo_ref = deref<local_actor>(foo);
+  auto& bar_ref = deref<local_actor>(bar);
+  auto input = make_element();
+  prof.before_processing(foo_ref, *input);
+  for (int i = 0; i < 3; ++i)
+    prof.before_sending(foo_ref, *make_element());
+  prof.before_sending_scheduled(foo_ref, actor_clock::time_point{},
+                                *make_element());
+  CAF_MESSAGE("messages from other actors do not count");
+  prof.before_sending(bar_ref, *make_element());
+  prof.after_processing(foo_ref, invoke_message_result::consumed);
+  auto fan_out = get<int64_t>("fan-out", "foo");
+  CAF_CHECK_EQUAL(count(fan_out), 1);
+  CAF_CHECK_EQUAL(fan_out->sum(), 4);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE stream_metrics
+
+#include "core-test.hpp"
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/attach_stream_sink.hpp"
+#include "caf/attach_stream_source.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/stateful_actor.hpp"
+#include "caf/telemetry/histogram.hpp"
+
+using namespace caf;
+
+namespace {
+
+TESTEE_SETUP();
+
+TESTEE(int_source) {
+  using buf = std::vector<int32_t>;
+  return {
+    [=](int32_t num_elements) {
+      return attach_stream_source(
+        self,
+        // initialize state
+        [=](buf& xs) {
+          xs.resize(static_cast<size_t>(num_elements));
+          std::iota(xs.begin(), xs.end(), 1);
+        },
+        // get next element
+        [](buf& xs, downstream<int32_t>& out, size_t num) {
+          auto n = std::min(num, xs.size());
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        // check whether we reached the end
+        [=](const buf& xs) { return xs.empty(); });
+    },
+  };
+}
+
+TESTEE_STATE(int_sink) {
+  int32_t result = 0;
+};
+
+TESTEE(int_sink) {
+  return {
+    [=](stream<int32_t> in) {
+      return attach_stream_sink(
+        self, in,
+        // initialize state
+        [](unit_t&) {
+          // nop
+        },
+        // processing step
+        [=](unit_t&, int32_t x) { self->state.result += x; });
+    },
+  };
+}
+
+struct config : actor_system_config {
+  config() {
+    put(content, "caf.metrics-filters.actors.includes",
+        std::vector<std::string>{"int_source", "int_sink"});
+  }
+};
+
+struct fixture : test_coordinator_fixture<config> {
+  template <class ValueType>
+  int64_t observations(telemetry::metric_family_impl<
+                         telemetry::histogram<ValueType>>* family,
+                       string_view actor_name) {
+    std::vector<telemetry::label_view> labels{{"name", actor_name},
+                                              {"type", "int32_t"}};
+    auto hist = family->get_or_add(labels);
+    int64_t result = 0;
+    for (auto& bucket : hist->buckets())
+      result += bucket.count.value();
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(stream_metrics_tests, fixture)
+
+CAF_TEST(actors with metrics sample batches and credit) {
+  auto src = sys.spawn(int_source);
+  auto snk = sys.spawn(int_sink);
+  self->send(snk * src, 1000);
+  run();
+  CAF_REQUIRE_EQUAL(deref<int_sink_actor>(snk).state.result, 500500);
+  auto& fs = sys.actor_metric_families().stream;
+  CAF_MESSAGE("the sink samples each batch");
+  auto num_batches = observations(fs.batch_size, "int_sink");
+  CAF_CHECK_GREATER(num_batches, 0);
+  CAF_CHECK_EQUAL(fs.batch_size
+                    ->get_or_add({{"name", "int_sink"}, {"type", "int32_t"}})
+                    ->sum(),
+                  1000);
+  CAF_CHECK_EQUAL(observations(fs.batch_latency, "int_sink"), num_batches);
+  CAF_MESSAGE("the sink samples how long it waits for batches after credit");
+  CAF_CHECK_GREATER(observations(fs.credit_round_trip_time, "int_sink"), 0);
+  CAF_MESSAGE("the source samples how long it waits for credit");
+  CAF_CHECK_GREATER(observations(fs.credit_starvation_time, "int_source"), 0);
+  CAF_MESSAGE("actors without outbound paths never starve");
+  CAF_CHECK_EQUAL(observations(fs.credit_starvation_time, "int_sink"), 0);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
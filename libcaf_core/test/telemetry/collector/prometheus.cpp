@@ -86,4 +86,77 @@ some_request_duration_seconds_count{x="get"} 3 42000
   CAF_CHECK_EQUAL(res1, exporter.collect_from(registry));
 }
 
+CAF_TEST(the Prometheus collector only updates changed families) {
+  auto fb = registry.gauge_family("foo", "bar", {}, "", "seconds");
+  auto sv = registry.counter_family("some", "value", {"a"}, "Some value.",
+                                    "1", true);
+  fb->get_or_add({})->value(1);
+  sv->get_or_add({{"a", "1"}})->inc();
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, 42),
+                  R"(# TYPE foo_bar_seconds gauge
+foo_bar_seconds 1 42000
+# HELP some_value_total Some value.
+# TYPE some_value_total counter
+some_value_total{a="1"} 1 42000
+)"_sv);
+  CAF_MESSAGE("unchanged families only get a new timestamp");
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, 43),
+                  R"(# TYPE foo_bar_seconds gauge
+foo_bar_seconds 1 43000
+# HELP some_value_total Some value.
+# TYPE some_value_total counter
+some_value_total{a="1"} 1 43000
+)"_sv);
+  CAF_MESSAGE("changed values and new instances show up in the output");
+  fb->get_or_add({})->value(2);
+  sv->get_or_add({{"a", "2"}})->inc(3);
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, 44),
+                  R"(# TYPE foo_bar_seconds gauge
+foo_bar_seconds 2 44000
+# HELP some_value_total Some value.
+# TYPE some_value_total counter
+some_value_total{a="1"} 1 44000
+some_value_total{a="2"} 3 44000
+)"_sv);
+}
+
+CAF_TEST(the Prometheus collector optionally generates OpenMetrics) {
+  exporter.output_format(collector::prometheus::format::openmetrics);
+  CAF_CHECK_EQUAL(exporter.content_type(),
+                  "application/openmetrics-text; version=1.0.0; charset=utf-8");
+  auto fb = registry.gauge_family("foo", "bar", {}, "Some gauge.", "seconds");
+  auto sv = registry.counter_family("some", "value", {"a"}, "Some value.",
+                                    "1", true);
+  std::vector<int64_t> upper_bounds{1, 2};
+  auto sr = registry.histogram_family("some", "request-duration", {"x"},
+                                      upper_bounds, "Some help.", "seconds");
+  fb->get_or_add({})->value(123);
+  sv->get_or_add({{"a", "1"}})->inc(2);
+  sr->get_or_add({{"x", "get"}})->observe(2);
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, 42),
+                  R"(# HELP foo_bar_seconds Some gauge.
+# TYPE foo_bar_seconds gauge
+# UNIT foo_bar_seconds seconds
+foo_bar_seconds 123 42
+# HELP some_value Some value.
+# TYPE some_value counter
+some_value_total{a="1"} 2 42
+# HELP some_request_duration_seconds Some help.
+# TYPE some_request_duration_seconds histogram
+# UNIT some_request_duration_seconds seconds
+some_request_duration_seconds_bucket{x="get",le="1"} 0 42
+some_request_duration_seconds_bucket{x="get",le="2"} 1 42
+some_request_duration_seconds_bucket{x="get",le="+Inf"} 1 42
+some_request_duration_seconds_sum{x="get"} 2 42
+some_request_duration_seconds_count{x="get"} 1 42
+# EOF
+)"_sv);
+  CAF_MESSAGE("switching back to Prometheus drops all cached output");
+  exporter.output_format(collector::prometheus::format::prometheus);
+  CAF_CHECK_EQUAL(exporter.content_type(), "text/plain; version=0.0.4");
+  auto res = exporter.collect_from(registry, 42);
+  CAF_CHECK(res.find("# TYPE some_value_total counter") != string_view::npos);
+  CAF_CHECK(res.find("# EOF") == string_view::npos);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -59,3 +59,41 @@ CAF_TEST(histograms aggregate to buckets and keep a sum) {
   CAF_CHECK_EQUAL(buckets[3].count.value(), 2); // 9, 10
   CAF_CHECK_EQUAL(h1.sum(), 55);
 }
+
+namespace {
+
+// Returns how many values in [first, last) end up in a different bucket than
+// a linear scan would pick.
+size_t mismatches(const int_histogram& h, int64_t first, int64_t last) {
+  size_t result = 0;
+  auto buckets = h.buckets();
+  for (auto value = first; value < last; ++value) {
+    size_t index = 0;
+    while (value > buckets[index].upper_bound)
+      ++index;
+    if (h.bucket_index(value) != index)
+      ++result;
+  }
+  return result;
+}
+
+} // namespace
+
+CAF_TEST(histograms find the same bucket regardless of the lookup algorithm) {
+  CAF_MESSAGE("many buckets use a binary search");
+  int_histogram h1{1, 3, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+  CAF_CHECK_EQUAL(mismatches(h1, -2, 2100), 0u);
+  dbl_histogram h2{.001, .002, .005, .01, .02, .05, .1, .2, .5, 1., 2.};
+  CAF_CHECK_EQUAL(h2.bucket_index(-1.), 0u);
+  CAF_CHECK_EQUAL(h2.bucket_index(.001), 0u);
+  CAF_CHECK_EQUAL(h2.bucket_index(.0015), 1u);
+  CAF_CHECK_EQUAL(h2.bucket_index(.3), 8u);
+  CAF_CHECK_EQUAL(h2.bucket_index(2.), 10u);
+  CAF_CHECK_EQUAL(h2.bucket_index(2.5), 11u);
+  CAF_MESSAGE("powers of two compute the bucket directly");
+  int_histogram h3{64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384};
+  CAF_CHECK_EQUAL(mismatches(h3, -2, 20000), 0u);
+  CAF_CHECK_EQUAL(h3.bucket_index(std::numeric_limits<int64_t>::max()), 9u);
+  int_histogram h4{1, 2, 4};
+  CAF_CHECK_EQUAL(mismatches(h4, -2, 10), 0u);
+}
@@ -22,7 +22,11 @@
 
 #include "caf/test/dsl.hpp"
 
+#include <thread>
+#include <vector>
+
 #include "caf/string_view.hpp"
+#include "caf/telemetry/allocation_counter.hpp"
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
 #include "caf/telemetry/label_view.hpp"
@@ -99,6 +103,16 @@ struct fixture {
   test_collector collector;
 };
 
+struct accounting_state {
+  static inline const char* name = "test.accounting";
+};
+
+behavior accounting_actor(stateful_actor<accounting_state>*) {
+  return {
+    [](int64_t bytes) { count_allocation(static_cast<size_t>(bytes)); },
+  };
+}
+
 } // namespace
 
 CAF_TEST_FIXTURE_SCOPE(metric_registry_tests, fixture)
@@ -207,6 +221,60 @@ CAF_TEST(counter_instance is a shortcut for using the family manually) {
   CAF_CHECK_EQUAL(count, count2);
 }
 
+CAF_TEST(collectors see sharded metrics as regular metrics) {
+  auto sc = registry.sharded_counter_family("caf", "processed-messages", {},
+                                            "Processed messages.", "1", true);
+  auto sg = registry.sharded_gauge_family("caf", "queued-messages", {"name"},
+                                          "Queued messages.");
+  CAF_MESSAGE("the registry always returns the same family object");
+  CAF_CHECK_EQUAL(sc, registry.sharded_counter_family("caf",
+                                                      "processed-messages", {},
+                                                      "", "1", true));
+  CAF_CHECK_EQUAL(sc->get_or_add({}),
+                  registry.sharded_counter_singleton("caf",
+                                                     "processed-messages", "",
+                                                     "1", true));
+  CAF_CHECK_EQUAL(sg->get_or_add({{"name", "foo"}}),
+                  registry.sharded_gauge_instance("caf", "queued-messages",
+                                                  {{"name", "foo"}}, ""));
+  CAF_MESSAGE("collectors receive the sum of all shards");
+  sc->get_or_add({})->inc(5);
+  sg->get_or_add({{"name", "foo"}})->inc(7);
+  sg->get_or_add({{"name", "foo"}})->dec(2);
+  registry.collect(collector);
+  CAF_CHECK_EQUAL(collector.result, R"(
+caf.processed-messages.total 5
+caf.queued-messages{name="foo"} 5)");
+}
+
+CAF_TEST(concurrent lookups return the same family and instance) {
+  std::vector<int_counter*> results(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); ++i)
+    threads.emplace_back([this, &results, i] {
+      for (int j = 0; j < 100; ++j) {
+        auto name = std::to_string(j);
+        registry.counter_instance("caf", "requests", {{"peer", name}}, "");
+      }
+      results[i] = registry.counter_instance("caf", "requests",
+                                             {{"peer", "42"}}, "");
+      results[i]->inc();
+    });
+  for (auto& t : threads)
+    t.join();
+  for (auto ptr : results)
+    CAF_CHECK_EQUAL(ptr, results.front());
+  CAF_CHECK_EQUAL(results.front()->value(), 8);
+  auto fptr = registry.counter_family("caf", "requests", {"peer"}, "");
+  size_t instances = 0;
+  auto count = [&](const metric_family* family, const metric*, auto*) {
+    if (family == fptr)
+      ++instances;
+  };
+  registry.collect(count);
+  CAF_CHECK_EQUAL(instances, 100u);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
 #define CHECK_CONTAINS(str)                                                    \
@@ -224,3 +292,26 @@ CAF_TEST(enabling actor metrics per config creates metric instances) {
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.spawn-server"})");
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.config-server"})");
 }
+
+CAF_TEST(actor accounting tracks CPU time and allocations per actor type) {
+  actor_system_config cfg;
+  test_coordinator_fixture<>::init_config(cfg);
+  put(cfg.content, "caf.metrics-filters.actors.includes",
+      std::vector<std::string>{"test.*"});
+  put(cfg.content, "caf.metrics-filters.actors.accounting", true);
+  actor_system sys{cfg};
+  auto& sched = dynamic_cast<scheduler::test_coordinator&>(sys.scheduler());
+  auto aut = sys.spawn(accounting_actor);
+  anon_send(aut, int64_t{100});
+  anon_send(aut, int64_t{23});
+  sched.run();
+  test_collector collector;
+  sys.metrics().collect(collector);
+  auto npos = std::string::npos;
+  CHECK_CONTAINS("caf.actor.allocated.bytes.total"
+                 R"({name="test.accounting"} 123)");
+  CHECK_CONTAINS("caf.actor.cpu-time.seconds.total"
+                 R"({name="test.accounting"} )");
+  anon_send_exit(aut, exit_reason::user_shutdown);
+  sched.run();
+}
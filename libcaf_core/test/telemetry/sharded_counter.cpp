@@ -0,0 +1,54 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE telemetry.sharded_counter
+
+#include "caf/telemetry/sharded_counter.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+CAF_TEST(sharded counters can only increment) {
+  telemetry::sharded_dbl_counter c;
+  CAF_MESSAGE("counters start at 0");
+  CAF_CHECK_EQUAL(c.value(), 0.0);
+  CAF_MESSAGE("counters are incrementable");
+  c.inc();
+  c.inc(2.0);
+  CAF_CHECK_EQUAL(c.value(), 3.0);
+  CAF_MESSAGE("users can create counters with custom start values");
+  CAF_CHECK_EQUAL(telemetry::sharded_int_counter{42}.value(), 42);
+}
+
+CAF_TEST(sharded counters sum up updates from all threads) {
+  telemetry::sharded_int_counter c;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i)
+    threads.emplace_back([&c] {
+      for (int j = 0; j < 1000; ++j)
+        c.inc();
+    });
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(c.value(), 8000);
+  CAF_CHECK_EQUAL(c.snapshot().value(), 8000);
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2020 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE telemetry.sharded_gauge
+
+#include "caf/telemetry/sharded_gauge.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+CAF_TEST(sharded gauges can increment and decrement) {
+  telemetry::sharded_int_gauge g;
+  CAF_MESSAGE("gauges start at 0");
+  CAF_CHECK_EQUAL(g.value(), 0);
+  CAF_MESSAGE("gauges are incrementable");
+  g.inc();
+  g.inc(2);
+  CAF_CHECK_EQUAL(g.value(), 3);
+  CAF_MESSAGE("gauges are decrementable");
+  g.dec();
+  g.dec(5);
+  CAF_CHECK_EQUAL(g.value(), -3);
+  CAF_MESSAGE("gauges allow setting values");
+  g.value(42);
+  CAF_CHECK_EQUAL(g.value(), 42);
+  CAF_MESSAGE("users can create gauges with custom start values");
+  CAF_CHECK_EQUAL(telemetry::sharded_dbl_gauge{42.0}.value(), 42.0);
+  CAF_MESSAGE("snapshots are regular gauges");
+  CAF_CHECK_EQUAL(g.snapshot().value(), 42);
+}
+
+CAF_TEST(sharded gauges sum up updates from all threads) {
+  telemetry::sharded_int_gauge g;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i)
+    threads.emplace_back([&g] {
+      for (int j = 0; j < 1000; ++j)
+        g.inc(2);
+      for (int j = 0; j < 1000; ++j)
+        g.dec();
+    });
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(g.value(), 8000);
+}
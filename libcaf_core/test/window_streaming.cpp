@@ -0,0 +1,251 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2019 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE window_streaming
+
+#include "caf/attach_window_stage.hpp"
+
+#include "core-test.hpp"
+
+#include <numeric>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/attach_stream_sink.hpp"
+#include "caf/attach_stream_source.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/stateful_actor.hpp"
+
+using namespace caf;
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+struct sum {
+  using input_type = int32_t;
+
+  using value_type = int32_t;
+
+  value_type identity() const {
+    return 0;
+  }
+
+  void add(value_type& acc, const input_type& x) const {
+    acc += x;
+  }
+
+  value_type combine(const value_type& x, const value_type& y) const {
+    return x + y;
+  }
+};
+
+// Drivers only access the output type of their manager.
+struct dummy_manager {
+  using output_type = int32_t;
+};
+
+using tumbling_driver = detail::tumbling_window_driver<sum, dummy_manager>;
+
+using sliding_driver = detail::sliding_window_driver<sum, dummy_manager>;
+
+using session_driver = detail::session_window_driver<sum, dummy_manager>;
+
+TESTEE_SETUP();
+
+TESTEE(int_source) {
+  using buf = std::vector<int32_t>;
+  return {
+    [=](int32_t num_elements) {
+      return attach_stream_source(
+        self,
+        // initialize state
+        [=](buf& xs) {
+          xs.resize(static_cast<size_t>(num_elements));
+          std::iota(xs.begin(), xs.end(), 1);
+        },
+        // get next element
+        [](buf& xs, downstream<int32_t>& out, size_t num) {
+          auto n = std::min(num, xs.size());
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        // check whether we reached the end
+        [=](const buf& xs) { return xs.empty(); });
+    },
+  };
+}
+
+TESTEE_STATE(collector) {
+  std::vector<int32_t> results;
+};
+
+TESTEE(collector) {
+  return {
+    [=](stream<int32_t> in) {
+      return attach_stream_sink(
+        self, in,
+        // initialize state
+        [](unit_t&) {
+          // nop
+        },
+        // processing step
+        [=](unit_t&, int32_t x) { self->state.results.emplace_back(x); });
+    },
+  };
+}
+
+VARARGS_TESTEE(tumbling_window, timespan size) {
+  return {
+    [=](stream<int32_t> in) {
+      return attach_tumbling_window_stage(self, in, size, sum{});
+    },
+  };
+}
+
+VARARGS_TESTEE(session_window, timespan gap) {
+  return {
+    [=](stream<int32_t> in) {
+      return attach_session_window_stage(self, in, gap, sum{});
+    },
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  dummy_manager dm;
+
+  detail::ring_queue<int32_t> buf;
+
+  downstream<int32_t> out{buf};
+
+  fixture() {
+    // Start all tests at the beginning of a window.
+    auto now = sched.clock().now();
+    sched.clock().advance_time(detail::next_window_boundary(now, 10ms) - now);
+  }
+
+  template <class Driver>
+  void process(Driver& drv, std::vector<int32_t> xs) {
+    drv.process(out, xs);
+  }
+
+  template <class Driver>
+  void advance(Driver& drv, timespan dt) {
+    sched.clock().advance_time(dt);
+    drv.tick(out, sched.clock().now());
+  }
+
+  std::vector<int32_t> results() {
+    std::vector<int32_t> xs{buf.begin(), buf.end()};
+    buf.clear();
+    return xs;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(window_streaming_tests, fixture)
+
+CAF_TEST(tumbling windows emit one aggregate per non-empty window) {
+  tumbling_driver drv{dm, sched.clock(), 10ms, sum{}};
+  CAF_CHECK(!drv.awaits_tick());
+  process(drv, {1, 2, 3});
+  CAF_CHECK(drv.awaits_tick());
+  advance(drv, 5ms);
+  process(drv, {4});
+  advance(drv, 4ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>{});
+  advance(drv, 1ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({10}));
+  CAF_CHECK(!drv.awaits_tick());
+  advance(drv, 25ms);
+  process(drv, {5});
+  drv.inputs_closed(out);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({5}));
+}
+
+CAF_TEST(sliding windows emit an aggregate after each slide) {
+  sliding_driver drv{dm, sched.clock(), 30ms, 10ms, sum{}};
+  process(drv, {1});
+  advance(drv, 10ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({1}));
+  advance(drv, 5ms);
+  process(drv, {2});
+  advance(drv, 5ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({3}));
+  advance(drv, 10ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({3}));
+  advance(drv, 10ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({2}));
+  CAF_CHECK(drv.awaits_tick());
+  advance(drv, 10ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>{});
+  CAF_CHECK(!drv.awaits_tick());
+}
+
+CAF_TEST(sliding windows catch up after skipping several ticks) {
+  sliding_driver drv{dm, sched.clock(), 20ms, 10ms, sum{}};
+  process(drv, {1, 2});
+  advance(drv, 10ms);
+  process(drv, {3});
+  advance(drv, 100ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({3, 6, 3}));
+  CAF_CHECK(!drv.awaits_tick());
+  process(drv, {4});
+  drv.inputs_closed(out);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({4, 4}));
+}
+
+CAF_TEST(session windows close after a gap without elements) {
+  session_driver drv{dm, sched.clock(), 10ms, sum{}};
+  process(drv, {1, 2});
+  advance(drv, 5ms);
+  process(drv, {3});
+  advance(drv, 9ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>{});
+  advance(drv, 1ms);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({6}));
+  CAF_CHECK(!drv.awaits_tick());
+  process(drv, {4});
+  drv.inputs_closed(out);
+  CAF_CHECK_EQUAL(results(), std::vector<int32_t>({4}));
+}
+
+CAF_TEST(tumbling window stages aggregate streams) {
+  auto src = sys.spawn(int_source);
+  auto stg = sys.spawn(tumbling_window, timespan{10ms});
+  auto snk = sys.spawn(collector);
+  self->send(snk * stg * src, 100);
+  run();
+  auto& xs = deref<collector_actor>(snk).state.results;
+  CAF_REQUIRE(!xs.empty());
+  CAF_CHECK_EQUAL(std::accumulate(xs.begin(), xs.end(), 0), 5050);
+}
+
+CAF_TEST(session window stages aggregate bursts) {
+  auto src = sys.spawn(int_source);
+  auto stg = sys.spawn(session_window, timespan{1s});
+  auto snk = sys.spawn(collector);
+  self->send(snk * stg * src, 100);
+  run();
+  auto& xs = deref<collector_actor>(snk).state.results;
+  CAF_CHECK_EQUAL(xs, std::vector<int32_t>({5050}));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
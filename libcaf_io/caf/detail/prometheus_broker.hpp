@@ -30,7 +30,9 @@
 
 namespace caf::detail {
 
-/// Makes system metrics in the Prometheus format available via HTTP 1.1.
+/// Makes system metrics in the Prometheus format available via HTTP 1.1. The
+/// broker generates OpenMetrics instead if the client prefers it and optionally
+/// compresses the output with gzip if the client accepts it.
 class CAF_IO_EXPORT prometheus_broker : public io::broker {
 public:
   explicit prometheus_broker(actor_config& cfg);
@@ -43,6 +45,10 @@ public:
 
   static bool has_process_metrics() noexcept;
 
+  /// Returns whether CAF was built with zlib, i.e., whether the broker may
+  /// compress its responses.
+  static bool has_gzip() noexcept;
+
   behavior make_behavior() override;
 
 private:
@@ -50,6 +56,8 @@ private:
 
   std::unordered_map<io::connection_handle, byte_buffer> requests_;
   telemetry::collector::prometheus collector_;
+  telemetry::collector::prometheus om_collector_;
+  byte_buffer gzip_buf_;
   time_t last_scrape_ = 0;
   telemetry::dbl_gauge* cpu_time_ = nullptr;
   telemetry::int_gauge* mem_size_ = nullptr;
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <string>
@@ -54,6 +57,25 @@ public:
   using monitored_actor_map
     = std::unordered_map<actor_addr, std::unordered_set<node_id>>;
 
+  using send_buffer_state = forwarding_actor_proxy::send_buffer_state;
+
+  using send_buffer_ptr = forwarding_actor_proxy::send_buffer_ptr;
+
+  /// Tracks the send buffer of a connection for stream managers.
+  struct send_buffer_entry {
+    /// State shared with all proxies that use this connection.
+    send_buffer_ptr state;
+
+    /// Bytes of the current write buffer that `state` already includes.
+    size_t counted = 0;
+
+    /// Stores whether write notifications are enabled for the connection.
+    bool acks = false;
+  };
+
+  using send_buffer_map
+    = std::unordered_map<connection_handle, send_buffer_entry>;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit basp_broker(actor_config& cfg);
@@ -116,6 +138,10 @@ public:
   /// Cleans up any state for `hdl`.
   void connection_cleanup(connection_handle hdl, sec code);
 
+  /// Returns the state of the send buffer of `hdl` or `nullptr` if `hdl` is
+  /// no direct connection to another node. Safe to call from any thread.
+  send_buffer_ptr send_buffer(connection_handle hdl);
+
   /// Sends a basp::down_message message to a remote node.
   void send_basp_down_message(const node_id& nid, actor_id aid, error err);
 
@@ -165,6 +191,15 @@ public:
 
   /// Keeps track of nodes that monitor local actors.
   monitored_actor_map monitored_actors;
+
+  /// Tracks the send buffer of direct connections. Proxies share this state
+  /// with stream managers for withholding credit from remote sinks while the
+  /// connection to their node is congested. Only the broker modifies this map.
+  send_buffer_map send_buffers;
+
+  /// Guards `send_buffers` for BASP workers that create proxies concurrently.
+  /// The broker itself only acquires this mutex for modifying the map.
+  std::mutex send_buffers_mtx;
 };
 
 } // namespace caf::io
@@ -84,6 +84,8 @@ class default_multiplexer;
 class multiplexer;
 class receive_buffer;
 
+struct socket_options;
+
 using address_listing = std::map<protocol::network, std::vector<std::string>>;
 
 } // namespace network
@@ -108,6 +110,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(io_module, detail::io_module_begin)
   CAF_ADD_TYPE_ID(io_module, (caf::io::network::address_listing))
   CAF_ADD_TYPE_ID(io_module, (caf::io::network::protocol))
   CAF_ADD_TYPE_ID(io_module, (caf::io::network::receive_buffer))
+  CAF_ADD_TYPE_ID(io_module, (caf::io::network::socket_options))
   CAF_ADD_TYPE_ID(io_module, (caf::io::new_connection_msg))
   CAF_ADD_TYPE_ID(io_module, (caf::io::new_data_msg))
   CAF_ADD_TYPE_ID(io_module, (caf::io::new_datagram_msg))
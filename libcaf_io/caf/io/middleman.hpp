@@ -104,6 +104,24 @@ public:
                    system().message_types(tk), port, in, reuse);
   }
 
+  /// Tries to publish `whom` at `port` and returns either an `error` or the
+  /// bound port. Applies `opts` to all accepted connections instead of the
+  /// default socket options from the `caf.middleman.socket` config section.
+  /// @param whom Actor that should be published at `port`.
+  /// @param port Unused TCP port.
+  /// @param in The IP address to listen to or `INADDR_ANY` if `in == nullptr`.
+  /// @param reuse Create socket using `SO_REUSEADDR`.
+  /// @param opts Tuning parameters for the TCP sockets.
+  /// @returns The actual port the OS uses after `bind()`. If `port == 0`
+  ///          the OS chooses a random high-level port.
+  template <class Handle>
+  expected<uint16_t> publish(Handle&& whom, uint16_t port, const char* in,
+                             bool reuse, const network::socket_options& opts) {
+    detail::type_list<typename std::decay<Handle>::type> tk;
+    return publish(actor_cast<strong_actor_ptr>(std::forward<Handle>(whom)),
+                   system().message_types(tk), port, in, reuse, opts);
+  }
+
   /// Makes *all* local groups accessible via network
   /// on address `addr` and `port`.
   /// @returns The actual port the OS uses after `bind()`. If `port == 0`
@@ -135,6 +153,28 @@ public:
     return actor_cast<ActorHandle>(std::move(*x));
   }
 
+  /// Establish a new connection to the actor at `host` on given `port`.
+  /// Applies `opts` to the socket instead of the default socket options from
+  /// the `caf.middleman.socket` config section.
+  /// @param host Valid hostname or IP address.
+  /// @param port TCP port.
+  /// @param opts Tuning parameters for the TCP socket.
+  /// @returns An `actor` to the proxy instance representing
+  ///          a remote actor or an `error`.
+  /// @note The middleman re-uses existing connections. Hence, `opts` has no
+  ///       effect when already connected to `host` on `port`.
+  template <class ActorHandle = actor>
+  expected<ActorHandle> remote_actor(std::string host, uint16_t port,
+                                     const network::socket_options& opts) {
+    detail::type_list<ActorHandle> tk;
+    auto x = remote_actor(system().message_types(tk), std::move(host), port,
+                          opts);
+    if (!x)
+      return x.error();
+    CAF_ASSERT(x && *x);
+    return actor_cast<ActorHandle>(std::move(*x));
+  }
+
   /// Tries to connect to a group that runs on a different node in the network.
   /// @param group_locator Locator in the format `<group-name>@<host>:<port>`.
   expected<group> remote_group(const std::string& group_locator);
@@ -377,11 +417,20 @@ private:
   publish(const strong_actor_ptr& whom, std::set<std::string> sigs,
           uint16_t port, const char* cstr, bool ru);
 
+  expected<uint16_t>
+  publish(const strong_actor_ptr& whom, std::set<std::string> sigs,
+          uint16_t port, const char* cstr, bool ru,
+          const network::socket_options& opts);
+
   expected<void> unpublish(const actor_addr& whom, uint16_t port);
 
   expected<strong_actor_ptr>
   remote_actor(std::set<std::string> ifs, std::string host, uint16_t port);
 
+  expected<strong_actor_ptr>
+  remote_actor(std::set<std::string> ifs, std::string host, uint16_t port,
+               const network::socket_options& opts);
+
   static int exec_slave_mode(actor_system&, const actor_system_config&);
 
   /// The actor environment.
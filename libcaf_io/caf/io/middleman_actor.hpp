@@ -20,6 +20,8 @@
 
 #include "caf/detail/io_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/io/fwd.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/typed_actor.hpp"
 
 namespace caf::io {
@@ -42,6 +44,12 @@ namespace caf::io {
 ///    set<string> ifs, string addr, bool reuse_addr)
 ///   -> (uint16_t)
 ///
+///   // Same as above, but applies `opts` to all accepted connections
+///   // instead of the default socket options.
+///   (publish_atom, uint16_t port, strong_actor_ptr whom,
+///    set<string> ifs, string addr, bool reuse_addr, socket_options opts)
+///   -> (uint16_t)
+///
 ///   // Opens a new port other CAF instances can connect to. The
 ///   // difference between `PUBLISH` and `OPEN` is that no actor is mapped to
 ///   // this port, meaning that connecting nodes only get a valid `node_id`
@@ -62,6 +70,11 @@ namespace caf::io {
 ///   (connect_atom, string hostname, uint16_t port)
 ///   -> (node_id nid, strong_actor_ptr remote_actor, set<string> ifs)
 ///
+///   // Same as above, but applies `opts` to the socket instead of the default
+///   // socket options when establishing a new connection.
+///   (connect_atom, string hostname, uint16_t port, socket_options opts)
+///   -> (node_id nid, strong_actor_ptr remote_actor, set<string> ifs)
+///
 ///   // Closes `port` if it is mapped to `whom`.
 ///   // whom: A published actor.
 ///   // port: Used TCP port.
@@ -89,11 +102,17 @@ using middleman_actor = typed_actor<
   replies_to<publish_atom, uint16_t, strong_actor_ptr, std::set<std::string>,
              std::string, bool>::with<uint16_t>,
 
+  replies_to<publish_atom, uint16_t, strong_actor_ptr, std::set<std::string>,
+             std::string, bool, network::socket_options>::with<uint16_t>,
+
   replies_to<open_atom, uint16_t, std::string, bool>::with<uint16_t>,
 
   replies_to<connect_atom, std::string,
              uint16_t>::with<node_id, strong_actor_ptr, std::set<std::string>>,
 
+  replies_to<connect_atom, std::string, uint16_t, network::socket_options>::
+    with<node_id, strong_actor_ptr, std::set<std::string>>,
+
   reacts_to<unpublish_atom, actor_addr, uint16_t>,
 
   reacts_to<close_atom, uint16_t>,
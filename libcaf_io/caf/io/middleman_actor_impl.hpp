@@ -22,6 +22,7 @@
 #include "caf/fwd.hpp"
 #include "caf/io/fwd.hpp"
 #include "caf/io/middleman_actor.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/typed_actor.hpp"
 #include "caf/typed_event_based_actor.hpp"
 
@@ -62,7 +63,13 @@ public:
 
 protected:
   /// Tries to connect to given `host` and `port`. The default implementation
-  /// calls `system().middleman().backend().new_tcp_scribe(host, port)`.
+  /// calls `system().middleman().backend().new_tcp_scribe(host, port, opts)`.
+  virtual expected<scribe_ptr> connect(const std::string& host, uint16_t port,
+                                       const network::socket_options& opts);
+
+  /// Tries to connect to given `host` and `port` using the default socket
+  /// options.
+  /// @deprecated CAF only calls the overload with socket options.
   virtual expected<scribe_ptr> connect(const std::string& host, uint16_t port);
 
   /// Tries to connect to given `host` and `port`. The default implementation
@@ -71,7 +78,14 @@ protected:
   contact(const std::string& host, uint16_t port);
 
   /// Tries to open a local port. The default implementation calls
-  /// `system().middleman().backend().new_tcp_doorman(port, addr, reuse)`.
+  /// `system().middleman().backend().new_tcp_doorman(port, addr, reuse,
+  /// opts)`.
+  virtual expected<doorman_ptr> open(uint16_t port, const char* addr,
+                                     bool reuse,
+                                     const network::socket_options& opts);
+
+  /// Tries to open a local port using the default socket options.
+  /// @deprecated CAF only calls the overload with socket options.
   virtual expected<doorman_ptr>
   open(uint16_t port, const char* addr, bool reuse);
 
@@ -82,7 +96,11 @@ protected:
 
 private:
   put_res put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
-              const char* in = nullptr, bool reuse_addr = false);
+              const char* in, bool reuse_addr,
+              const network::socket_options& opts);
+
+  get_res get_endpoint(std::string& hostname, uint16_t port,
+                       const network::socket_options& opts);
 
   put_res put_udp(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
                   const char* in = nullptr, bool reuse_addr = false);
@@ -96,6 +114,9 @@ private:
   std::map<endpoint, endpoint_data> cached_tcp_;
   std::map<endpoint, endpoint_data> cached_udp_;
   std::map<endpoint, std::vector<response_promise>> pending_;
+
+  /// Socket options for requests that do not specify their own.
+  network::socket_options socket_options_;
 };
 
 } // namespace caf::io
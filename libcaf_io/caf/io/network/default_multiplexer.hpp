@@ -42,6 +42,7 @@
 #include "caf/io/network/pipe_reader.hpp"
 #include "caf/io/network/receive_buffer.hpp"
 #include "caf/io/network/rw_state.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/io/network/stream_manager.hpp"
 #include "caf/io/receive_policy.hpp"
 #include "caf/io/scribe.hpp"
@@ -115,14 +116,25 @@ public:
 
   scribe_ptr new_scribe(native_socket fd) override;
 
+  /// Creates a new `scribe` from a native socket handle and applies `opts` to
+  /// the socket.
+  scribe_ptr new_scribe(native_socket fd, const socket_options& opts);
+
   expected<scribe_ptr>
   new_tcp_scribe(const std::string& host, uint16_t port) override;
 
+  expected<scribe_ptr> new_tcp_scribe(const std::string& host, uint16_t port,
+                                      const socket_options& opts) override;
+
   doorman_ptr new_doorman(native_socket fd) override;
 
   expected<doorman_ptr>
   new_tcp_doorman(uint16_t port, const char* in, bool reuse_addr) override;
 
+  expected<doorman_ptr>
+  new_tcp_doorman(uint16_t port, const char* in, bool reuse_addr,
+                  const socket_options& opts) override;
+
   datagram_servant_ptr new_datagram_servant(native_socket fd) override;
 
   datagram_servant_ptr
@@ -175,6 +187,12 @@ public:
   /// Returns the number of socket handlers.
   size_t num_socket_handlers() const noexcept;
 
+  /// Returns the socket options for connections that do not override them,
+  /// as configured in the `caf.middleman.socket` section.
+  const socket_options& default_socket_options() const noexcept {
+    return socket_options_;
+  }
+
   /// Run all pending events generated from calls to `add` or `del`.
   void handle_internal_events();
 
@@ -263,6 +281,12 @@ private:
 
   /// Maximum messages per resume run.
   size_t max_throughput_;
+
+  /// Default options for new TCP sockets.
+  socket_options socket_options_;
+
+  /// Time span for polling without blocking before waiting for events.
+  timespan spin_duration_;
 };
 
 inline connection_handle conn_hdl_from_socket(native_socket fd) {
@@ -277,9 +301,22 @@ CAF_IO_EXPORT expected<native_socket>
 new_tcp_connection(const std::string& host, uint16_t port,
                    optional<protocol::network> preferred = none);
 
+/// Connects to `host` on given `port`, setting the socket buffer sizes from
+/// `opts` before calling `connect`.
+CAF_IO_EXPORT expected<native_socket>
+new_tcp_connection(const std::string& host, uint16_t port,
+                   const socket_options& opts,
+                   optional<protocol::network> preferred = none);
+
 CAF_IO_EXPORT expected<native_socket>
 new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr);
 
+/// Opens a listening socket, setting the socket buffer sizes from `opts`
+/// before calling `listen` for accepted sockets to inherit them.
+CAF_IO_EXPORT expected<native_socket>
+new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr,
+                      const socket_options& opts);
+
 expected<std::pair<native_socket, ip_endpoint>>
 new_remote_udp_endpoint_impl(const std::string& host, uint16_t port,
                              optional<protocol::network> preferred = none);
@@ -23,6 +23,7 @@
 #include "caf/io/fwd.hpp"
 #include "caf/io/network/acceptor_impl.hpp"
 #include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/policy/tcp.hpp"
 
 namespace caf::io::network {
@@ -32,6 +33,9 @@ class CAF_IO_EXPORT doorman_impl : public doorman {
 public:
   doorman_impl(default_multiplexer& mx, native_socket sockfd);
 
+  doorman_impl(default_multiplexer& mx, native_socket sockfd,
+               socket_options opts);
+
   bool new_connection() override;
 
   void graceful_shutdown() override;
@@ -48,6 +52,9 @@ public:
 
 protected:
   acceptor_impl<policy::tcp> acceptor_;
+
+  /// Options for all accepted sockets.
+  socket_options opts_;
 };
 
 } // namespace caf::io::network
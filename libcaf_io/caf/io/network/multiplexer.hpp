@@ -32,6 +32,7 @@
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
 #include "caf/io/network/protocol.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/resumable.hpp"
 
@@ -54,6 +55,14 @@ public:
   virtual expected<scribe_ptr>
   new_tcp_scribe(const std::string& host, uint16_t port) = 0;
 
+  /// Tries to connect to `host` on given `port` and returns a `scribe` instance
+  /// on success. Applies `opts` to the socket before connecting. The default
+  /// implementation ignores `opts` and calls `new_tcp_scribe(host, port)`.
+  /// @threadsafe
+  virtual expected<scribe_ptr> new_tcp_scribe(const std::string& host,
+                                              uint16_t port,
+                                              const socket_options& opts);
+
   /// Creates a new doorman from a native socket handle.
   /// @threadsafe
   virtual doorman_ptr new_doorman(native_socket fd) = 0;
@@ -66,6 +75,15 @@ public:
                   bool reuse_addr = false)
     = 0;
 
+  /// Tries to create an unbound TCP doorman bound to `port`, optionally
+  /// accepting only connections from IP address `in`. Applies `opts` to all
+  /// accepted connections. The default implementation ignores `opts` and calls
+  /// `new_tcp_doorman(port, in, reuse_addr)`.
+  /// @warning Do not call from outside the multiplexer's event loop.
+  virtual expected<doorman_ptr>
+  new_tcp_doorman(uint16_t port, const char* in, bool reuse_addr,
+                  const socket_options& opts);
+
   /// Creates a new `datagram_servant` from a native socket handle.
   /// @threadsafe
   virtual datagram_servant_ptr new_datagram_servant(native_socket fd) = 0;
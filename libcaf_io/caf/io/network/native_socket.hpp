@@ -116,6 +116,28 @@ CAF_IO_EXPORT expected<int> send_buffer_size(native_socket fd);
 /// Set the socket buffer size for `fd`.
 CAF_IO_EXPORT expected<void> send_buffer_size(native_socket fd, int new_value);
 
+/// Get the receive buffer size for `fd`.
+CAF_IO_EXPORT expected<int> receive_buffer_size(native_socket fd);
+
+/// Set the receive buffer size for `fd`.
+CAF_IO_EXPORT expected<void>
+receive_buffer_size(native_socket fd, int new_value);
+
+/// Sets the approximate time in microseconds to busy poll on a blocking
+/// receive when there is no data (`SO_BUSY_POLL`). Only supported on Linux,
+/// a nop on all other platforms.
+CAF_IO_EXPORT expected<void> busy_poll(native_socket fd, int new_value);
+
+/// Enables or disables quickack mode on `fd` (`TCP_QUICKACK`). Only supported
+/// on Linux, a nop on all other platforms.
+CAF_IO_EXPORT expected<void> tcp_quickack(native_socket fd, bool new_value);
+
+/// Limits the number of unsent bytes in the socket's write queue before the
+/// kernel reports `fd` as writable (`TCP_NOTSENT_LOWAT`). A nop on platforms
+/// that lack this option.
+CAF_IO_EXPORT expected<void>
+tcp_notsent_lowat(native_socket fd, int new_value);
+
 /// Convenience functions for checking the result of `recv` or `send`.
 CAF_IO_EXPORT bool is_error(signed_size_type res, bool is_nonblock);
 
@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "caf/detail/io_export.hpp"
+#include "caf/error.hpp"
+#include "caf/fwd.hpp"
+#include "caf/io/network/native_socket.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::io::network {
+
+/// Bundles tuning parameters for TCP sockets. Passing an instance to `publish`
+/// or `remote_actor` overrides the system-wide defaults from the
+/// `caf.middleman.socket` config section for a single endpoint. Zero values
+/// for sizes and durations leave the operating system defaults in place.
+struct socket_options {
+  /// Disables Nagle's algorithm (`TCP_NODELAY`).
+  bool tcp_nodelay = true;
+
+  /// Enables TCP keepalive probes (`SO_KEEPALIVE`).
+  bool keepalive = true;
+
+  /// Enables quickack mode (`TCP_QUICKACK`, Linux only).
+  /// @note The kernel may leave quickack mode again on its own, i.e., the
+  ///       option is not permanent. CAF only sets it when creating the socket.
+  bool tcp_quickack = false;
+
+  /// Size of the kernel send buffer in bytes (`SO_SNDBUF`).
+  int32_t send_buffer_size = 0;
+
+  /// Size of the kernel receive buffer in bytes (`SO_RCVBUF`).
+  int32_t receive_buffer_size = 0;
+
+  /// Maximum number of unsent bytes in the write queue before the socket
+  /// becomes writable again (`TCP_NOTSENT_LOWAT`).
+  int32_t tcp_notsent_lowat = 0;
+
+  /// Time to busy poll the device queue on receive (`SO_BUSY_POLL`, Linux
+  /// only). The kernel uses microsecond granularity.
+  timespan busy_poll = timespan{0};
+};
+
+/// Reads the `caf.middleman.socket` section from `cfg`, falling back to the
+/// default values of `socket_options` for all absent parameters.
+CAF_IO_EXPORT socket_options
+make_socket_options(const actor_system_config& cfg);
+
+/// Applies `opts` to `fd`. Options that the platform does not support are
+/// silently ignored. Tries to apply all options even if setting one of them
+/// fails and logs each failure.
+/// @returns The first error or `none` if all options took effect.
+/// @note Buffer sizes should be set before calling `connect` or `listen` for
+///       the kernel to take them into account for TCP window scaling.
+CAF_IO_EXPORT error apply(native_socket fd, const socket_options& opts);
+
+/// @relates socket_options
+template <class Inspector>
+bool inspect(Inspector& f, socket_options& x) {
+  return f.object(x).fields(f.field("tcp-nodelay", x.tcp_nodelay),
+                            f.field("keepalive", x.keepalive),
+                            f.field("tcp-quickack", x.tcp_quickack),
+                            f.field("send-buffer-size", x.send_buffer_size),
+                            f.field("receive-buffer-size",
+                                    x.receive_buffer_size),
+                            f.field("tcp-notsent-lowat", x.tcp_notsent_lowat),
+                            f.field("busy-poll", x.busy_poll));
+}
+
+} // namespace caf::io::network
@@ -38,6 +38,10 @@ public:
 
   ~test_multiplexer() override;
 
+  using multiplexer::new_tcp_doorman;
+
+  using multiplexer::new_tcp_scribe;
+
   scribe_ptr new_scribe(native_socket) override;
 
   expected<scribe_ptr> new_tcp_scribe(const std::string& host,
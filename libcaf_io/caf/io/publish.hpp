@@ -45,4 +45,22 @@ expected<uint16_t> publish(const Handle& whom, uint16_t port,
   return sys.middleman().publish(whom, port, in, reuse);
 }
 
+/// Tries to publish `whom` at `port` and returns either an `error` or the
+/// bound port. Applies `opts` to all accepted connections.
+/// @param whom Actor that should be published at `port`.
+/// @param port Unused TCP port.
+/// @param in The IP address to listen to or `INADDR_ANY` if `in == nullptr`.
+/// @param reuse Create socket using `SO_REUSEADDR`.
+/// @param opts Tuning parameters for the TCP sockets.
+/// @returns The actual port the OS uses after `bind()`. If `port == 0`
+///          the OS chooses a random high-level port.
+template <class Handle>
+expected<uint16_t> publish(const Handle& whom, uint16_t port, const char* in,
+                           bool reuse, const network::socket_options& opts) {
+  if (!whom)
+    return sec::cannot_publish_invalid_actor;
+  auto& sys = whom.home_system();
+  return sys.middleman().publish(whom, port, in, reuse, opts);
+}
+
 } // namespace caf::io
@@ -39,4 +39,19 @@ remote_actor(actor_system& sys, std::string host, uint16_t port) {
   return sys.middleman().remote_actor<ActorHandle>(std::move(host), port);
 }
 
+/// Establish a new connection to the actor at `host` on given `port`, applying
+/// `opts` to the socket.
+/// @param host Valid hostname or IP address.
+/// @param port TCP port.
+/// @param opts Tuning parameters for the TCP socket.
+/// @returns An `actor` to the proxy instance representing
+///          a remote actor or an `error`.
+template <class ActorHandle = actor>
+expected<ActorHandle> remote_actor(actor_system& sys, std::string host,
+                                   uint16_t port,
+                                   const network::socket_options& opts) {
+  return sys.middleman().remote_actor<ActorHandle>(std::move(host), port,
+                                                   opts);
+}
+
 } // namespace caf::io
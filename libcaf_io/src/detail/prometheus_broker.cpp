@@ -18,12 +18,22 @@
 
 #include "caf/detail/prometheus_broker.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
 #include "caf/span.hpp"
 #include "caf/string_algorithms.hpp"
 #include "caf/string_view.hpp"
 #include "caf/telemetry/dbl_gauge.hpp"
 #include "caf/telemetry/int_gauge.hpp"
 
+#ifdef CAF_ENABLE_ZLIB
+#  include <zlib.h>
+#endif // CAF_ENABLE_ZLIB
+
 namespace {
 
 struct [[maybe_unused]] sys_stats {
@@ -182,8 +192,93 @@ constexpr string_view request_not_supported = "HTTP/1.1 501 Not Implemented\r\n"
 
 // HTTP header when sending a payload.
 constexpr string_view request_ok = "HTTP/1.1 200 OK\r\n"
-                                   "Content-Type: text/plain\r\n"
-                                   "Connection: Closed\r\n\r\n";
+                                   "Content-Type: ";
+
+// HTTP header field for compressed payloads.
+constexpr string_view gzip_encoding = "\r\nContent-Encoding: gzip";
+
+// Last HTTP header field plus the empty line that separates the payload.
+constexpr string_view request_ok_end = "\r\nConnection: Closed\r\n\r\n";
+
+string_view trim(string_view str) {
+  auto is_space = [](char c) { return c == ' ' || c == '\t'; };
+  while (!str.empty() && is_space(str.front()))
+    str.remove_prefix(1);
+  while (!str.empty() && is_space(str.back()))
+    str.remove_suffix(1);
+  return str;
+}
+
+bool icase_equal(string_view x, string_view y) {
+  auto eq = [](char lhs, char rhs) {
+    return tolower(static_cast<unsigned char>(lhs))
+           == tolower(static_cast<unsigned char>(rhs));
+  };
+  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), eq);
+}
+
+// Returns the value of the HTTP header field `name` or an empty string.
+string_view header_field(string_view request, string_view name) {
+  // Skip the request line.
+  auto pos = request.find("\r\n");
+  while (pos != string_view::npos) {
+    request.remove_prefix(pos + 2);
+    pos = request.find("\r\n");
+    auto line = request.substr(0, pos);
+    auto sep = line.find(':');
+    if (sep != string_view::npos && icase_equal(line.substr(0, sep), name))
+      return trim(line.substr(sep + 1));
+  }
+  return {};
+}
+
+// Returns the quality value for `what` in a list such as the value of the
+// header fields `Accept` or `Accept-Encoding` or -1 if the list does not
+// contain `what`.
+double quality(string_view list, string_view what) {
+  std::vector<string_view> items;
+  split(items, list, ",");
+  for (auto item : items) {
+    std::vector<string_view> params;
+    split(params, item, ";");
+    if (params.empty() || !icase_equal(trim(params[0]), what))
+      continue;
+    for (size_t index = 1; index < params.size(); ++index) {
+      auto param = trim(params[index]);
+      if (starts_with(param, "q=")) {
+        std::string str{param.begin() + 2, param.end()};
+        return strtod(str.c_str(), nullptr);
+      }
+    }
+    return 1.0;
+  }
+  return -1.0;
+}
+
+#ifdef CAF_ENABLE_ZLIB
+
+// Compresses `text` in the gzip format and stores the result in `dst`.
+bool gzip_compress(string_view text, byte_buffer& dst) {
+  z_stream strm;
+  memset(&strm, 0, sizeof(z_stream));
+  // Adding 16 to the window bits selects the gzip format. We trade compression
+  // ratio for speed, since the broker runs on the multiplexer thread.
+  if (deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY)
+      != Z_OK)
+    return false;
+  dst.resize(deflateBound(&strm, static_cast<uLong>(text.size())));
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+  strm.avail_in = static_cast<uInt>(text.size());
+  strm.next_out = reinterpret_cast<Bytef*>(dst.data());
+  strm.avail_out = static_cast<uInt>(dst.size());
+  auto res = deflate(&strm, Z_FINISH);
+  dst.resize(strm.total_out);
+  deflateEnd(&strm);
+  return res == Z_STREAM_END;
+}
+
+#endif // CAF_ENABLE_ZLIB
 
 } // namespace
 
@@ -199,6 +294,8 @@ prometheus_broker::prometheus_broker(actor_config& cfg) : io::broker(cfg) {
   virt_mem_size_ = reg.gauge_singleton("process", "virtual_memory",
                                        "Virtual memory size.", "bytes");
 #endif // HAS_PROCESS_METRICS
+  om_collector_.output_format(
+    telemetry::collector::prometheus::format::openmetrics);
 }
 
 prometheus_broker::prometheus_broker(actor_config& cfg, io::doorman_ptr ptr)
@@ -222,6 +319,14 @@ bool prometheus_broker::has_process_metrics() noexcept {
 #endif // HAS_PROCESS_METRICS
 }
 
+bool prometheus_broker::has_gzip() noexcept {
+#ifdef CAF_ENABLE_ZLIB
+  return true;
+#else  // CAF_ENABLE_ZLIB
+  return false;
+#endif // CAF_ENABLE_ZLIB
+}
+
 behavior prometheus_broker::make_behavior() {
   return {
     [=](const io::new_data_msg& msg) {
@@ -251,13 +356,36 @@ behavior prometheus_broker::make_behavior() {
         flush_and_close();
         return;
       }
+      // Pick the output format and encoding based on the request header.
+      auto accept = header_field(req_str, "Accept");
+      auto om_quality = quality(accept, "application/openmetrics-text");
+      auto use_om = om_quality > 0
+                    && om_quality >= quality(accept, "text/plain");
+      auto& collector = use_om ? om_collector_ : collector_;
+      auto use_gzip = has_gzip()
+                      && quality(header_field(req_str, "Accept-Encoding"),
+                                 "gzip")
+                           > 0;
       // Collect metrics, ship response, and close.
       scrape();
-      auto hdr = as_bytes(make_span(request_ok));
-      auto text = collector_.collect_from(system().metrics());
+      auto text = collector.collect_from(system().metrics());
       auto payload = as_bytes(make_span(text));
+#ifdef CAF_ENABLE_ZLIB
+      if (use_gzip && gzip_compress(text, gzip_buf_))
+        payload = as_bytes(make_span(gzip_buf_));
+      else
+        use_gzip = false;
+#endif // CAF_ENABLE_ZLIB
       auto& dst = wr_buf(msg.handle);
-      dst.insert(dst.end(), hdr.begin(), hdr.end());
+      auto add = [&dst](string_view str) {
+        auto bytes = as_bytes(make_span(str));
+        dst.insert(dst.end(), bytes.begin(), bytes.end());
+      };
+      add(request_ok);
+      add(collector.content_type());
+      if (use_gzip)
+        add(gzip_encoding);
+      add(request_ok_end);
       dst.insert(dst.end(), payload.begin(), payload.end());
       flush_and_close();
     },
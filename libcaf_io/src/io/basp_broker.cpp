@@ -257,6 +257,21 @@ behavior basp_broker::make_behavior() {
       flush(msg.handle);
       configure_read(msg.handle, receive_policy::exactly(basp::header_size));
     },
+    // received from underlying broker implementation for connections with
+    // write notifications, i.e., connections with observed send buffers
+    [=](const data_transferred_msg& msg) {
+      if (auto i = send_buffers.find(msg.handle); i != send_buffers.end()) {
+        auto& entry = i->second;
+        // The scribe reports all unsent Bytes, including our write buffer.
+        // Hence, this corrects any drift from counting Bytes on flush.
+        entry.state->pending_bytes.store(msg.remaining,
+                                         std::memory_order_relaxed);
+        // The scribe takes over our write buffer after sending everything
+        // else, i.e., only a non-empty remainder keeps our Bytes in place.
+        auto buffered = wr_buf(msg.handle).size();
+        entry.counted = msg.remaining > buffered ? buffered : 0;
+      }
+    },
     // received from underlying broker implementation
     [=](const connection_closed_msg& msg) {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
@@ -409,9 +424,14 @@ strong_actor_ptr basp_broker::make_proxy(node_id nid, actor_id aid) {
   // use a direct route if possible, i.e., when talking to a third node
   // create proxy and add functor that will be called if we
   // receive a basp::down_message
+  // proxies share the counter for the send buffer of their route in order to
+  // allow stream managers to withhold credit while the connection is congested
+  send_buffer_ptr buf;
+  if (auto route = instance.tbl().lookup(nid))
+    buf = send_buffer(route->hdl);
   actor_config cfg;
   auto res = make_actor<forwarding_actor_proxy, strong_actor_ptr>(
-    aid, nid, &(system()), cfg, this);
+    aid, nid, &(system()), cfg, this, std::move(buf));
   strong_actor_ptr selfptr{ctrl()};
   res->get()->attach_functor([=](const error& rsn) {
     mm->backend().post([=] {
@@ -572,6 +592,12 @@ void basp_broker::learned_new_node(const node_id& nid) {
 void basp_broker::learned_new_node_directly(const node_id& nid,
                                             bool was_indirectly_before) {
   CAF_LOG_TRACE(CAF_ARG(nid));
+  if (auto route = instance.tbl().lookup(nid)) {
+    std::unique_lock<std::mutex> guard{send_buffers_mtx};
+    auto& entry = send_buffers[route->hdl];
+    if (entry.state == nullptr)
+      entry.state = std::make_shared<send_buffer_state>();
+  }
   if (!was_indirectly_before)
     learned_new_node(nid);
 }
@@ -640,6 +666,19 @@ void basp_broker::connection_cleanup(connection_handle hdl, sec code) {
     }
     ctx.erase(i);
   }
+  // Reset the send buffer state, since proxies may outlive `hdl`.
+  std::unique_lock<std::mutex> guard{send_buffers_mtx};
+  if (auto j = send_buffers.find(hdl); j != send_buffers.end()) {
+    j->second.state->pending_bytes.store(0, std::memory_order_relaxed);
+    send_buffers.erase(j);
+  }
+}
+
+basp_broker::send_buffer_ptr basp_broker::send_buffer(connection_handle hdl) {
+  std::unique_lock<std::mutex> guard{send_buffers_mtx};
+  if (auto i = send_buffers.find(hdl); i != send_buffers.end())
+    return i->second.state;
+  return nullptr;
 }
 
 byte_buffer& basp_broker::get_buffer(connection_handle hdl) {
@@ -647,7 +686,35 @@ byte_buffer& basp_broker::get_buffer(connection_handle hdl) {
 }
 
 void basp_broker::flush(connection_handle hdl) {
+  // No locking required, since only the broker modifies `send_buffers`.
+  auto i = send_buffers.find(hdl);
+  if (i == send_buffers.end()) {
+    super::flush(hdl);
+    return;
+  }
+  auto& entry = i->second;
+  auto& pending = entry.state->pending_bytes;
+  // Only track the send buffer while stream paths observe it, because write
+  // notifications add a message to the broker for each write event.
+  auto observed = entry.state->observers.load(std::memory_order_relaxed) > 0;
+  if (observed != entry.acks) {
+    ack_writes(hdl, observed);
+    entry.acks = observed;
+    entry.counted = 0;
+    pending.store(0, std::memory_order_relaxed);
+  }
+  if (!entry.acks) {
+    super::flush(hdl);
+    return;
+  }
+  // Flushing does not hand over the buffer while the scribe writes. Hence,
+  // the buffer may contain Bytes that we already counted on a previous flush.
+  auto& buf = wr_buf(hdl);
+  if (buf.size() < entry.counted)
+    entry.counted = 0;
+  pending.fetch_add(buf.size() - entry.counted, std::memory_order_relaxed);
   super::flush(hdl);
+  entry.counted = wr_buf(hdl).size();
 }
 
 void basp_broker::handle_heartbeat() {
@@ -46,6 +46,7 @@
 #include "caf/io/basp_broker.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/io/network/interfaces.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/io/network/test_multiplexer.hpp"
 #include "caf/io/system_messages.hpp"
 #include "caf/logger.hpp"
@@ -63,10 +64,34 @@
 #  include <io.h>
 #endif // CAF_WINDOWS
 
+#ifdef CAF_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif // CAF_LINUX
+
 namespace caf::io {
 
 namespace {
 
+// Pins the calling thread to `cpu`. Only supported on Linux.
+void set_cpu_affinity([[maybe_unused]] int32_t cpu) {
+#ifdef CAF_LINUX
+  if (cpu >= CPU_SETSIZE) {
+    CAF_LOG_WARNING("CPU index out of range:" << CAF_ARG(cpu));
+    return;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(static_cast<size_t>(cpu), &cpus);
+  if (auto res = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      res != 0)
+    CAF_LOG_WARNING("unable to pin multiplexer thread:" << CAF_ARG(cpu)
+                                                        << strerror(res));
+#else
+  CAF_LOG_WARNING("CPU affinity is not supported on this platform");
+#endif
+}
+
 auto make_metrics(telemetry::metric_registry& reg) {
   std::array<double, 9> default_time_buckets{{
     .0002, //  20us
@@ -79,16 +104,23 @@ auto make_metrics(telemetry::metric_registry& reg) {
     .05,   //  50ms
     .1,    // 100ms
   }};
-  std::array<int64_t, 9> default_size_buckets{{
-    100,
-    500,
-    1'000,
-    5'000,
-    10'000,
-    50'000,
-    100'000,
-    500'000,
-    1'000'000,
+  // Consecutive powers of two allow the histograms to compute the bucket of
+  // each message size in constant time.
+  std::array<int64_t, 14> default_size_buckets{{
+    128,
+    256,
+    512,
+    1'024,
+    2'048,
+    4'096,
+    8'192,
+    16'384,
+    32'768,
+    65'536,
+    131'072,
+    262'144,
+    524'288,
+    1'048'576,
   }};
   return middleman::metric_singletons_t{
     reg.histogram_singleton(
@@ -202,7 +234,20 @@ void middleman::add_module_options(actor_system_config& cfg) {
                "schedule utility actors instead of dedicating threads")
     .add<bool>("manual-multiplexing",
                "disables background activity of the multiplexer")
-    .add<size_t>("workers", "number of deserialization workers");
+    .add<size_t>("workers", "number of deserialization workers")
+    .add<timespan>("spin-duration",
+                   "time for polling without blocking before waiting")
+    .add<int32_t>("cpu-affinity", "pins the multiplexer thread to a CPU");
+  config_option_adder{cfg.custom_options(), "caf.middleman.socket"}
+    .add<bool>("tcp-nodelay", "disables Nagle's algorithm (TCP_NODELAY)")
+    .add<bool>("keepalive", "enables TCP keepalive probes (SO_KEEPALIVE)")
+    .add<bool>("tcp-quickack", "enables quickack mode (TCP_QUICKACK)")
+    .add<int32_t>("send-buffer-size", "size of the kernel send buffer")
+    .add<int32_t>("receive-buffer-size", "size of the kernel receive buffer")
+    .add<int32_t>("tcp-notsent-lowat",
+                  "max. unsent bytes in the write queue (TCP_NOTSENT_LOWAT)")
+    .add<timespan>("busy-poll",
+                   "busy-poll duration on blocking receives (SO_BUSY_POLL)");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket");
@@ -254,14 +299,24 @@ expected<node_id> middleman::connect(std::string host, uint16_t port) {
 expected<uint16_t> middleman::publish(const strong_actor_ptr& whom,
                                       std::set<std::string> sigs, uint16_t port,
                                       const char* cstr, bool ru) {
-  CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(port));
+  return publish(whom, std::move(sigs), port, cstr, ru,
+                 network::make_socket_options(system().config()));
+}
+
+expected<uint16_t> middleman::publish(const strong_actor_ptr& whom,
+                                      std::set<std::string> sigs, uint16_t port,
+                                      const char* cstr, bool ru,
+                                      const network::socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(port)
+                              << CAF_ARG(opts));
   if (!whom)
     return sec::cannot_publish_invalid_actor;
   std::string in;
   if (cstr != nullptr)
     in = cstr;
   auto f = make_function_view(actor_handle());
-  return f(publish_atom_v, port, std::move(whom), std::move(sigs), in, ru);
+  return f(publish_atom_v, port, std::move(whom), std::move(sigs), in, ru,
+           opts);
 }
 
 expected<uint16_t> middleman::publish_local_groups(uint16_t port,
@@ -294,9 +349,17 @@ expected<void> middleman::unpublish(const actor_addr& whom, uint16_t port) {
 expected<strong_actor_ptr> middleman::remote_actor(std::set<std::string> ifs,
                                                    std::string host,
                                                    uint16_t port) {
-  CAF_LOG_TRACE(CAF_ARG(ifs) << CAF_ARG(host) << CAF_ARG(port));
+  return remote_actor(std::move(ifs), std::move(host), port,
+                      network::make_socket_options(system().config()));
+}
+
+expected<strong_actor_ptr>
+middleman::remote_actor(std::set<std::string> ifs, std::string host,
+                        uint16_t port, const network::socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(ifs) << CAF_ARG(host) << CAF_ARG(port)
+                             << CAF_ARG(opts));
   auto f = make_function_view(actor_handle());
-  auto res = f(connect_atom_v, std::move(host), port);
+  auto res = f(connect_atom_v, std::move(host), port, opts);
   if (!res)
     return std::move(res.error());
   strong_actor_ptr ptr = std::move(std::get<1>(*res));
@@ -435,9 +498,13 @@ void middleman::start() {
     std::atomic<bool> init_done{false};
     std::mutex mtx;
     std::condition_variable cv;
-    thread_ = std::thread{[&, this] {
+    auto cpu = get_or(config(), "caf.middleman.cpu-affinity",
+                      defaults::middleman::cpu_affinity);
+    thread_ = std::thread{[&, cpu, this] {
       CAF_SET_LOGGER_SYS(&system());
       detail::set_thread_name("caf.multiplexer");
+      if (cpu >= 0)
+        set_cpu_affinity(cpu);
       system().thread_started();
       CAF_LOG_TRACE("");
       {
@@ -40,7 +40,9 @@ namespace caf::io {
 
 middleman_actor_impl::middleman_actor_impl(actor_config& cfg,
                                            actor default_broker)
-  : middleman_actor::base(cfg), broker_(std::move(default_broker)) {
+  : middleman_actor::base(cfg),
+    broker_(std::move(default_broker)),
+    socket_options_(network::make_socket_options(system().config())) {
   set_down_handler([=](down_msg& dm) {
     auto i = cached_tcp_.begin();
     auto e = cached_tcp_.end();
@@ -77,66 +79,28 @@ auto middleman_actor_impl::make_behavior() -> behavior_type {
     [=](publish_atom, uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
         std::string& addr, bool reuse) -> put_res {
       CAF_LOG_TRACE("");
-      return put(port, whom, sigs, addr.c_str(), reuse);
+      return put(port, whom, sigs, addr.c_str(), reuse, socket_options_);
+    },
+    [=](publish_atom, uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
+        std::string& addr, bool reuse,
+        const network::socket_options& opts) -> put_res {
+      CAF_LOG_TRACE("");
+      return put(port, whom, sigs, addr.c_str(), reuse, opts);
     },
     [=](open_atom, uint16_t port, std::string& addr, bool reuse) -> put_res {
       CAF_LOG_TRACE("");
       strong_actor_ptr whom;
       mpi_set sigs;
-      return put(port, whom, sigs, addr.c_str(), reuse);
+      return put(port, whom, sigs, addr.c_str(), reuse, socket_options_);
     },
     [=](connect_atom, std::string& hostname, uint16_t port) -> get_res {
       CAF_LOG_TRACE(CAF_ARG(hostname) << CAF_ARG(port));
-      auto rp = make_response_promise();
-      endpoint key{std::move(hostname), port};
-      // respond immediately if endpoint is cached
-      auto x = cached_tcp(key);
-      if (x) {
-        CAF_LOG_DEBUG("found cached entry" << CAF_ARG(*x));
-        rp.deliver(get<0>(*x), get<1>(*x), get<2>(*x));
-        return get_delegated{};
-      }
-      // attach this promise to a pending request if possible
-      auto rps = pending(key);
-      if (rps) {
-        CAF_LOG_DEBUG("attach to pending request");
-        rps->emplace_back(std::move(rp));
-        return get_delegated{};
-      }
-      // connect to endpoint and initiate handhsake etc.
-      auto r = connect(key.first, port);
-      if (!r) {
-        rp.deliver(std::move(r.error()));
-        return get_delegated{};
-      }
-      auto& ptr = *r;
-      std::vector<response_promise> tmp{std::move(rp)};
-      pending_.emplace(key, std::move(tmp));
-      request(broker_, infinite, connect_atom_v, std::move(ptr), port)
-        .then(
-          [=](node_id& nid, strong_actor_ptr& addr, mpi_set& sigs) {
-            auto i = pending_.find(key);
-            if (i == pending_.end())
-              return;
-            if (nid && addr) {
-              monitor(addr);
-              cached_tcp_.emplace(key, std::make_tuple(nid, addr, sigs));
-            }
-            auto res
-              = make_message(std::move(nid), std::move(addr), std::move(sigs));
-            for (auto& promise : i->second)
-              promise.deliver(res);
-            pending_.erase(i);
-          },
-          [=](error& err) {
-            auto i = pending_.find(key);
-            if (i == pending_.end())
-              return;
-            for (auto& promise : i->second)
-              promise.deliver(err);
-            pending_.erase(i);
-          });
-      return get_delegated{};
+      return get_endpoint(hostname, port, socket_options_);
+    },
+    [=](connect_atom, std::string& hostname, uint16_t port,
+        const network::socket_options& opts) -> get_res {
+      CAF_LOG_TRACE(CAF_ARG(hostname) << CAF_ARG(port) << CAF_ARG(opts));
+      return get_endpoint(hostname, port, opts);
     },
     [=](unpublish_atom atm, actor_addr addr, uint16_t p) -> del_res {
       CAF_LOG_TRACE("");
@@ -194,14 +158,15 @@ auto middleman_actor_impl::make_behavior() -> behavior_type {
 
 middleman_actor_impl::put_res
 middleman_actor_impl::put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
-                          const char* in, bool reuse_addr) {
+                          const char* in, bool reuse_addr,
+                          const network::socket_options& opts) {
   CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(in)
-                              << CAF_ARG(reuse_addr));
+                              << CAF_ARG(reuse_addr) << CAF_ARG(opts));
   uint16_t actual_port;
   // treat empty strings like nullptr
   if (in != nullptr && in[0] == '\0')
     in = nullptr;
-  auto res = open(port, in, reuse_addr);
+  auto res = open(port, in, reuse_addr, opts);
   if (!res)
     return std::move(res.error());
   auto& ptr = *res;
@@ -211,6 +176,62 @@ middleman_actor_impl::put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
   return actual_port;
 }
 
+middleman_actor_impl::get_res
+middleman_actor_impl::get_endpoint(std::string& hostname, uint16_t port,
+                                   const network::socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(hostname) << CAF_ARG(port) << CAF_ARG(opts));
+  auto rp = make_response_promise();
+  endpoint key{std::move(hostname), port};
+  // respond immediately if endpoint is cached
+  auto x = cached_tcp(key);
+  if (x) {
+    CAF_LOG_DEBUG("found cached entry" << CAF_ARG(*x));
+    rp.deliver(get<0>(*x), get<1>(*x), get<2>(*x));
+    return get_delegated{};
+  }
+  // attach this promise to a pending request if possible
+  auto rps = pending(key);
+  if (rps) {
+    CAF_LOG_DEBUG("attach to pending request");
+    rps->emplace_back(std::move(rp));
+    return get_delegated{};
+  }
+  // connect to endpoint and initiate handhsake etc.
+  auto r = connect(key.first, port, opts);
+  if (!r) {
+    rp.deliver(std::move(r.error()));
+    return get_delegated{};
+  }
+  auto& ptr = *r;
+  std::vector<response_promise> tmp{std::move(rp)};
+  pending_.emplace(key, std::move(tmp));
+  request(broker_, infinite, connect_atom_v, std::move(ptr), port)
+    .then(
+      [=](node_id& nid, strong_actor_ptr& addr, mpi_set& sigs) {
+        auto i = pending_.find(key);
+        if (i == pending_.end())
+          return;
+        if (nid && addr) {
+          monitor(addr);
+          cached_tcp_.emplace(key, std::make_tuple(nid, addr, sigs));
+        }
+        auto res
+          = make_message(std::move(nid), std::move(addr), std::move(sigs));
+        for (auto& promise : i->second)
+          promise.deliver(res);
+        pending_.erase(i);
+      },
+      [=](error& err) {
+        auto i = pending_.find(key);
+        if (i == pending_.end())
+          return;
+        for (auto& promise : i->second)
+          promise.deliver(err);
+        pending_.erase(i);
+      });
+  return get_delegated{};
+}
+
 middleman_actor_impl::put_res
 middleman_actor_impl::put_udp(uint16_t port, strong_actor_ptr& whom,
                               mpi_set& sigs, const char* in, bool reuse_addr) {
@@ -254,9 +275,15 @@ middleman_actor_impl::pending(const endpoint& ep) {
   return none;
 }
 
+expected<scribe_ptr>
+middleman_actor_impl::connect(const std::string& host, uint16_t port,
+                              const network::socket_options& opts) {
+  return system().middleman().backend().new_tcp_scribe(host, port, opts);
+}
+
 expected<scribe_ptr>
 middleman_actor_impl::connect(const std::string& host, uint16_t port) {
-  return system().middleman().backend().new_tcp_scribe(host, port);
+  return connect(host, port, socket_options_);
 }
 
 expected<datagram_servant_ptr>
@@ -264,9 +291,16 @@ middleman_actor_impl::contact(const std::string& host, uint16_t port) {
   return system().middleman().backend().new_remote_udp_endpoint(host, port);
 }
 
+expected<doorman_ptr>
+middleman_actor_impl::open(uint16_t port, const char* addr, bool reuse,
+                           const network::socket_options& opts) {
+  return system().middleman().backend().new_tcp_doorman(port, addr, reuse,
+                                                        opts);
+}
+
 expected<doorman_ptr>
 middleman_actor_impl::open(uint16_t port, const char* addr, bool reuse) {
-  return system().middleman().backend().new_tcp_doorman(port, addr, reuse);
+  return open(port, addr, reuse, socket_options_);
 }
 
 expected<datagram_servant_ptr>
@@ -29,7 +29,8 @@
 
 namespace {
 
-constexpr size_t receive_buffer_size = std::numeric_limits<uint16_t>::max();
+constexpr size_t max_receive_buffer_size
+  = std::numeric_limits<uint16_t>::max();
 
 } // namespace
 
@@ -41,8 +42,8 @@ datagram_handler::datagram_handler(default_multiplexer& backend_ref,
     max_consecutive_reads_(get_or(backend().system().config(),
                                   "caf.middleman.max-consecutive-reads",
                                   defaults::middleman::max_consecutive_reads)),
-    max_datagram_size_(receive_buffer_size),
-    rd_buf_(receive_buffer_size),
+    max_datagram_size_(max_receive_buffer_size),
+    rd_buf_(max_receive_buffer_size),
     send_buffer_size_(0) {
   allow_udp_connreset(sockfd, false);
   auto es = send_buffer_size(sockfd);
@@ -18,6 +18,7 @@
 
 #include "caf/io/network/default_multiplexer.hpp"
 
+#include <chrono>
 #include <utility>
 
 #include "caf/actor_system_config.hpp"
@@ -591,6 +592,9 @@ void default_multiplexer::init() {
   namespace sr = defaults::scheduler;
   max_throughput_ = get_or(system().config(), "caf.scheduler.max-throughput",
                            sr::max_throughput);
+  socket_options_ = make_socket_options(system().config());
+  spin_duration_ = get_or(system().config(), "caf.middleman.spin-duration",
+                          defaults::middleman::spin_duration);
 }
 
 bool default_multiplexer::poll_once(bool block) {
@@ -611,6 +615,15 @@ bool default_multiplexer::poll_once(bool block) {
     poll_once_impl(false);
     return true;
   }
+  if (block && spin_duration_.count() > 0) {
+    // Busy-poll for a while before falling back to a blocking wait in order to
+    // avoid the wakeup latency of the kernel when traffic is dense.
+    auto deadline = std::chrono::steady_clock::now() + spin_duration_;
+    do {
+      if (poll_once_impl(false))
+        return true;
+    } while (std::chrono::steady_clock::now() < deadline);
+  }
   return poll_once_impl(block);
 }
 
@@ -666,17 +679,32 @@ void default_multiplexer::exec_later(resumable* ptr) {
 }
 
 scribe_ptr default_multiplexer::new_scribe(native_socket fd) {
-  CAF_LOG_TRACE("");
-  keepalive(fd, true);
-  return make_counted<scribe_impl>(*this, fd);
+  return new_scribe(fd, socket_options_);
+}
+
+scribe_ptr default_multiplexer::new_scribe(native_socket fd,
+                                           const socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(opts));
+  auto ptr = make_counted<scribe_impl>(*this, fd);
+  // The event handler sets its own defaults, so we need to override them
+  // after constructing the scribe.
+  if (auto err = apply(fd, opts))
+    CAF_LOG_WARNING("unable to apply socket options:" << err);
+  return ptr;
 }
 
 expected<scribe_ptr>
 default_multiplexer::new_tcp_scribe(const std::string& host, uint16_t port) {
-  auto fd = new_tcp_connection(host, port);
+  return new_tcp_scribe(host, port, socket_options_);
+}
+
+expected<scribe_ptr>
+default_multiplexer::new_tcp_scribe(const std::string& host, uint16_t port,
+                                    const socket_options& opts) {
+  auto fd = new_tcp_connection(host, port, opts);
   if (!fd)
     return std::move(fd.error());
-  return new_scribe(*fd);
+  return new_scribe(*fd, opts);
 }
 
 doorman_ptr default_multiplexer::new_doorman(native_socket fd) {
@@ -688,9 +716,16 @@ doorman_ptr default_multiplexer::new_doorman(native_socket fd) {
 expected<doorman_ptr>
 default_multiplexer::new_tcp_doorman(uint16_t port, const char* in,
                                      bool reuse_addr) {
-  auto fd = new_tcp_acceptor_impl(port, in, reuse_addr);
+  return new_tcp_doorman(port, in, reuse_addr, socket_options_);
+}
+
+expected<doorman_ptr>
+default_multiplexer::new_tcp_doorman(uint16_t port, const char* in,
+                                     bool reuse_addr,
+                                     const socket_options& opts) {
+  auto fd = new_tcp_acceptor_impl(port, in, reuse_addr, opts);
   if (fd)
-    return new_doorman(*fd);
+    return make_counted<doorman_impl>(*this, *fd, opts);
   return std::move(fd.error());
 }
 
@@ -757,9 +792,26 @@ bool ip_connect(native_socket fd, const std::string& host, uint16_t port) {
   return connect(fd, reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)) == 0;
 }
 
+expected<void> set_buffer_sizes(native_socket fd, const socket_options& opts) {
+  if (opts.send_buffer_size > 0)
+    if (auto res = send_buffer_size(fd, opts.send_buffer_size); !res)
+      return res;
+  if (opts.receive_buffer_size > 0)
+    if (auto res = receive_buffer_size(fd, opts.receive_buffer_size); !res)
+      return res;
+  return unit;
+}
+
 expected<native_socket>
 new_tcp_connection(const std::string& host, uint16_t port,
                    optional<protocol::network> preferred) {
+  return new_tcp_connection(host, port, socket_options{}, std::move(preferred));
+}
+
+expected<native_socket>
+new_tcp_connection(const std::string& host, uint16_t port,
+                   const socket_options& opts,
+                   optional<protocol::network> preferred) {
   CAF_LOG_TRACE(CAF_ARG(host) << CAF_ARG(port) << CAF_ARG(preferred));
   CAF_LOG_DEBUG("try to connect to:" << CAF_ARG(host) << CAF_ARG(port));
   auto res = interfaces::native_address(host, std::move(preferred));
@@ -777,6 +829,8 @@ new_tcp_connection(const std::string& host, uint16_t port,
             socket(proto == ipv4 ? AF_INET : AF_INET6, socktype, 0));
   child_process_inherit(fd, false);
   detail::socket_guard sguard(fd);
+  if (auto sb_res = set_buffer_sizes(fd, opts); !sb_res)
+    return std::move(sb_res.error());
   if (proto == ipv6) {
     if (ip_connect<AF_INET6>(fd, res->first, port)) {
       CAF_LOG_INFO("successfully connected to (IPv6):" << CAF_ARG(host)
@@ -785,7 +839,7 @@ new_tcp_connection(const std::string& host, uint16_t port,
     }
     sguard.close();
     // IPv4 fallback
-    return new_tcp_connection(host, port, ipv4);
+    return new_tcp_connection(host, port, opts, ipv4);
   }
   if (!ip_connect<AF_INET>(fd, res->first, port)) {
     CAF_LOG_WARNING("could not connect to:" << CAF_ARG(host) << CAF_ARG(port));
@@ -860,6 +914,12 @@ expected<native_socket> new_ip_acceptor_impl(uint16_t port, const char* addr,
 
 expected<native_socket>
 new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr) {
+  return new_tcp_acceptor_impl(port, addr, reuse_addr, socket_options{});
+}
+
+expected<native_socket>
+new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr,
+                      const socket_options& opts) {
   CAF_LOG_TRACE(CAF_ARG(port) << ", addr = " << (addr ? addr : "nullptr"));
   auto addrs = interfaces::server_address(port, addr);
   auto addr_str = std::string{addr == nullptr ? "" : addr};
@@ -888,6 +948,8 @@ new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr) {
                       addr_str);
   }
   detail::socket_guard sguard{fd};
+  if (auto sb_res = set_buffer_sizes(fd, opts); !sb_res)
+    return std::move(sb_res.error());
   CALL_CFUN(tmp2, detail::cc_zero, "listen", listen(fd, SOMAXCONN));
   // ok, no errors so far
   CAF_LOG_DEBUG(CAF_ARG(fd));
@@ -27,7 +27,15 @@
 namespace caf::io::network {
 
 doorman_impl::doorman_impl(default_multiplexer& mx, native_socket sockfd)
-  : doorman(network::accept_hdl_from_socket(sockfd)), acceptor_(mx, sockfd) {
+  : doorman_impl(mx, sockfd, mx.default_socket_options()) {
+  // nop
+}
+
+doorman_impl::doorman_impl(default_multiplexer& mx, native_socket sockfd,
+                           socket_options opts)
+  : doorman(network::accept_hdl_from_socket(sockfd)),
+    acceptor_(mx, sockfd),
+    opts_(std::move(opts)) {
   // nop
 }
 
@@ -40,7 +48,7 @@ bool doorman_impl::new_connection() {
     // further activities for the broker
     return false;
   auto& dm = acceptor_.backend();
-  auto sptr = dm.new_scribe(acceptor_.accepted_socket());
+  auto sptr = dm.new_scribe(acceptor_.accepted_socket(), opts_);
   auto hdl = sptr->hdl();
   parent()->add_scribe(std::move(sptr));
   return doorman::new_connection(&dm, hdl);
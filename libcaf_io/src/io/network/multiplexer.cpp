@@ -31,6 +31,18 @@ multiplexer_ptr multiplexer::make(actor_system& sys) {
   return multiplexer_ptr{new default_multiplexer(&sys)};
 }
 
+expected<scribe_ptr>
+multiplexer::new_tcp_scribe(const std::string& host, uint16_t port,
+                            const socket_options&) {
+  return new_tcp_scribe(host, port);
+}
+
+expected<doorman_ptr>
+multiplexer::new_tcp_doorman(uint16_t port, const char* in, bool reuse_addr,
+                             const socket_options&) {
+  return new_tcp_doorman(port, in, reuse_addr);
+}
+
 multiplexer_backend* multiplexer::pimpl() {
   return nullptr;
 }
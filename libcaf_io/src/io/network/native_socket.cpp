@@ -370,6 +370,66 @@ expected<void> send_buffer_size(native_socket fd, int new_value) {
   return unit;
 }
 
+expected<int> receive_buffer_size(native_socket fd) {
+  int size;
+  socket_size_type ret_size = sizeof(size);
+  CALL_CFUN(res, detail::cc_zero, "getsockopt",
+            getsockopt(fd, SOL_SOCKET, SO_RCVBUF,
+                       reinterpret_cast<getsockopt_ptr>(&size), &ret_size));
+  return size;
+}
+
+expected<void> receive_buffer_size(native_socket fd, int new_value) {
+  CALL_CFUN(res, detail::cc_zero, "setsockopt",
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF,
+                       reinterpret_cast<setsockopt_ptr>(&new_value),
+                       static_cast<socket_size_type>(sizeof(int))));
+  return unit;
+}
+
+expected<void> busy_poll(native_socket fd, int new_value) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(new_value));
+#ifdef SO_BUSY_POLL
+  CALL_CFUN(res, detail::cc_zero, "setsockopt",
+            setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+                       reinterpret_cast<setsockopt_ptr>(&new_value),
+                       static_cast<socket_size_type>(sizeof(int))));
+#else
+  static_cast<void>(fd);
+  static_cast<void>(new_value);
+#endif
+  return unit;
+}
+
+expected<void> tcp_quickack(native_socket fd, bool new_value) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(new_value));
+#ifdef TCP_QUICKACK
+  int flag = new_value ? 1 : 0;
+  CALL_CFUN(res, detail::cc_zero, "setsockopt",
+            setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK,
+                       reinterpret_cast<setsockopt_ptr>(&flag),
+                       static_cast<socket_size_type>(sizeof(flag))));
+#else
+  static_cast<void>(fd);
+  static_cast<void>(new_value);
+#endif
+  return unit;
+}
+
+expected<void> tcp_notsent_lowat(native_socket fd, int new_value) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(new_value));
+#ifdef TCP_NOTSENT_LOWAT
+  CALL_CFUN(res, detail::cc_zero, "setsockopt",
+            setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT,
+                       reinterpret_cast<setsockopt_ptr>(&new_value),
+                       static_cast<socket_size_type>(sizeof(int))));
+#else
+  static_cast<void>(fd);
+  static_cast<void>(new_value);
+#endif
+  return unit;
+}
+
 expected<void> tcp_nodelay(native_socket fd, bool new_value) {
   CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(new_value));
   int flag = new_value ? 1 : 0;
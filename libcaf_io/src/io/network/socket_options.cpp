@@ -0,0 +1,78 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/network/socket_options.hpp"
+
+#include <chrono>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/logger.hpp"
+
+namespace caf::io::network {
+
+socket_options make_socket_options(const actor_system_config& cfg) {
+  socket_options result;
+  auto get = [&cfg](string_view name, auto fallback) {
+    std::string key = "caf.middleman.socket.";
+    key.insert(key.end(), name.begin(), name.end());
+    return get_or(cfg, key, fallback);
+  };
+  result.tcp_nodelay = get("tcp-nodelay", result.tcp_nodelay);
+  result.keepalive = get("keepalive", result.keepalive);
+  result.tcp_quickack = get("tcp-quickack", result.tcp_quickack);
+  result.send_buffer_size = get("send-buffer-size", result.send_buffer_size);
+  result.receive_buffer_size = get("receive-buffer-size",
+                                   result.receive_buffer_size);
+  result.tcp_notsent_lowat = get("tcp-notsent-lowat", result.tcp_notsent_lowat);
+  result.busy_poll = get("busy-poll", result.busy_poll);
+  return result;
+}
+
+error apply(native_socket fd, const socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(opts));
+  error result;
+  // Keeps the first error, but tries to apply all remaining options anyway.
+  auto check = [&result](const char* name, expected<void> res) {
+    if (!res) {
+      CAF_LOG_WARNING("failed to set socket option:" << CAF_ARG(name)
+                                                     << CAF_ARG2("error",
+                                                                 res.error()));
+      if (!result)
+        result = std::move(res.error());
+    }
+  };
+  check("tcp-nodelay", tcp_nodelay(fd, opts.tcp_nodelay));
+  check("keepalive", keepalive(fd, opts.keepalive));
+  if (opts.tcp_quickack)
+    check("tcp-quickack", tcp_quickack(fd, true));
+  if (opts.send_buffer_size > 0)
+    check("send-buffer-size", send_buffer_size(fd, opts.send_buffer_size));
+  if (opts.receive_buffer_size > 0)
+    check("receive-buffer-size",
+          receive_buffer_size(fd, opts.receive_buffer_size));
+  if (opts.tcp_notsent_lowat > 0)
+    check("tcp-notsent-lowat", tcp_notsent_lowat(fd, opts.tcp_notsent_lowat));
+  if (opts.busy_poll.count() > 0) {
+    namespace sc = std::chrono;
+    auto usec = sc::duration_cast<sc::microseconds>(opts.busy_poll).count();
+    check("busy-poll", busy_poll(fd, static_cast<int>(usec)));
+  }
+  return result;
+}
+
+} // namespace caf::io::network
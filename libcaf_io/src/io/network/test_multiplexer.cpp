@@ -28,7 +28,8 @@ namespace caf::io::network {
 
 namespace {
 
-constexpr size_t receive_buffer_size = std::numeric_limits<uint16_t>::max();
+constexpr size_t max_receive_buffer_size
+  = std::numeric_limits<uint16_t>::max();
 
 } // namespace
 
@@ -55,13 +56,13 @@ test_multiplexer::datagram_data::datagram_data(shared_job_queue_type input,
     wr_buf_ptr(std::move(output)),
     vn_buf(*vn_buf_ptr),
     wr_buf(*wr_buf_ptr),
-    rd_buf(datagram_handle::from_int(0), receive_buffer_size),
+    rd_buf(datagram_handle::from_int(0), max_receive_buffer_size),
     stopped_reading(false),
     passive_mode(false),
     ack_writes(false),
     port(0),
     local_port(0),
-    datagram_size(receive_buffer_size) {
+    datagram_size(max_receive_buffer_size) {
   // nop
 }
 
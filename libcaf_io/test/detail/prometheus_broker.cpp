@@ -48,6 +48,15 @@ struct fixture : test_node_fixture<> {
     run();
   }
 
+  string_view get(string_view request) {
+    auto bytes = as_bytes(make_span(request));
+    mpx.virtual_send(connection, byte_buffer{bytes.begin(), bytes.end()});
+    run();
+    auto& response_buf = mpx.output_buffer(connection);
+    return {reinterpret_cast<char*>(response_buf.data()),
+            response_buf.size()};
+  }
+
   accept_handle acceptor = accept_handle::from_int(1);
   connection_handle connection = connection_handle::from_int(1);
 };
@@ -61,22 +70,12 @@ bool contains(string_view str, string_view what) {
 CAF_TEST_FIXTURE_SCOPE(prometheus_broker_tests, fixture)
 
 CAF_TEST(the prometheus broker responds to HTTP get requests) {
-  string_view request
-    = "GET /metrics HTTP/1.1\r\n"
-      "Host: localhost:8090\r\n"
-      "User-Agent: Prometheus/2.18.1\r\n"
-      "Accept: application/openmetrics-text; "
-      "version=0.0.1,text/plain;version=0.0.4;q=0.5,*/*;q=0.1\r\n"
-      "Accept-Encoding: gzip\r\n"
-      "X-Prometheus-Scrape-Timeout-Seconds: 5.000000\r\n\r\n";
-  auto bytes = as_bytes(make_span(request));
-  mpx.virtual_send(connection, byte_buffer{bytes.begin(), bytes.end()});
-  run();
-  auto& response_buf = mpx.output_buffer(connection);
-  string_view response{reinterpret_cast<char*>(response_buf.data()),
-                       response_buf.size()};
+  auto response = get("GET /metrics HTTP/1.1\r\n"
+                      "Host: localhost:8090\r\n"
+                      "User-Agent: Prometheus/2.18.1\r\n"
+                      "Accept: text/plain;version=0.0.4\r\n\r\n");
   string_view ok_header = "HTTP/1.1 200 OK\r\n"
-                          "Content-Type: text/plain\r\n"
+                          "Content-Type: text/plain; version=0.0.4\r\n"
                           "Connection: Closed\r\n\r\n";
   CAF_CHECK(starts_with(response, ok_header));
   CAF_CHECK(contains(response, "\ncaf_system_running_actors 2 "));
@@ -87,4 +86,49 @@ CAF_TEST(the prometheus broker responds to HTTP get requests) {
   }
 }
 
+CAF_TEST(the prometheus broker generates OpenMetrics on request) {
+  auto response = get("GET /metrics HTTP/1.1\r\n"
+                      "Host: localhost:8090\r\n"
+                      "accept: application/openmetrics-text; version=0.0.1,"
+                      "text/plain;version=0.0.4;q=0.5,*/*;q=0.1\r\n"
+                      "accept-encoding: gzip;q=0\r\n\r\n");
+  string_view ok_header = "HTTP/1.1 200 OK\r\n"
+                          "Content-Type: application/openmetrics-text; "
+                          "version=1.0.0; charset=utf-8\r\n"
+                          "Connection: Closed\r\n\r\n";
+  CAF_CHECK(starts_with(response, ok_header));
+  CAF_CHECK(contains(response, "\ncaf_system_running_actors 2 "));
+  CAF_CHECK(ends_with(response, "\n# EOF\n"));
+}
+
+CAF_TEST(the prometheus broker compresses its output if possible) {
+  string_view request
+    = "GET /metrics HTTP/1.1\r\n"
+      "Host: localhost:8090\r\n"
+      "User-Agent: Prometheus/2.18.1\r\n"
+      "Accept: application/openmetrics-text; "
+      "version=0.0.1,text/plain;version=0.0.4;q=0.5,*/*;q=0.1\r\n"
+      "Accept-Encoding: gzip\r\n"
+      "X-Prometheus-Scrape-Timeout-Seconds: 5.000000\r\n\r\n";
+  auto response = get(request);
+  string_view content_type = "HTTP/1.1 200 OK\r\n"
+                             "Content-Type: application/openmetrics-text; "
+                             "version=1.0.0; charset=utf-8\r\n";
+  CAF_REQUIRE(starts_with(response, content_type));
+  response.remove_prefix(content_type.size());
+  if (detail::prometheus_broker::has_gzip()) {
+    string_view ok_header = "Content-Encoding: gzip\r\n"
+                            "Connection: Closed\r\n\r\n";
+    CAF_REQUIRE(starts_with(response, ok_header));
+    response.remove_prefix(ok_header.size());
+    // Check for the magic bytes of the gzip format.
+    CAF_REQUIRE_GREATER(response.size(), 2u);
+    CAF_CHECK_EQUAL(static_cast<uint8_t>(response[0]), 0x1Fu);
+    CAF_CHECK_EQUAL(static_cast<uint8_t>(response[1]), 0x8Bu);
+  } else {
+    CAF_CHECK(starts_with(response, "Connection: Closed\r\n\r\n"));
+    CAF_CHECK(contains(response, "\ncaf_system_running_actors 2 "));
+  }
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,149 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE io.network.socket_options
+
+#include "caf/io/network/socket_options.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/socket_guard.hpp"
+#include "caf/io/middleman.hpp"
+#include "caf/io/network/default_multiplexer.hpp"
+
+#ifndef CAF_WINDOWS
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <sys/socket.h>
+#endif
+
+using namespace caf;
+using namespace caf::io::network;
+
+namespace {
+
+struct config : actor_system_config {
+  config() {
+    load<io::middleman>();
+  }
+};
+
+struct fixture : test_coordinator_fixture<> {
+  // Makes sure WSAStartup gets called on Windows.
+  default_multiplexer mpx;
+
+  fixture() : mpx(&sys) {
+    // nop
+  }
+
+  // Reads an integer socket option via getsockopt.
+  static int get_option(native_socket fd, int level, int name) {
+#ifndef CAF_WINDOWS
+    int value = -1;
+    socklen_t len = sizeof(value);
+    if (getsockopt(fd, level, name, &value, &len) != 0)
+      CAF_FAIL("getsockopt failed: " << last_socket_error_as_string());
+    return value;
+#else
+    static_cast<void>(fd);
+    static_cast<void>(level);
+    static_cast<void>(name);
+    return -1;
+#endif
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(socket_options_tests, fixture)
+
+CAF_TEST(an empty config results in default socket options) {
+  config cfg;
+  auto opts = make_socket_options(cfg);
+  CAF_CHECK_EQUAL(opts.tcp_nodelay, true);
+  CAF_CHECK_EQUAL(opts.keepalive, true);
+  CAF_CHECK_EQUAL(opts.tcp_quickack, false);
+  CAF_CHECK_EQUAL(opts.send_buffer_size, 0);
+  CAF_CHECK_EQUAL(opts.receive_buffer_size, 0);
+  CAF_CHECK_EQUAL(opts.tcp_notsent_lowat, 0);
+  CAF_CHECK_EQUAL(opts.busy_poll, timespan{0});
+}
+
+CAF_TEST(socket options override defaults via caf.middleman.socket) {
+  config cfg;
+  cfg.set("caf.middleman.socket.tcp-nodelay", false);
+  cfg.set("caf.middleman.socket.send-buffer-size", 1024 * 1024);
+  cfg.set("caf.middleman.socket.receive-buffer-size", 2 * 1024 * 1024);
+  cfg.set("caf.middleman.socket.tcp-notsent-lowat", 16 * 1024);
+  cfg.set("caf.middleman.socket.busy-poll", timespan{50'000});
+  auto opts = make_socket_options(cfg);
+  CAF_CHECK_EQUAL(opts.tcp_nodelay, false);
+  CAF_CHECK_EQUAL(opts.keepalive, true);
+  CAF_CHECK_EQUAL(opts.send_buffer_size, 1024 * 1024);
+  CAF_CHECK_EQUAL(opts.receive_buffer_size, 2 * 1024 * 1024);
+  CAF_CHECK_EQUAL(opts.tcp_notsent_lowat, 16 * 1024);
+  CAF_CHECK_EQUAL(opts.busy_poll, timespan{50'000});
+}
+
+CAF_TEST(acceptors set buffer sizes before listening) {
+  socket_options opts;
+  opts.send_buffer_size = 128 * 1024;
+  opts.receive_buffer_size = 256 * 1024;
+  auto fd = unbox(new_tcp_acceptor_impl(0, "127.0.0.1", false, opts));
+  detail::socket_guard guard{fd};
+  // The OS may round up (Linux doubles the value for bookkeeping overhead).
+  CAF_CHECK_GREATER_OR_EQUAL(unbox(send_buffer_size(fd)), 128 * 1024);
+  CAF_CHECK_GREATER_OR_EQUAL(unbox(receive_buffer_size(fd)), 256 * 1024);
+}
+
+CAF_TEST(apply sets all options on a socket) {
+  socket_options opts;
+  opts.tcp_nodelay = false;
+  opts.keepalive = false;
+  opts.tcp_quickack = true;
+  opts.send_buffer_size = 64 * 1024;
+  opts.receive_buffer_size = 64 * 1024;
+  opts.tcp_notsent_lowat = 16 * 1024;
+  opts.busy_poll = timespan{50'000};
+  auto fd = unbox(new_tcp_acceptor_impl(0, "127.0.0.1", false));
+  detail::socket_guard guard{fd};
+  CAF_CHECK_EQUAL(apply(fd, opts), error{});
+  CAF_CHECK_GREATER_OR_EQUAL(unbox(send_buffer_size(fd)), 64 * 1024);
+  CAF_CHECK_GREATER_OR_EQUAL(unbox(receive_buffer_size(fd)), 64 * 1024);
+#ifndef CAF_WINDOWS
+  CAF_CHECK_EQUAL(get_option(fd, IPPROTO_TCP, TCP_NODELAY), 0);
+  CAF_CHECK_EQUAL(get_option(fd, SOL_SOCKET, SO_KEEPALIVE), 0);
+#endif
+#ifdef TCP_QUICKACK
+  CAF_CHECK_NOT_EQUAL(get_option(fd, IPPROTO_TCP, TCP_QUICKACK), 0);
+#endif
+#ifdef TCP_NOTSENT_LOWAT
+  CAF_CHECK_EQUAL(get_option(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT), 16 * 1024);
+#endif
+#ifdef SO_BUSY_POLL
+  CAF_CHECK_EQUAL(get_option(fd, SOL_SOCKET, SO_BUSY_POLL), 50);
+#endif
+}
+
+CAF_TEST(apply reports the first error) {
+  socket_options opts;
+  CAF_CHECK_NOT_EQUAL(apply(invalid_native_socket, opts), error{});
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
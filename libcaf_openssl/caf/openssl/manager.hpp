@@ -18,9 +18,17 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <set>
 #include <string>
 
+#include "caf/config.hpp"
+
+CAF_PUSH_WARNINGS
+#include <openssl/ssl.h>
+CAF_POP_WARNINGS
+
 #include "caf/actor_system.hpp"
 #include "caf/detail/openssl_export.hpp"
 #include "caf/io/middleman_actor.hpp"
@@ -62,6 +70,27 @@ public:
   /// of peers.
   bool authentication_enabled();
 
+  /// Returns the SSL context shared by all sessions of this manager.
+  SSL_CTX* ssl_context() const noexcept {
+    return ctx_;
+  }
+
+  /// Returns the passphrase for decrypting the private key.
+  const char* openssl_passphrase() const noexcept {
+    return openssl_passphrase_.c_str();
+  }
+
+  /// Configures `ssl` for resuming the most recent session with `peer`.
+  /// Does nothing if no session with `peer` is cached.
+  void restore_session(SSL* ssl, const std::string& peer);
+
+  /// Caches `sess` for resuming the next connection to `peer`. Takes ownership
+  /// of `sess`.
+  void store_session(const std::string& peer, SSL_SESSION* sess);
+
+  /// Drops the cached session for `peer` after a connection failed.
+  void forget_session(const std::string& peer);
+
   /// Adds module-specific options to the config before loading the module.
   static void add_module_options(actor_system_config& cfg);
 
@@ -79,11 +108,27 @@ private:
   /// Private since instantiation is only allowed via `make`.
   manager(actor_system& sys);
 
+  /// Creates the SSL context according to the system configuration.
+  SSL_CTX* create_ssl_context();
+
   /// Reference to the parent.
   actor_system& system_;
 
   /// OpenSSL-aware connection manager.
   io::middleman_actor manager_;
+
+  /// Shared context for all sessions. Keeping a single context allows OpenSSL
+  /// to cache sessions and to issue session tickets across connections.
+  SSL_CTX* ctx_;
+
+  /// Passphrase for decrypting the private key.
+  std::string openssl_passphrase_;
+
+  /// Guards `sessions_`.
+  std::mutex sessions_mtx_;
+
+  /// Stores the most recent client-side session per peer (`host:port`).
+  std::map<std::string, SSL_SESSION*> sessions_;
 };
 
 } // namespace caf::openssl
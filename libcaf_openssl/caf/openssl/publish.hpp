@@ -27,6 +27,7 @@
 #include "caf/detail/openssl_export.hpp"
 #include "caf/error.hpp"
 #include "caf/fwd.hpp"
+#include "caf/io/network/socket_options.hpp"
 #include "caf/sec.hpp"
 #include "caf/typed_actor.hpp"
 
@@ -37,6 +38,12 @@ CAF_OPENSSL_EXPORT expected<uint16_t>
 publish(actor_system& sys, const strong_actor_ptr& whom,
         std::set<std::string>&& sigs, uint16_t port, const char* cstr, bool ru);
 
+/// @private
+CAF_OPENSSL_EXPORT expected<uint16_t>
+publish(actor_system& sys, const strong_actor_ptr& whom,
+        std::set<std::string>&& sigs, uint16_t port, const char* cstr, bool ru,
+        const io::network::socket_options& opts);
+
 /// Tries to publish `whom` at `port` and returns either an `error` or the
 /// bound port.
 /// @param whom Actor that should be published at `port`.
@@ -55,4 +62,24 @@ expected<uint16_t> publish(const Handle& whom, uint16_t port,
                  sys.message_types(whom), port, in, reuse);
 }
 
+/// Tries to publish `whom` at `port` and returns either an `error` or the
+/// bound port. Applies `opts` to all accepted connections.
+/// @param whom Actor that should be published at `port`.
+/// @param port Unused TCP port.
+/// @param in The IP address to listen to or `INADDR_ANY` if `in == nullptr`.
+/// @param reuse Create socket using `SO_REUSEADDR`.
+/// @param opts Tuning parameters for the TCP sockets.
+/// @returns The actual port the OS uses after `bind()`. If `port == 0`
+///          the OS chooses a random high-level port.
+template <class Handle>
+expected<uint16_t> publish(const Handle& whom, uint16_t port, const char* in,
+                           bool reuse,
+                           const io::network::socket_options& opts) {
+  if (!whom)
+    return sec::cannot_publish_invalid_actor;
+  auto& sys = whom.home_system();
+  return publish(sys, actor_cast<strong_actor_ptr>(whom),
+                 sys.message_types(whom), port, in, reuse, opts);
+}
+
 } // namespace caf::openssl
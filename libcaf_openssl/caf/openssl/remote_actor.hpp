@@ -26,6 +26,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/detail/openssl_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/io/network/socket_options.hpp"
 
 namespace caf::openssl {
 
@@ -34,6 +35,12 @@ CAF_OPENSSL_EXPORT expected<strong_actor_ptr>
 remote_actor(actor_system& sys, const std::set<std::string>& mpi,
              std::string host, uint16_t port);
 
+/// @private
+CAF_OPENSSL_EXPORT expected<strong_actor_ptr>
+remote_actor(actor_system& sys, const std::set<std::string>& mpi,
+             std::string host, uint16_t port,
+             const io::network::socket_options& opts);
+
 /// Establish a new connection to the actor at `host` on given `port`.
 /// @param host Valid hostname or IP address.
 /// @param port TCP port.
@@ -49,4 +56,23 @@ remote_actor(actor_system& sys, std::string host, uint16_t port) {
   return std::move(res.error());
 }
 
+/// Establish a new connection to the actor at `host` on given `port`, applying
+/// `opts` to the socket.
+/// @param host Valid hostname or IP address.
+/// @param port TCP port.
+/// @param opts Tuning parameters for the TCP socket.
+/// @returns An `actor` to the proxy instance representing
+///          a remote actor or an `error`.
+template <class ActorHandle = actor>
+expected<ActorHandle>
+remote_actor(actor_system& sys, std::string host, uint16_t port,
+             const io::network::socket_options& opts) {
+  detail::type_list<ActorHandle> tk;
+  auto res = remote_actor(sys, sys.message_types(tk), std::move(host), port,
+                          opts);
+  if (res)
+    return actor_cast<ActorHandle>(std::move(*res));
+  return std::move(res.error());
+}
+
 } // namespace caf::openssl
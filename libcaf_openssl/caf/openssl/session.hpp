@@ -30,6 +30,7 @@ CAF_POP_WARNINGS
 #include "caf/detail/openssl_export.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/io/network/native_socket.hpp"
+#include "caf/openssl/manager.hpp"
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000L
 #  define CAF_SSL_HAS_SECURITY_LEVEL
@@ -40,6 +41,10 @@ CAF_POP_WARNINGS
 #  define CAF_SSL_HAS_ECDH_AUTO
 #endif
 
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#  define CAF_SSL_HAS_KTLS
+#endif
+
 namespace caf::openssl {
 
 using native_socket = io::network::native_socket;
@@ -60,21 +65,54 @@ public:
 
   bool must_read_more(native_socket, size_t threshold);
 
-  const char* openssl_passphrase();
+  /// Returns the OpenSSL manager that owns the shared SSL context.
+  manager& parent() noexcept {
+    return sys_.openssl_manager();
+  }
+
+  /// Returns the remote endpoint of a client-side session as `host:port` or
+  /// an empty string for server-side sessions.
+  const std::string& peer() const noexcept {
+    return peer_;
+  }
+
+  /// Returns the underlying OpenSSL handle.
+  SSL* native_handle() noexcept {
+    return ssl_;
+  }
+
+  /// Returns whether the handshake resumed a previous session.
+  bool session_reused() const noexcept {
+    return SSL_session_reused(ssl_) == 1;
+  }
+
+  /// Returns whether the kernel encrypts outgoing records (kTLS). OpenSSL then
+  /// passes plaintext records to the socket instead of encrypting them.
+  bool ktls_send() const noexcept {
+    return ktls_send_;
+  }
+
+  /// Returns whether the kernel decrypts incoming records (kTLS).
+  bool ktls_recv() const noexcept {
+    return ktls_recv_;
+  }
 
 private:
   rw_state do_some(int (*f)(SSL*, void*, int), size_t& result, void* buf,
                    size_t len, const char* debug_name);
-  SSL_CTX* create_ssl_context();
   std::string get_ssl_error();
   bool handle_ssl_result(int ret);
+  void handshake_completed();
+  void fail();
 
   actor_system& sys_;
-  SSL_CTX* ctx_;
   SSL* ssl_;
-  std::string openssl_passphrase_;
+  std::string peer_;
   bool connecting_;
   bool accepting_;
+  bool ktls_send_;
+  bool ktls_recv_;
+  bool failed_;
 };
 
 /// @relates session
@@ -23,6 +23,7 @@ CAF_PUSH_WARNINGS
 #include <openssl/ssl.h>
 CAF_POP_WARNINGS
 
+#include <cstring>
 #include <mutex>
 #include <vector>
 
@@ -30,6 +31,7 @@ CAF_POP_WARNINGS
 #include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/expected.hpp"
+#include "caf/logger.hpp"
 #include "caf/raise_error.hpp"
 #include "caf/scoped_actor.hpp"
 
@@ -38,6 +40,7 @@ CAF_POP_WARNINGS
 #include "caf/io/network/default_multiplexer.hpp"
 
 #include "caf/openssl/middleman_actor.hpp"
+#include "caf/openssl/session.hpp"
 
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
 struct CRYPTO_dynlock_value {
@@ -80,7 +83,36 @@ void dynlock_destroy(CRYPTO_dynlock_value* dynlock, const char*, int) {
 
 namespace caf::openssl {
 
+namespace {
+
+constexpr unsigned char session_id_context[] = "caf";
+
+int pem_passwd_cb(char* buf, int size, int, void* ptr) {
+  auto passphrase = reinterpret_cast<manager*>(ptr)->openssl_passphrase();
+  strncpy(buf, passphrase, static_cast<size_t>(size));
+  buf[size - 1] = '\0';
+  return static_cast<int>(strlen(buf));
+}
+
+// Called by OpenSSL whenever a handshake established a new session or when
+// receiving a session ticket after the handshake (TLS 1.3).
+int new_session_cb(SSL* ssl, SSL_SESSION* sess) {
+  if (SSL_is_server(ssl))
+    return 0;
+  auto ptr = reinterpret_cast<session*>(SSL_get_app_data(ssl));
+  if (ptr == nullptr || ptr->peer().empty())
+    return 0;
+  ptr->parent().store_session(ptr->peer(), sess);
+  return 1;
+}
+
+} // namespace
+
 manager::~manager() {
+  if (ctx_ != nullptr)
+    SSL_CTX_free(ctx_);
+  for (auto& kvp : sessions_)
+    SSL_SESSION_free(kvp.second);
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   std::lock_guard<std::mutex> lock{init_mutex};
   --init_count;
@@ -96,6 +128,7 @@ manager::~manager() {
 
 void manager::start() {
   CAF_LOG_TRACE("");
+  ctx_ = create_ssl_context();
   manager_ = make_middleman_actor(
     system(), system().middleman().named_broker<io::basp_broker>("BASP"));
 }
@@ -149,6 +182,115 @@ bool manager::authentication_enabled() {
          || !cfg.openssl_cafile.empty();
 }
 
+void manager::restore_session(SSL* ssl, const std::string& peer) {
+  std::lock_guard<std::mutex> guard{sessions_mtx_};
+  if (auto i = sessions_.find(peer); i != sessions_.end()) {
+    CAF_LOG_DEBUG("try to resume session with" << peer);
+    SSL_set_session(ssl, i->second);
+  }
+}
+
+void manager::store_session(const std::string& peer, SSL_SESSION* sess) {
+  std::lock_guard<std::mutex> guard{sessions_mtx_};
+  auto& entry = sessions_[peer];
+  if (entry != nullptr)
+    SSL_SESSION_free(entry);
+  entry = sess;
+}
+
+void manager::forget_session(const std::string& peer) {
+  std::lock_guard<std::mutex> guard{sessions_mtx_};
+  if (auto i = sessions_.find(peer); i != sessions_.end()) {
+    CAF_LOG_DEBUG("drop cached session with" << peer);
+    SSL_SESSION_free(i->second);
+    sessions_.erase(i);
+  }
+}
+
+SSL_CTX* manager::create_ssl_context() {
+#ifdef CAF_SSL_HAS_NON_VERSIONED_TLS_FUN
+  auto ctx = SSL_CTX_new(TLS_method());
+#else
+  auto ctx = SSL_CTX_new(TLSv1_2_method());
+#endif
+  if (!ctx)
+    CAF_RAISE_ERROR("cannot create OpenSSL context");
+  if (get_or(config(), "caf.openssl.ktls", false)) {
+#ifdef CAF_SSL_HAS_KTLS
+    SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+#else
+    CAF_LOG_WARNING("kTLS requested but not supported by OpenSSL");
+#endif
+  }
+  if (get_or(config(), "caf.openssl.session-resumption", true)) {
+    // Servers resume sessions via their internal cache or via stateless
+    // session tickets. Clients keep their sessions in `sessions_`.
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+    SSL_CTX_sess_set_new_cb(ctx, new_session_cb);
+    // Resuming a session with a verified peer requires a session ID context.
+    if (SSL_CTX_set_session_id_context(ctx, session_id_context,
+                                       sizeof(session_id_context))
+        != 1)
+      CAF_RAISE_ERROR("cannot set session ID context");
+  } else {
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+  }
+  if (authentication_enabled()) {
+    // Require valid certificates on both sides.
+    auto& cfg = config();
+    if (!cfg.openssl_certificate.empty()
+        && SSL_CTX_use_certificate_chain_file(ctx,
+                                              cfg.openssl_certificate.c_str())
+             != 1)
+      CAF_RAISE_ERROR("cannot load certificate");
+    if (!cfg.openssl_passphrase.empty()) {
+      openssl_passphrase_ = cfg.openssl_passphrase;
+      SSL_CTX_set_default_passwd_cb(ctx, pem_passwd_cb);
+      SSL_CTX_set_default_passwd_cb_userdata(ctx, this);
+    }
+    if (!cfg.openssl_key.empty()
+        && SSL_CTX_use_PrivateKey_file(ctx, cfg.openssl_key.c_str(),
+                                       SSL_FILETYPE_PEM)
+             != 1)
+      CAF_RAISE_ERROR("cannot load private key");
+    auto cafile = (!cfg.openssl_cafile.empty() ? cfg.openssl_cafile.c_str()
+                                               : nullptr);
+    auto capath = (!cfg.openssl_capath.empty() ? cfg.openssl_capath.c_str()
+                                               : nullptr);
+    if (cafile || capath) {
+      if (SSL_CTX_load_verify_locations(ctx, cafile, capath) != 1)
+        CAF_RAISE_ERROR("cannot load trusted CA certificates");
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                       nullptr);
+    if (SSL_CTX_set_cipher_list(ctx, "HIGH:!aNULL:!MD5") != 1)
+      CAF_RAISE_ERROR("cannot set cipher list");
+  } else {
+    // No authentication.
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+#if defined(CAF_SSL_HAS_ECDH_AUTO) && (OPENSSL_VERSION_NUMBER < 0x10100000L)
+    SSL_CTX_set_ecdh_auto(ctx, 1);
+#else
+    auto ecdh = EC_KEY_new_by_curve_name(NID_secp384r1);
+    if (!ecdh)
+      CAF_RAISE_ERROR("cannot get ECDH curve");
+    CAF_PUSH_WARNINGS
+    SSL_CTX_set_tmp_ecdh(ctx, ecdh);
+    EC_KEY_free(ecdh);
+    CAF_POP_WARNINGS
+#endif
+#ifdef CAF_SSL_HAS_SECURITY_LEVEL
+    const char* cipher = "AECDH-AES256-SHA@SECLEVEL=0";
+#else
+    const char* cipher = "AECDH-AES256-SHA";
+#endif
+    if (SSL_CTX_set_cipher_list(ctx, cipher) != 1)
+      CAF_RAISE_ERROR("cannot set anonymous cipher");
+  }
+  return ctx;
+}
+
 void manager::add_module_options(actor_system_config& cfg) {
   config_option_adder(cfg.custom_options(), "caf.openssl")
     .add<std::string>(cfg.openssl_certificate, "certificate",
@@ -162,7 +304,10 @@ void manager::add_module_options(actor_system_config& cfg) {
       "path to an OpenSSL-style directory of trusted certificates")
     .add<std::string>(
       cfg.openssl_cafile, "cafile",
-      "path to a file of concatenated PEM-formatted certificates");
+      "path to a file of concatenated PEM-formatted certificates")
+    .add<bool>("ktls", "offloads record encryption to the kernel (kTLS)")
+    .add<bool>("session-resumption",
+               "resumes previous sessions to skip full handshakes");
 }
 
 actor_system::module* manager::make(actor_system& sys, detail::type_list<>) {
@@ -178,7 +323,7 @@ void manager::init_global_meta_objects() {
   // nop
 }
 
-manager::manager(actor_system& sys) : system_(sys) {
+manager::manager(actor_system& sys) : system_(sys), ctx_(nullptr) {
   // nop
 }
 
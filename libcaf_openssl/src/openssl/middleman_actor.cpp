@@ -210,8 +210,9 @@ private:
 
 class doorman_impl : public io::network::doorman_impl {
 public:
-  doorman_impl(default_mpx& mx, native_socket sockfd)
-    : io::network::doorman_impl(mx, sockfd) {
+  doorman_impl(default_mpx& mx, native_socket sockfd,
+               io::network::socket_options opts)
+    : io::network::doorman_impl(mx, sockfd, std::move(opts)) {
     // nop
   }
 
@@ -234,6 +235,8 @@ public:
     }
     auto scrb = make_counted<scribe_impl>(dm, fd, std::move(sssn));
     sguard.release(); // The scribe claims ownership of the socket.
+    if (auto err = io::network::apply(fd, opts_))
+      CAF_LOG_WARNING("unable to apply socket options:" << err);
     auto hdl = scrb->hdl();
     parent()->add_scribe(std::move(scrb));
     return doorman::new_connection(&dm, hdl);
@@ -252,10 +255,15 @@ public:
   }
 
 protected:
+  using io::middleman_actor_impl::connect;
+
+  using io::middleman_actor_impl::open;
+
   expected<io::scribe_ptr>
-  connect(const std::string& host, uint16_t port) override {
-    CAF_LOG_TRACE(CAF_ARG(host) << CAF_ARG(port));
-    auto fd = io::network::new_tcp_connection(host, port);
+  connect(const std::string& host, uint16_t port,
+          const io::network::socket_options& opts) override {
+    CAF_LOG_TRACE(CAF_ARG(host) << CAF_ARG(port) << CAF_ARG(opts));
+    auto fd = io::network::new_tcp_connection(host, port, opts);
     if (!fd)
       return std::move(fd.error());
     io::network::nonblocking(*fd, true);
@@ -266,16 +274,20 @@ protected:
     }
     CAF_LOG_DEBUG("successfully created an SSL session for:" << CAF_ARG(host)
                                                              << CAF_ARG(port));
-    return make_counted<scribe_impl>(mpx(), *fd, std::move(sssn));
+    auto scrb = make_counted<scribe_impl>(mpx(), *fd, std::move(sssn));
+    if (auto err = io::network::apply(*fd, opts))
+      CAF_LOG_WARNING("unable to apply socket options:" << err);
+    return scrb;
   }
 
   expected<io::doorman_ptr>
-  open(uint16_t port, const char* addr, bool reuse) override {
-    CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(reuse));
-    auto fd = io::network::new_tcp_acceptor_impl(port, addr, reuse);
+  open(uint16_t port, const char* addr, bool reuse,
+       const io::network::socket_options& opts) override {
+    CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(reuse) << CAF_ARG(opts));
+    auto fd = io::network::new_tcp_acceptor_impl(port, addr, reuse, opts);
     if (!fd)
       return std::move(fd.error());
-    return make_counted<doorman_impl>(mpx(), *fd);
+    return make_counted<doorman_impl>(mpx(), *fd, opts);
   }
 
 private:
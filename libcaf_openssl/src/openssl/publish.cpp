@@ -31,14 +31,23 @@ namespace caf::openssl {
 expected<uint16_t> publish(actor_system& sys, const strong_actor_ptr& whom,
                            std::set<std::string>&& sigs, uint16_t port,
                            const char* cstr, bool ru) {
-  CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(port));
+  return publish(sys, whom, std::move(sigs), port, cstr, ru,
+                 io::network::make_socket_options(sys.config()));
+}
+
+expected<uint16_t> publish(actor_system& sys, const strong_actor_ptr& whom,
+                           std::set<std::string>&& sigs, uint16_t port,
+                           const char* cstr, bool ru,
+                           const io::network::socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(port)
+                              << CAF_ARG(opts));
   CAF_ASSERT(whom != nullptr);
   std::string in;
   if (cstr != nullptr)
     in = cstr;
   auto f = make_function_view(sys.openssl_manager().actor_handle());
   return f(publish_atom_v, port, std::move(whom), std::move(sigs),
-           std::move(in), ru);
+           std::move(in), ru, opts);
 }
 
 } // namespace caf::openssl
@@ -33,10 +33,18 @@ namespace caf::openssl {
 expected<strong_actor_ptr>
 remote_actor(actor_system& sys, const std::set<std::string>& mpi,
              std::string host, uint16_t port) {
-  CAF_LOG_TRACE(CAF_ARG(mpi) << CAF_ARG(host) << CAF_ARG(port));
-  expected<strong_actor_ptr> res{strong_actor_ptr{nullptr}};
+  return remote_actor(sys, mpi, std::move(host), port,
+                      io::network::make_socket_options(sys.config()));
+}
+
+expected<strong_actor_ptr>
+remote_actor(actor_system& sys, const std::set<std::string>& mpi,
+             std::string host, uint16_t port,
+             const io::network::socket_options& opts) {
+  CAF_LOG_TRACE(CAF_ARG(mpi) << CAF_ARG(host) << CAF_ARG(port)
+                             << CAF_ARG(opts));
   auto f = make_function_view(sys.openssl_manager().actor_handle());
-  auto x = f(connect_atom_v, std::move(host), port);
+  auto x = f(connect_atom_v, std::move(host), port, opts);
   if (!x)
     return std::move(x.error());
   auto& tup = *x;
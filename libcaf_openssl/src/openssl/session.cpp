@@ -61,40 +61,41 @@ CAF_POP_WARNINGS
 
 namespace caf::openssl {
 
-namespace {
-
-int pem_passwd_cb(char* buf, int size, int, void* ptr) {
-  auto passphrase = reinterpret_cast<session*>(ptr)->openssl_passphrase();
-  strncpy(buf, passphrase, static_cast<size_t>(size));
-  buf[size - 1] = '\0';
-  return static_cast<int>(strlen(buf));
-}
-
-} // namespace
-
 session::session(actor_system& sys)
   : sys_(sys),
-    ctx_(nullptr),
     ssl_(nullptr),
     connecting_(false),
-    accepting_(false) {
+    accepting_(false),
+    ktls_send_(false),
+    ktls_recv_(false),
+    failed_(false) {
   // nop
 }
 
 bool session::init() {
   CAF_LOG_TRACE("");
-  ctx_ = create_ssl_context();
-  ssl_ = SSL_new(ctx_);
+  auto ctx = parent().ssl_context();
+  if (ctx == nullptr) {
+    CAF_LOG_ERROR("cannot create SSL session without context");
+    return false;
+  }
+  ssl_ = SSL_new(ctx);
   if (ssl_ == nullptr) {
     CAF_LOG_ERROR("cannot create SSL session");
     return false;
   }
+  SSL_set_app_data(ssl_, this);
   return true;
 }
 
 session::~session() {
+  // OpenSSL invalidates sessions of connections that close without a proper
+  // shutdown. CAF closes sockets without sending close_notify, so we mark
+  // established connections as shut down to keep their sessions resumable.
+  // Sessions of failed connections must remain invalidated.
+  if (ssl_ != nullptr && !failed_ && SSL_is_init_finished(ssl_))
+    SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
   SSL_free(ssl_);
-  SSL_CTX_free(ctx_);
 }
 
 rw_state session::do_some(int (*f)(SSL*, void*, int), size_t& result, void* buf,
@@ -105,6 +106,11 @@ rw_state session::do_some(int (*f)(SSL*, void*, int), size_t& result, void* buf,
     switch (SSL_get_error(ssl_, res)) {
       default:
         CAF_LOG_INFO("SSL error:" << get_ssl_error());
+        fail();
+        return rw_state::failure;
+      case SSL_ERROR_ZERO_RETURN:
+        CAF_LOG_DEBUG("SSL_ERROR_ZERO_RETURN reported");
+        // Regular shutdown by the remote side, i.e., no fatal error.
         return rw_state::failure;
       case SSL_ERROR_WANT_READ:
         CAF_LOG_DEBUG("SSL_ERROR_WANT_READ reported");
@@ -126,6 +132,7 @@ rw_state session::do_some(int (*f)(SSL*, void*, int), size_t& result, void* buf,
     if (res == 1) {
       CAF_LOG_DEBUG("SSL connection established");
       connecting_ = false;
+      handshake_completed();
     } else {
       result = 0;
       return check_ssl_res(res);
@@ -137,6 +144,7 @@ rw_state session::do_some(int (*f)(SSL*, void*, int), size_t& result, void* buf,
     if (res == 1) {
       CAF_LOG_DEBUG("SSL connection accepted");
       accepting_ = false;
+      handshake_completed();
     } else {
       result = 0;
       return check_ssl_res(res);
@@ -165,6 +173,8 @@ session::read_some(size_t& result, native_socket, void* buf, size_t len) {
 rw_state session::write_some(size_t& result, native_socket, const void* buf,
                              size_t len) {
   CAF_LOG_TRACE(CAF_ARG(len));
+  // With kTLS, SSL_write still frames the records and handles alerts, but
+  // passes the plaintext to the kernel for encryption.
   auto wr_fun = [](SSL* sptr, void* vptr, int ptr_size) {
     return SSL_write(sptr, vptr, ptr_size);
   };
@@ -176,9 +186,19 @@ bool session::try_connect(native_socket fd) {
   CAF_BLOCK_SIGPIPE();
   SSL_set_fd(ssl_, fd);
   SSL_set_connect_state(ssl_);
+  auto addr = io::network::remote_addr_of_fd(fd);
+  auto port = io::network::remote_port_of_fd(fd);
+  if (addr && port) {
+    peer_ = std::move(*addr);
+    peer_ += ':';
+    peer_ += std::to_string(*port);
+    parent().restore_session(ssl_, peer_);
+  }
   auto ret = SSL_connect(ssl_);
-  if (ret == 1)
+  if (ret == 1) {
+    handshake_completed();
     return true;
+  }
   connecting_ = true;
   return handle_ssl_result(ret);
 }
@@ -189,8 +209,10 @@ bool session::try_accept(native_socket fd) {
   SSL_set_fd(ssl_, fd);
   SSL_set_accept_state(ssl_);
   auto ret = SSL_accept(ssl_);
-  if (ret == 1)
+  if (ret == 1) {
+    handshake_completed();
     return true;
+  }
   accepting_ = true;
   return handle_ssl_result(ret);
 }
@@ -199,74 +221,6 @@ bool session::must_read_more(native_socket, size_t threshold) {
   return static_cast<size_t>(SSL_pending(ssl_)) >= threshold;
 }
 
-const char* session::openssl_passphrase() {
-  return openssl_passphrase_.c_str();
-}
-
-SSL_CTX* session::create_ssl_context() {
-  CAF_BLOCK_SIGPIPE();
-#ifdef CAF_SSL_HAS_NON_VERSIONED_TLS_FUN
-  auto ctx = SSL_CTX_new(TLS_method());
-#else
-  auto ctx = SSL_CTX_new(TLSv1_2_method());
-#endif
-  if (!ctx)
-    CAF_RAISE_ERROR("cannot create OpenSSL context");
-  if (sys_.openssl_manager().authentication_enabled()) {
-    // Require valid certificates on both sides.
-    auto& cfg = sys_.config();
-    if (!cfg.openssl_certificate.empty()
-        && SSL_CTX_use_certificate_chain_file(ctx,
-                                              cfg.openssl_certificate.c_str())
-             != 1)
-      CAF_RAISE_ERROR("cannot load certificate");
-    if (!cfg.openssl_passphrase.empty()) {
-      openssl_passphrase_ = cfg.openssl_passphrase;
-      SSL_CTX_set_default_passwd_cb(ctx, pem_passwd_cb);
-      SSL_CTX_set_default_passwd_cb_userdata(ctx, this);
-    }
-    if (!cfg.openssl_key.empty()
-        && SSL_CTX_use_PrivateKey_file(ctx, cfg.openssl_key.c_str(),
-                                       SSL_FILETYPE_PEM)
-             != 1)
-      CAF_RAISE_ERROR("cannot load private key");
-    auto cafile = (!cfg.openssl_cafile.empty() ? cfg.openssl_cafile.c_str()
-                                               : nullptr);
-    auto capath = (!cfg.openssl_capath.empty() ? cfg.openssl_capath.c_str()
-                                               : nullptr);
-    if (cafile || capath) {
-      if (SSL_CTX_load_verify_locations(ctx, cafile, capath) != 1)
-        CAF_RAISE_ERROR("cannot load trusted CA certificates");
-    }
-    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-                       nullptr);
-    if (SSL_CTX_set_cipher_list(ctx, "HIGH:!aNULL:!MD5") != 1)
-      CAF_RAISE_ERROR("cannot set cipher list");
-  } else {
-    // No authentication.
-    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
-#if defined(CAF_SSL_HAS_ECDH_AUTO) && (OPENSSL_VERSION_NUMBER < 0x10100000L)
-    SSL_CTX_set_ecdh_auto(ctx, 1);
-#else
-    auto ecdh = EC_KEY_new_by_curve_name(NID_secp384r1);
-    if (!ecdh)
-      CAF_RAISE_ERROR("cannot get ECDH curve");
-    CAF_PUSH_WARNINGS
-    SSL_CTX_set_tmp_ecdh(ctx, ecdh);
-    EC_KEY_free(ecdh);
-    CAF_POP_WARNINGS
-#endif
-#ifdef CAF_SSL_HAS_SECURITY_LEVEL
-    const char* cipher = "AECDH-AES256-SHA@SECLEVEL=0";
-#else
-    const char* cipher = "AECDH-AES256-SHA";
-#endif
-    if (SSL_CTX_set_cipher_list(ctx, cipher) != 1)
-      CAF_RAISE_ERROR("cannot set anonymous cipher");
-  }
-  return ctx;
-}
-
 std::string session::get_ssl_error() {
   std::string msg = "";
   while (auto err = ERR_get_error()) {
@@ -289,14 +243,37 @@ bool session::handle_ssl_result(int ret) {
       CAF_LOG_DEBUG("Nonblocking call to SSL returned want_write");
       return true;
     case SSL_ERROR_ZERO_RETURN: // Regular remote connection shutdown.
-    case SSL_ERROR_SYSCALL:     // Socket connection closed.
+      return false;
+    case SSL_ERROR_SYSCALL: // Socket connection closed.
+      fail();
       return false;
     default: // Other error
       CAF_LOG_INFO("SSL call failed:" << get_ssl_error());
+      fail();
       return false;
   }
 }
 
+void session::fail() {
+  if (failed_)
+    return;
+  failed_ = true;
+  // Make sure the next connection to this peer performs a full handshake.
+  if (!peer_.empty())
+    parent().forget_session(peer_);
+}
+
+void session::handshake_completed() {
+#ifdef CAF_SSL_HAS_KTLS
+  // OpenSSL falls back to user-space crypto silently if the kernel rejects
+  // the negotiated cipher, e.g., because it only offloads AES-GCM ciphers.
+  ktls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl_)) == 1;
+  ktls_recv_ = BIO_get_ktls_recv(SSL_get_rbio(ssl_)) == 1;
+  CAF_LOG_DEBUG(CAF_ARG(ktls_send_) << CAF_ARG(ktls_recv_));
+#endif
+  CAF_LOG_DEBUG_IF(session_reused(), "resumed previous session");
+}
+
 session_ptr
 make_session(actor_system& sys, native_socket fd, bool from_accepted_socket) {
   session_ptr ptr{new session(sys)};
@@ -124,10 +124,12 @@ struct fixture {
     }
   }
 
-  bool init(bool skip_client_side_ca) {
+  bool init(bool skip_client_side_ca, bool enable_ktls = false) {
     auto cd = config::data_dir();
     cd += '/';
     server_side_config.openssl_passphrase = "12345";
+    server_side_config.set("caf.openssl.ktls", enable_ktls);
+    client_side_config.set("caf.openssl.ktls", enable_ktls);
     // check whether all files exist before setting config parameters
     std::string dummy;
     std::pair<const char*, std::string*>
@@ -219,6 +221,25 @@ CAF_TEST(authentication_success) {
   exec_loop();
 }
 
+CAF_TEST(authentication_success_with_ktls) {
+  // Whether the kernel actually takes over depends on the platform. Either
+  // way, enabling kTLS must not break communication.
+  if (!init(false, true))
+    return;
+  auto spong = server_side.spawn(make_pong_behavior);
+  exec_loop();
+  loop_after_next_enqueue(server_side);
+  auto port = unbox(publish(spong, 0, local_host));
+  exec_loop();
+  loop_after_next_enqueue(client_side);
+  auto pong = unbox(remote_actor(client_side, local_host, port));
+  auto sping = client_side.spawn(make_ping_behavior, pong);
+  while (!terminated(sping))
+    exec_loop();
+  anon_send_exit(spong, exit_reason::user_shutdown);
+  exec_loop();
+}
+
 CAF_TEST(authentication_failure) {
   if (!init(true))
     return;
@@ -0,0 +1,183 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE openssl.session
+
+#include "caf/openssl/session.hpp"
+
+#include "openssl-test.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+#include "caf/openssl/all.hpp"
+
+#ifdef CAF_WINDOWS
+#  include <winsock2.h>
+#else
+#  include <sys/socket.h>
+#endif
+
+using namespace caf;
+
+using io::network::close_socket;
+using io::network::invalid_native_socket;
+using io::network::native_socket;
+
+namespace {
+
+constexpr char local_host[] = "127.0.0.1";
+
+class config : public actor_system_config {
+public:
+  config() {
+    load<io::middleman>();
+    load<openssl::manager>();
+    set("caf.middleman.manual-multiplexing", true);
+    set("caf.middleman.attach-utility-actors", true);
+    set("caf.scheduler.policy", "testing");
+  }
+};
+
+struct connection {
+  native_socket client_fd = invalid_native_socket;
+  native_socket server_fd = invalid_native_socket;
+  openssl::session_ptr client;
+  openssl::session_ptr server;
+
+  ~connection() {
+    client = nullptr;
+    server = nullptr;
+    if (client_fd != invalid_native_socket)
+      close_socket(client_fd);
+    if (server_fd != invalid_native_socket)
+      close_socket(server_fd);
+  }
+};
+
+struct fixture {
+  config cfg;
+  std::unique_ptr<actor_system> sys;
+  native_socket acceptor = invalid_native_socket;
+  uint16_t port = 0;
+
+  ~fixture() {
+    if (acceptor != invalid_native_socket)
+      close_socket(acceptor);
+  }
+
+  void init(bool session_resumption) {
+    cfg.set("caf.openssl.session-resumption", session_resumption);
+    sys = std::make_unique<actor_system>(cfg);
+    acceptor = unbox(io::network::new_tcp_acceptor_impl(0, local_host, true));
+    port = unbox(io::network::local_port_of_fd(acceptor));
+  }
+
+  // Sends `msg` from `src` to `dst`, implicitly driving the handshake. Sleeps
+  // briefly whenever `dst` has nothing to read to give the kernel time for
+  // delivering data on the loopback device.
+  bool transfer(openssl::session& src, native_socket src_fd,
+                openssl::session& dst, native_socket dst_fd,
+                const std::string& msg) {
+    size_t written = 0;
+    std::string received;
+    char buf[64];
+    for (int round = 0; round < 1000 && received.size() < msg.size();
+         ++round) {
+      size_t n = 0;
+      if (written < msg.size()) {
+        if (src.write_some(n, src_fd, msg.data() + written,
+                           msg.size() - written)
+            == io::network::rw_state::failure)
+          return false;
+        written += n;
+      } else if (src.write_some(n, src_fd, nullptr, 0)
+                 == io::network::rw_state::failure) {
+        return false;
+      }
+      if (dst.read_some(n, dst_fd, buf, sizeof(buf))
+          == io::network::rw_state::failure)
+        return false;
+      if (n == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      received.append(buf, n);
+    }
+    return received == msg;
+  }
+
+  std::unique_ptr<connection> connect() {
+    auto result = std::make_unique<connection>();
+    result->client_fd = unbox(io::network::new_tcp_connection(local_host,
+                                                              port));
+    result->server_fd = ::accept(acceptor, nullptr, nullptr);
+    CAF_REQUIRE_NOT_EQUAL(result->server_fd, invalid_native_socket);
+    for (auto fd : {result->client_fd, result->server_fd})
+      if (!io::network::nonblocking(fd, true))
+        CAF_FAIL("cannot set socket to nonblocking mode");
+    result->client = openssl::make_session(*sys, result->client_fd, false);
+    result->server = openssl::make_session(*sys, result->server_fd, true);
+    CAF_REQUIRE(result->client != nullptr);
+    CAF_REQUIRE(result->server != nullptr);
+    // Exchange messages in both directions, because clients receive session
+    // tickets after the handshake in TLS 1.3.
+    CAF_REQUIRE(transfer(*result->client, result->client_fd, *result->server,
+                         result->server_fd, "ping"));
+    CAF_REQUIRE(transfer(*result->server, result->server_fd, *result->client,
+                         result->client_fd, "pong"));
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(session_tests, fixture)
+
+CAF_TEST(sessions share the SSL context of their manager) {
+  init(true);
+  auto ctx = sys->openssl_manager().ssl_context();
+  CAF_REQUIRE(ctx != nullptr);
+  auto conn = connect();
+  CAF_CHECK(SSL_get_SSL_CTX(conn->client->native_handle()) == ctx);
+  CAF_CHECK(SSL_get_SSL_CTX(conn->server->native_handle()) == ctx);
+}
+
+CAF_TEST(clients resume sessions when reconnecting) {
+  init(true);
+  auto first = connect();
+  CAF_CHECK_EQUAL(first->client->peer(),
+                  std::string{local_host} + ':' + std::to_string(port));
+  CAF_CHECK(!first->client->session_reused());
+  first.reset();
+  auto second = connect();
+  CAF_CHECK(second->client->session_reused());
+  CAF_CHECK(second->server->session_reused());
+}
+
+CAF_TEST(session resumption is optional) {
+  init(false);
+  auto first = connect();
+  first.reset();
+  auto second = connect();
+  CAF_CHECK(!second->client->session_reused());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
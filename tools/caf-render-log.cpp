@@ -0,0 +1,37 @@
+// Renders log files with interned call sites (see
+// caf.logger.file.intern-sites) to text.
+//
+// Usage: caf-render-log <input-file> [<line-format>]
+//
+// The line format uses the same placeholders as caf.logger.file.format and
+// defaults to the default file format. Writes the result to standard output.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "caf/defaults.hpp"
+#include "caf/logger.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "usage: " << argv[0] << " <input-file> [<line-format>]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ifstream in{argv[1], std::ios::binary};
+  if (!in) {
+    std::cerr << "*** unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  auto format = argc == 3
+                  ? std::string{argv[2]}
+                  : to_string(caf::defaults::logger::file::format);
+  auto lf = caf::logger::parse_format(format);
+  if (!caf::logger::render_interned_log(in, std::cout, lf)) {
+    std::cerr << "*** " << argv[1] << " has no interned call sites"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}